@@ -87,6 +87,12 @@ void MCAPP_AM4096magInit(MCAPP_AM4096_T *magSensor)
    magSensor->cos_prev = 0;
    magSensor->theta = 0;
    magSensor->speed = 0;
+   magSensor->positionPrev = 0;
+   magSensor->positionValid = 0;
+   magSensor->readErrors = 0;
+   magSensor->turns = 0;
+   magSensor->velocity = 0;
+   magSensor->position = 0;
 }
 
  /**
@@ -104,7 +110,18 @@ void MCAPP_AM4096magInit(MCAPP_AM4096_T *magSensor)
 void MCAPP_AM4096magRead(MCAPP_AM4096_T *magSensor)
 {
     uint32_t        recieve_data = 0; 
-    recieve_data = SPI1_WordExchange(SPI_DUMMY_DATA);
+    int32_t         positionDelta;
+    /* Previous position is kept when the sensor does not respond */
+    if(SPI1_WordExchange(SPI_DUMMY_DATA, &recieve_data) == false)
+    {
+        magSensor->readErrors++;
+        recieve_data = magSensor->lowerword_data | 
+                                        (magSensor->higherword_data << 13);
+    }
+    else
+    {
+        magSensor->readErrors = 0;
+    }
     magSensor->lowerword_data   = (uint32_t)(recieve_data&0x0FFF);
     magSensor->higherword_data  = (uint32_t)((recieve_data>>13)&0x0FFF);
     /* Check if the data received is correct */
@@ -117,12 +134,31 @@ void MCAPP_AM4096magRead(MCAPP_AM4096_T *magSensor)
     {
         magSensor->raw_position_comp = magSensor->raw_position_comp;
     }
+    /* Count revolutions from wrap of compensated position, a change larger 
+       than half a revolution between reads is a wrap */
+    if(magSensor->positionValid == 1)
+    {
+        positionDelta = (int32_t)magSensor->raw_position_comp - 
+                                            (int32_t)magSensor->positionPrev;
+        if(positionDelta < -(int32_t)((magSensor->resolution + 1) >> 1))
+        {
+            magSensor->turns++;
+        }
+        else if(positionDelta > (int32_t)((magSensor->resolution + 1) >> 1))
+        {
+            magSensor->turns--;
+        }
+    }
+    magSensor->positionPrev = magSensor->raw_position_comp;
+    magSensor->positionValid = 1;
     /* Convert sensor output to theta in radians */
     magSensor->theta = (float) ((float) (magSensor->raw_position_comp * ((float) 2 * M_PI)) / am4096_resolution);
     /* Speed measurement*/
     magSensor->speedBuffer = (cos (magSensor->theta)*(sin(magSensor->theta) - magSensor->sin_prev))/LOOPTIME_SEC - (sin(magSensor->theta)*(cos(magSensor->theta) - magSensor->cos_prev))/LOOPTIME_SEC;
     LowPassFilter(magSensor->speedBuffer,filterCoeff,&magSensor->speedFilter);
-    magSensor->speed = fabsf((float) (magSensor->speedFilter * ((float) ( (float) 60 / (2 * M_PI)))));
+    magSensor->velocity = (float) (magSensor->speedFilter * ((float) ( (float) 60 / (2 * M_PI))));
+    magSensor->speed = fabsf(magSensor->velocity);
+    magSensor->position = (float) (magSensor->turns * ((float) 2 * M_PI)) + magSensor->theta;
     magSensor->sin_prev = sin(magSensor->theta);
     magSensor->cos_prev = cos(magSensor->theta);   
 }
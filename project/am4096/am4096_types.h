@@ -68,7 +68,12 @@ typedef struct
         higherword_data,/* Position from SPI High Buffer */
         raw_position,   /* Raw position data from magnetic sensor */
         raw_position_comp,/* Estimated rotor angle after offset compensation */
+        positionPrev,   /* raw_position_comp of previous read for wrap detection */
+        positionValid,  /* 1 = positionPrev is valid for wrap detection */
+        readErrors,     /* Consecutive reads without response from sensor */
         timerValue;     /* Variable to read timer value */
+    int32_t
+        turns;          /* Number of revolutions since initialization */
     float
         sin,            /* Sine component of calculated rotor angle */
         sin_prev,       /* Previous Values of Sine component of calculated rotor angle */
@@ -78,6 +83,9 @@ typedef struct
         speedBuffer,    /* Buffer for estimated Velocity */
         speedFilter,    /* Filter speed ouput */
         speed;          /* Estimated Velocity in rpm */
+    float
+        velocity,       /* Estimated Velocity in rpm, positive for increasing theta */
+        position;       /* Multi-turn rotor angle in radians */
            
 }MCAPP_AM4096_T;    
 // </editor-fold>    
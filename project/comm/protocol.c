@@ -0,0 +1,935 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file protocol.c
+ *
+ * @brief This module implements the binary command/response protocol on UART1
+ * for controlling the drive from a host (e.g. PLC).
+ *
+ * Received bytes are parsed in UART1 receive interrupt. A frame with valid
+ * CRC is handed to the main loop through a single frame buffer, where the
+ * command is executed and the response is queued to a transmit ring buffer
+ * emptied by UART1 transmit interrupt. Neither path waits on the UART.
+ *
+ * Component: PROTOCOL
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <xc.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "protocol.h"
+#include "uart1.h"
+#include "mc1_service.h"
+#include "fault_detect_types.h"
+
+// </editor-fold>
+
+#ifdef ENABLE_PROTOCOL
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/CONSTANTS ">
+
+#define PROTOCOL_VERSION    2
+
+/* Responses are built in a buffer of PROTOCOL_MAX_PAYLOAD bytes */
+#if (2 + 2 * PROTOCOL_FAULT_COUNTS_PER_FRAME) > PROTOCOL_MAX_PAYLOAD
+#error "PROTOCOL_CMD_GET_FAULT_COUNTS response exceeds PROTOCOL_MAX_PAYLOAD"
+#endif
+/* Fault status and first fault are sent as 32 bits */
+#if MC1_FAULT_COUNT > 32
+#error "MC1_FAULT_COUNT exceeds the fault status of PROTOCOL_CMD_GET_FAULTS"
+#endif
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="TYPE DEFINITIONS ">
+
+typedef enum
+{
+    PARSER_SOF = 0,
+    PARSER_CMD = 1,
+    PARSER_LEN = 2,
+    PARSER_PAYLOAD = 3,
+    PARSER_CRC_LOW = 4,
+    PARSER_CRC_HIGH = 5,
+}PROTOCOL_PARSER_STATE_T;
+
+typedef struct
+{
+    uint8_t
+        cmd,                /* Command code */
+        len,                /* Payload length */
+        crcValid,           /* 1 = CRC matched */
+        payload[PROTOCOL_MAX_PAYLOAD];
+} PROTOCOL_FRAME_T;
+
+typedef struct
+{
+    /* Receive parser, updated in UART1 receive interrupt */
+    PROTOCOL_FRAME_T
+        rxParse;            /* Frame being received */
+    uint16_t
+        rxCrc,              /* CRC computed over received bytes */
+        rxCrcFrame;         /* CRC received in frame */
+    uint32_t
+        rxState,            /* Parser state PROTOCOL_PARSER_STATE_T */
+        rxIndex;            /* Index of next payload byte */
+
+    /* Frame handed over to main loop */
+    PROTOCOL_FRAME_T
+        rxFrame;
+    volatile uint32_t
+        rxFrameReady,       /* 1 = rxFrame is waiting to be executed */
+        rxOverrun;          /* Frames dropped as main loop was busy */
+
+    /* Transmit ring buffer, written by main loop, read in interrupt */
+    uint8_t
+        txBuffer[PROTOCOL_TX_BUFFER_SIZE];
+    volatile uint32_t
+        txHead,
+        txTail;
+
+    /* Commands from host */
+    volatile uint32_t
+        remote,             /* 1 = commands from host, 0 = board controls */
+        runCmd,             /* Run command from host */
+        dirCmd,             /* Direction command from host */
+        linkCounter,        /* Timer1 periods since last valid frame */
+        linkTimeout;        /* 1 = remote run stopped due to link loss */
+    volatile float
+        controlInput;       /* Control input (0 - 4095) from host */
+} PROTOCOL_T;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLES ">
+
+static PROTOCOL_T protocol;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
+
+static uint16_t ProtocolCRC16Update(uint16_t, uint8_t);
+static void ProtocolByteParse(uint8_t);
+static void ProtocolFrameExecute(const PROTOCOL_FRAME_T *);
+static void ProtocolResponseSend(uint8_t, const uint8_t *, uint8_t);
+static void ProtocolNakSend(uint8_t, uint8_t);
+static uint16_t ProtocolU16Get(const uint8_t *);
+static uint32_t ProtocolU32Get(const uint8_t *);
+static void ProtocolU16Put(uint8_t *, uint16_t);
+static void ProtocolU32Put(uint8_t *, uint32_t);
+static uint16_t ProtocolSaturateU16(float);
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+
+/**
+* <B> Function: ProtocolInit() </B>
+*
+* @brief Function to initialize UART1 and enable receive and transmit
+*        interrupts for the protocol.
+*
+* @param none.
+* @return none.
+*
+* @example
+* <CODE> ProtocolInit(); </CODE>
+*
+*/
+void ProtocolInit(void)
+{
+    protocol.rxState = PARSER_SOF;
+    protocol.rxFrameReady = 0;
+    protocol.rxOverrun = 0;
+    protocol.txHead = 0;
+    protocol.txTail = 0;
+    protocol.remote = 0;
+    protocol.runCmd = 0;
+    protocol.dirCmd = 0;
+    protocol.controlInput = 0;
+    protocol.linkCounter = 0;
+    protocol.linkTimeout = 0;
+
+    UART1_InterruptReceiveDisable();
+    UART1_InterruptReceiveFlagClear();
+    UART1_InterruptTransmitDisable();
+    UART1_InterruptTransmitFlagClear();
+    UART1_Initialize();
+    UART1_BaudRateDividerSet(PROTOCOL_BAUDRATE_DIVIDER);
+    UART1_SpeedModeStandard();
+    UART1_RxInterruptPrioritySet(PROTOCOL_RX_INTERRUPT_PRIORITY);
+    UART1_TxInterruptPrioritySet(PROTOCOL_TX_INTERRUPT_PRIORITY);
+    UART1_ModuleEnable();
+    UART1_InterruptReceiveEnable();
+}
+
+/**
+* <B> Function: ProtocolStepMain() </B>
+*
+* @brief Function to execute the received command and queue the response,
+*        to be called from the main loop.
+*
+* @param none.
+* @return none.
+*
+* @example
+* <CODE> ProtocolStepMain(); </CODE>
+*
+*/
+void ProtocolStepMain(void)
+{
+    if(protocol.rxFrameReady == 1)
+    {
+        ProtocolFrameExecute(&protocol.rxFrame);
+        protocol.rxFrameReady = 0;
+    }
+}
+
+/**
+* <B> Function: ProtocolStepIsr() </B>
+*
+* @brief Function to supervise the link to host, to be called from Timer1
+*        interrupt. Remote run command is cleared if no valid frame is
+*        received within PROTOCOL_LINK_TIMEOUT_MS.
+*
+* @param none.
+* @return none.
+*
+* @example
+* <CODE> ProtocolStepIsr(); </CODE>
+*
+*/
+void ProtocolStepIsr(void)
+{
+    if(protocol.linkCounter < PROTOCOL_LINK_TIMEOUT_COUNT)
+    {
+        protocol.linkCounter++;
+    }
+    else if((protocol.remote == 1) && (protocol.runCmd == 1))
+    {
+        protocol.runCmd = 0;
+        protocol.linkTimeout = 1;
+    }
+}
+
+/**
+* <B> Function: ProtocolRemoteCommandGet(uint32_t *, uint32_t *, float *) </B>
+*
+* @brief Function to read the commands received from host.
+*
+* @param Pointer to run command.
+* @param Pointer to direction command.
+* @param Pointer to control input (0 - 4095).
+* @return true if the drive is controlled by host.
+*
+* @example
+* <CODE> remote = ProtocolRemoteCommandGet(&run, &dir, &input); </CODE>
+*
+*/
+bool ProtocolRemoteCommandGet(uint32_t *pRunCmd, uint32_t *pDirCmd,
+                                                        float *pControlInput)
+{
+    *pRunCmd = protocol.runCmd;
+    *pDirCmd = protocol.dirCmd;
+    *pControlInput = protocol.controlInput;
+
+    return (protocol.remote == 1);
+}
+
+/**
+* <B> Function: _U1RXInterrupt() </B>
+*
+* @brief Function to handle UART1 receive interrupt. All bytes in the
+*        receive buffer are passed to the frame parser.
+*
+* @param none.
+* @return none.
+*
+* @example
+* <CODE> _U1RXInterrupt(); </CODE>
+*
+*/
+void __attribute__((__interrupt__, no_auto_psv)) _U1RXInterrupt(void)
+{
+    while(UART1_IsReceiveBufferDataReady())
+    {
+        ProtocolByteParse((uint8_t)UART1_DataRead());
+    }
+    if(UART1_IsReceiveBufferOverFlowDetected())
+    {
+        UART1_ReceiveBufferOverrunErrorFlagClear();
+        protocol.rxState = PARSER_SOF;
+    }
+    UART1_InterruptReceiveFlagClear();
+}
+
+/**
+* <B> Function: _U1TXInterrupt() </B>
+*
+* @brief Function to handle UART1 transmit interrupt. Transmit buffer of
+*        UART1 is filled from the ring buffer, interrupt is disabled once the
+*        ring buffer is empty.
+*
+* @param none.
+* @return none.
+*
+* @example
+* <CODE> _U1TXInterrupt(); </CODE>
+*
+*/
+void __attribute__((__interrupt__, no_auto_psv)) _U1TXInterrupt(void)
+{
+    uint32_t tail = protocol.txTail;
+
+    while((tail != protocol.txHead) && !UART1_StatusBufferFullTransmitGet())
+    {
+        UART1_DataWrite(protocol.txBuffer[tail]);
+        tail = (tail + 1) % PROTOCOL_TX_BUFFER_SIZE;
+    }
+    protocol.txTail = tail;
+
+    if(tail == protocol.txHead)
+    {
+        UART1_InterruptTransmitDisable();
+    }
+    UART1_InterruptTransmitFlagClear();
+}
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
+
+/**
+* <B> Function: ProtocolCRC16Update(uint16_t, uint8_t) </B>
+*
+* @brief Function to update CRC16-CCITT (polynomial 0x1021) with one byte.
+*
+* @param Present CRC value.
+* @param Data byte.
+* @return Updated CRC value.
+*
+* @example
+* <CODE> crc = ProtocolCRC16Update(crc, data); </CODE>
+*
+*/
+static uint16_t ProtocolCRC16Update(uint16_t crc, uint8_t data)
+{
+    uint16_t bit;
+
+    crc ^= (uint16_t)data << 8;
+    for(bit = 0; bit < 8; bit++)
+    {
+        if(crc & 0x8000)
+        {
+            crc = (crc << 1) ^ 0x1021;
+        }
+        else
+        {
+            crc = crc << 1;
+        }
+    }
+    return crc;
+}
+
+/**
+* <B> Function: ProtocolByteParse(uint8_t) </B>
+*
+* @brief Frame parser, executed for every received byte. A complete frame is
+*        copied for the main loop if the previous frame has been executed,
+*        otherwise it is dropped.
+*
+* @param Received byte.
+* @return none.
+*
+* @example
+* <CODE> ProtocolByteParse(data); </CODE>
+*
+*/
+static void ProtocolByteParse(uint8_t data)
+{
+    PROTOCOL_FRAME_T *pFrame = &protocol.rxParse;
+
+    switch(protocol.rxState)
+    {
+    case PARSER_SOF:
+        if(data == PROTOCOL_SOF)
+        {
+            protocol.rxCrc = 0xFFFF;
+            protocol.rxState = PARSER_CMD;
+        }
+        break;
+
+    case PARSER_CMD:
+        pFrame->cmd = data;
+        protocol.rxCrc = ProtocolCRC16Update(protocol.rxCrc, data);
+        protocol.rxState = PARSER_LEN;
+        break;
+
+    case PARSER_LEN:
+        if(data > PROTOCOL_MAX_PAYLOAD)
+        {
+            /* Not a valid frame, resynchronize on next SOF */
+            protocol.rxState = PARSER_SOF;
+            break;
+        }
+        pFrame->len = data;
+        protocol.rxIndex = 0;
+        protocol.rxCrc = ProtocolCRC16Update(protocol.rxCrc, data);
+        if(data == 0)
+        {
+            protocol.rxState = PARSER_CRC_LOW;
+        }
+        else
+        {
+            protocol.rxState = PARSER_PAYLOAD;
+        }
+        break;
+
+    case PARSER_PAYLOAD:
+        pFrame->payload[protocol.rxIndex++] = data;
+        protocol.rxCrc = ProtocolCRC16Update(protocol.rxCrc, data);
+        if(protocol.rxIndex >= pFrame->len)
+        {
+            protocol.rxState = PARSER_CRC_LOW;
+        }
+        break;
+
+    case PARSER_CRC_LOW:
+        protocol.rxCrcFrame = data;
+        protocol.rxState = PARSER_CRC_HIGH;
+        break;
+
+    case PARSER_CRC_HIGH:
+        protocol.rxCrcFrame |= (uint16_t)data << 8;
+        pFrame->crcValid = (protocol.rxCrcFrame == protocol.rxCrc);
+        if(protocol.rxFrameReady == 0)
+        {
+            protocol.rxFrame = *pFrame;
+            protocol.rxFrameReady = 1;
+        }
+        else
+        {
+            protocol.rxOverrun++;
+        }
+        protocol.rxState = PARSER_SOF;
+        break;
+
+    default:
+        protocol.rxState = PARSER_SOF;
+        break;
+    }
+}
+
+/**
+* <B> Function: ProtocolFrameExecute(const PROTOCOL_FRAME_T *) </B>
+*
+* @brief Function to execute a received command and send the response.
+*
+* @param Pointer to received frame.
+* @return none.
+*
+* @example
+* <CODE> ProtocolFrameExecute(&frame); </CODE>
+*
+*/
+static void ProtocolFrameExecute(const PROTOCOL_FRAME_T *pFrame)
+{
+    uint8_t response[PROTOCOL_MAX_PAYLOAD];
+    uint8_t responseLen = 0;
+    MC1APP_STATUS_T status;
+    MCAPP_FAULT_LOG_ENTRY_T logEntry;
+    MCAPP_FAULT_SAMPLE_T sample;
+    MCAPP_EFFICIENCY_POINT_T sweepPoint;
+    float controlInput;
+    uint32_t index;
+    uint32_t first;
+
+    if(pFrame->crcValid == 0)
+    {
+        ProtocolNakSend(pFrame->cmd, PROTOCOL_ERROR_CRC);
+        return;
+    }
+
+    /* Any valid frame keeps the link alive */
+    protocol.linkCounter = 0;
+
+    switch(pFrame->cmd)
+    {
+    case PROTOCOL_CMD_PING:
+        response[0] = PROTOCOL_VERSION;
+        responseLen = 1;
+        break;
+
+    case PROTOCOL_CMD_SET_REMOTE:
+        if(pFrame->len != 1)
+        {
+            ProtocolNakSend(pFrame->cmd, PROTOCOL_ERROR_LENGTH);
+            return;
+        }
+        /* Motor is stopped whenever control source is changed */
+        protocol.runCmd = 0;
+        protocol.linkTimeout = 0;
+        protocol.remote = (pFrame->payload[0] != 0);
+        break;
+
+    case PROTOCOL_CMD_SET_RUN:
+        if(pFrame->len != 1)
+        {
+            ProtocolNakSend(pFrame->cmd, PROTOCOL_ERROR_LENGTH);
+            return;
+        }
+        if(protocol.remote == 0)
+        {
+            ProtocolNakSend(pFrame->cmd, PROTOCOL_ERROR_STATE);
+            return;
+        }
+        protocol.linkTimeout = 0;
+        protocol.runCmd = (pFrame->payload[0] != 0);
+        break;
+
+    case PROTOCOL_CMD_SET_DIRECTION:
+        if(pFrame->len != 1)
+        {
+            ProtocolNakSend(pFrame->cmd, PROTOCOL_ERROR_LENGTH);
+            return;
+        }
+        if(protocol.remote == 0)
+        {
+            ProtocolNakSend(pFrame->cmd, PROTOCOL_ERROR_STATE);
+            return;
+        }
+        protocol.dirCmd = (pFrame->payload[0] != 0);
+        break;
+
+    case PROTOCOL_CMD_SET_SPEED:
+    case PROTOCOL_CMD_SET_CURRENT:
+        if(pFrame->len != 2)
+        {
+            ProtocolNakSend(pFrame->cmd, PROTOCOL_ERROR_LENGTH);
+            return;
+        }
+        MCAPP_MC1StatusGet(&status);
+        if((protocol.remote == 0) || (status.positionLoop == 1) ||
+                                    ((pFrame->cmd == PROTOCOL_CMD_SET_SPEED)
+                                                    != (status.speedLoop == 1)))
+        {
+            ProtocolNakSend(pFrame->cmd, PROTOCOL_ERROR_STATE);
+            return;
+        }
+        if(pFrame->cmd == PROTOCOL_CMD_SET_SPEED)
+        {
+            controlInput = MCAPP_MC1SpeedToControlInput(
+                                    (float)ProtocolU16Get(pFrame->payload));
+        }
+        else
+        {
+            controlInput = MCAPP_MC1CurrentToControlInput(
+                            (float)ProtocolU16Get(pFrame->payload) * 0.001f);
+        }
+        if((controlInput < 0) || (controlInput > 4095.0f))
+        {
+            ProtocolNakSend(pFrame->cmd, PROTOCOL_ERROR_VALUE);
+            return;
+        }
+        protocol.controlInput = controlInput;
+        break;
+
+    case PROTOCOL_CMD_SET_POSITION:
+        if(pFrame->len != 4)
+        {
+            ProtocolNakSend(pFrame->cmd, PROTOCOL_ERROR_LENGTH);
+            return;
+        }
+        MCAPP_MC1StatusGet(&status);
+        if((protocol.remote == 0) || (status.positionLoop == 0))
+        {
+            ProtocolNakSend(pFrame->cmd, PROTOCOL_ERROR_STATE);
+            return;
+        }
+        controlInput = MCAPP_MC1PositionToControlInput(
+                            (float)ProtocolU32Get(pFrame->payload) * 0.1f);
+        if((controlInput < 0) || (controlInput > 4095.0f))
+        {
+            ProtocolNakSend(pFrame->cmd, PROTOCOL_ERROR_VALUE);
+            return;
+        }
+        protocol.controlInput = controlInput;
+        break;
+
+    case PROTOCOL_CMD_AUTOTUNE:
+        if(!MCAPP_MC1AutotuneRequest())
+        {
+            ProtocolNakSend(pFrame->cmd, PROTOCOL_ERROR_STATE);
+            return;
+        }
+        break;
+
+    case PROTOCOL_CMD_SWEEP:
+        if(pFrame->len != 1)
+        {
+            ProtocolNakSend(pFrame->cmd, PROTOCOL_ERROR_LENGTH);
+            return;
+        }
+        if(pFrame->payload[0] == 0)
+        {
+            MCAPP_MC1EfficiencySweepAbort();
+        }
+        else if(!MCAPP_MC1EfficiencySweepRequest())
+        {
+            ProtocolNakSend(pFrame->cmd, PROTOCOL_ERROR_STATE);
+            return;
+        }
+        break;
+
+    case PROTOCOL_CMD_GET_SWEEP:
+        MCAPP_MC1StatusGet(&status);
+        /* Load setpoint (0.1 unit of load table) is applied by the host */
+        response[0] = (uint8_t)status.sweepState;
+        response[1] = (uint8_t)status.sweepPoint;
+        response[2] = (uint8_t)status.sweepPointCount;
+        ProtocolU16Put(&response[3], ProtocolSaturateU16(status.sweepSpeedTarget));
+        ProtocolU16Put(&response[5], 
+                    ProtocolSaturateU16(status.sweepLoadSetpoint * 10.0f));
+        responseLen = 7;
+        break;
+
+    case PROTOCOL_CMD_GET_SWEEP_POINT:
+        if(pFrame->len != 1)
+        {
+            ProtocolNakSend(pFrame->cmd, PROTOCOL_ERROR_LENGTH);
+            return;
+        }
+        if(!MCAPP_MC1EfficiencySweepPointGet(pFrame->payload[0], &sweepPoint))
+        {
+            ProtocolNakSend(pFrame->cmd, PROTOCOL_ERROR_VALUE);
+            return;
+        }
+        /* Speed (RPM), currents (mA) and DC bus voltage (0.1V) */
+        response[0] = pFrame->payload[0];
+        response[1] = sweepPoint.speedIndex;
+        response[2] = sweepPoint.loadIndex;
+        response[3] = sweepPoint.settled;
+        ProtocolU16Put(&response[4], (uint16_t)sweepPoint.speed);
+        ProtocolU16Put(&response[6], sweepPoint.dcBusVoltage);
+        ProtocolU16Put(&response[8], (uint16_t)sweepPoint.motorCurrent);
+        ProtocolU16Put(&response[10], (uint16_t)sweepPoint.referenceCurrent);
+        for(index = 0; index < EFFICIENCY_SWEEP_PHASES; index++)
+        {
+            ProtocolU16Put(&response[12 + 2 * index], 
+                                            sweepPoint.currentRms[index]);
+        }
+        responseLen = 20;
+        break;
+
+    case PROTOCOL_CMD_GET_STATUS:
+        MCAPP_MC1StatusGet(&status);
+        response[0] = (uint8_t)status.appState;
+        response[1] = (uint8_t)((status.runCmd) | (status.runDirection << 1) |
+                    (protocol.remote << 2) | (protocol.linkTimeout << 3) |
+                    (status.speedLoop << 4) | (status.positionLoop << 5));
+        ProtocolU16Put(&response[2], ProtocolSaturateU16(status.speed));
+        ProtocolU16Put(&response[4], ProtocolSaturateU16(status.speedTarget));
+        ProtocolU16Put(&response[6],
+                    ProtocolSaturateU16(status.referenceCurrent * 1000.0f));
+        ProtocolU16Put(&response[8],
+                    ProtocolSaturateU16(status.dcBusVoltage * 10.0f));
+        /* Signed multi-turn position (0.1 degree) */
+        ProtocolU32Put(&response[10], (uint32_t)(int32_t)(status.position * 10.0f));
+        responseLen = 14;
+        break;
+
+    case PROTOCOL_CMD_GET_FAULTS:
+        MCAPP_MC1StatusGet(&status);
+        ProtocolU16Put(&response[0], (uint16_t)status.faultStatus);
+        ProtocolU16Put(&response[2], (uint16_t)status.faultFirst);
+        response[4] = (uint8_t)status.faultReaction;
+        response[5] = (uint8_t)status.controlFaultStatus;
+        response[6] = (uint8_t)protocol.rxOverrun;
+        response[7] = (uint8_t)status.faultCaptureState;
+        /* Entries beyond the u8 index of GET_FAULT_LOG are not readable */
+        response[8] = (status.faultLogCount > 255) ? 255 : 
+                                            (uint8_t)status.faultLogCount;
+        response[9] = (uint8_t)status.faultLockout;
+        response[10] = (uint8_t)status.faultRestarts;
+        ProtocolU16Put(&response[11], (uint16_t)status.faultPhases);
+        /* Upper half of fault status and first fault */
+        ProtocolU16Put(&response[13], (uint16_t)(status.faultStatus >> 16));
+        ProtocolU16Put(&response[15], (uint16_t)(status.faultFirst >> 16));
+        response[17] = (uint8_t)status.supervisorMissed;
+        response[18] = (uint8_t)status.watchdogReset;
+        responseLen = 19;
+        break;
+
+    case PROTOCOL_CMD_GET_THERMAL:
+        MCAPP_MC1StatusGet(&status);
+        /* Signed temperatures (0.1 degree C), current limit scale (%) */
+        ProtocolU16Put(&response[0], 
+                    (uint16_t)(int16_t)(status.windingTemperature * 10.0f));
+        ProtocolU16Put(&response[2], 
+                    (uint16_t)(int16_t)(status.inverterTemperature * 10.0f));
+        response[4] = (uint8_t)(status.thermalDerate * 100.0f);
+        responseLen = 5;
+        break;
+
+    case PROTOCOL_CMD_GET_FAULT_COUNTS:
+        if(pFrame->len > 1)
+        {
+            ProtocolNakSend(pFrame->cmd, PROTOCOL_ERROR_LENGTH);
+            return;
+        }
+        first = (pFrame->len == 1) ? pFrame->payload[0] : 0;
+        if(first >= MC1_FAULT_COUNT)
+        {
+            ProtocolNakSend(pFrame->cmd, PROTOCOL_ERROR_VALUE);
+            return;
+        }
+        /* First fault index, number of faults, then the counters from the 
+           first fault in the order of fault bits, saturated. Host requests
+           the remaining counters from the next index */
+        response[0] = (uint8_t)first;
+        response[1] = (uint8_t)MC1_FAULT_COUNT;
+        responseLen = 2;
+        for(index = first; (index < MC1_FAULT_COUNT) && 
+                (index < (first + PROTOCOL_FAULT_COUNTS_PER_FRAME)); index++)
+        {
+            ProtocolU16Put(&response[responseLen], 
+                    ProtocolSaturateU16((float)MCAPP_MC1FaultCounterGet(index)));
+            responseLen += 2;
+        }
+        break;
+
+    case PROTOCOL_CMD_GET_FAULT_LOG:
+        if(pFrame->len != 1)
+        {
+            ProtocolNakSend(pFrame->cmd, PROTOCOL_ERROR_LENGTH);
+            return;
+        }
+        if(!MCAPP_MC1FaultLogGet(pFrame->payload[0], &logEntry))
+        {
+            ProtocolNakSend(pFrame->cmd, PROTOCOL_ERROR_VALUE);
+            return;
+        }
+        response[0] = pFrame->payload[0];
+        ProtocolU32Put(&response[1], logEntry.sequence);
+        ProtocolU32Put(&response[5], logEntry.timestamp);
+        ProtocolU32Put(&response[9], logEntry.faultStatus);
+        ProtocolU16Put(&response[13], (uint16_t)logEntry.speed);
+        response[15] = logEntry.appState;
+        response[16] = logEntry.controlFaultStatus;
+        responseLen = 17;
+        break;
+
+    case PROTOCOL_CMD_GET_CAPTURE:
+        if(pFrame->len != 2)
+        {
+            ProtocolNakSend(pFrame->cmd, PROTOCOL_ERROR_LENGTH);
+            return;
+        }
+        index = ProtocolU16Get(pFrame->payload);
+        if(index >= FAULT_RECORDER_SAMPLES)
+        {
+            ProtocolNakSend(pFrame->cmd, PROTOCOL_ERROR_VALUE);
+            return;
+        }
+        if(!MCAPP_MC1FaultCaptureGet(index, &sample))
+        {
+            ProtocolNakSend(pFrame->cmd, PROTOCOL_ERROR_STATE);
+            return;
+        }
+        /* Sample index, index of fault sample, then the sample */
+        ProtocolU16Put(&response[0], (uint16_t)index);
+        ProtocolU16Put(&response[2], (uint16_t)(FAULT_RECORDER_SAMPLES - 
+                                            FAULT_RECORDER_POST_SAMPLES - 1));
+        ProtocolU16Put(&response[4], (uint16_t)sample.ia);
+        ProtocolU16Put(&response[6], (uint16_t)sample.ib);
+        ProtocolU16Put(&response[8], (uint16_t)sample.ic);
+        ProtocolU16Put(&response[10], (uint16_t)sample.id);
+        ProtocolU16Put(&response[12], (uint16_t)sample.va);
+        ProtocolU16Put(&response[14], (uint16_t)sample.vb);
+        ProtocolU16Put(&response[16], (uint16_t)sample.vc);
+        ProtocolU16Put(&response[18], (uint16_t)sample.vd);
+        ProtocolU16Put(&response[20], sample.theta);
+        ProtocolU16Put(&response[22], (uint16_t)sample.speed);
+        response[24] = sample.phaseOn;
+        response[25] = sample.switchState;
+        responseLen = 26;
+        break;
+
+    case PROTOCOL_CMD_ARM_CAPTURE:
+        MCAPP_MC1FaultCaptureArm();
+        break;
+
+    case PROTOCOL_CMD_CLEAR_FAULTS:
+        if(!MCAPP_MC1FaultReset())
+        {
+            ProtocolNakSend(pFrame->cmd, PROTOCOL_ERROR_STATE);
+            return;
+        }
+        /* Host starts the motor again with a new run command */
+        protocol.runCmd = 0;
+        break;
+
+    default:
+        ProtocolNakSend(pFrame->cmd, PROTOCOL_ERROR_COMMAND);
+        return;
+    }
+
+    ProtocolResponseSend(pFrame->cmd | PROTOCOL_RESPONSE_FLAG, response,
+                                                                responseLen);
+}
+
+/**
+* <B> Function: ProtocolResponseSend(uint8_t, const uint8_t *, uint8_t) </B>
+*
+* @brief Function to queue a frame to the transmit ring buffer and enable
+*        transmit interrupt. Frame is dropped if the buffer has no space.
+*
+* @param Command code.
+* @param Pointer to payload.
+* @param Payload length.
+* @return none.
+*
+* @example
+* <CODE> ProtocolResponseSend(cmd, payload, len); </CODE>
+*
+*/
+static void ProtocolResponseSend(uint8_t cmd, const uint8_t *pPayload,
+                                                                    uint8_t len)
+{
+    uint8_t frame[PROTOCOL_MAX_PAYLOAD + 5];
+    uint16_t crc = 0xFFFF;
+    uint32_t frameLen, index, head, used;
+
+    frame[0] = PROTOCOL_SOF;
+    frame[1] = cmd;
+    frame[2] = len;
+    for(index = 0; index < len; index++)
+    {
+        frame[3 + index] = pPayload[index];
+    }
+    for(index = 1; index < (uint32_t)(3 + len); index++)
+    {
+        crc = ProtocolCRC16Update(crc, frame[index]);
+    }
+    frame[3 + len] = (uint8_t)crc;
+    frame[4 + len] = (uint8_t)(crc >> 8);
+    frameLen = 5 + len;
+
+    head = protocol.txHead;
+    used = (head + PROTOCOL_TX_BUFFER_SIZE - protocol.txTail) %
+                                                    PROTOCOL_TX_BUFFER_SIZE;
+    if((PROTOCOL_TX_BUFFER_SIZE - 1 - used) < frameLen)
+    {
+        return;
+    }
+    for(index = 0; index < frameLen; index++)
+    {
+        protocol.txBuffer[head] = frame[index];
+        head = (head + 1) % PROTOCOL_TX_BUFFER_SIZE;
+    }
+    protocol.txHead = head;
+
+    UART1_InterruptTransmitEnable();
+}
+
+/**
+* <B> Function: ProtocolNakSend(uint8_t, uint8_t) </B>
+*
+* @brief Function to send negative acknowledgment for a rejected command.
+*
+* @param Command code of rejected command.
+* @param Error code PROTOCOL_ERROR_T.
+* @return none.
+*
+* @example
+* <CODE> ProtocolNakSend(cmd, PROTOCOL_ERROR_LENGTH); </CODE>
+*
+*/
+static void ProtocolNakSend(uint8_t cmd, uint8_t error)
+{
+    uint8_t payload[2];
+
+    payload[0] = cmd;
+    payload[1] = error;
+    ProtocolResponseSend(PROTOCOL_CMD_NAK, payload, 2);
+}
+
+static uint16_t ProtocolU16Get(const uint8_t *pData)
+{
+    return (uint16_t)pData[0] | ((uint16_t)pData[1] << 8);
+}
+
+static void ProtocolU16Put(uint8_t *pData, uint16_t value)
+{
+    pData[0] = (uint8_t)value;
+    pData[1] = (uint8_t)(value >> 8);
+}
+
+static uint32_t ProtocolU32Get(const uint8_t *pData)
+{
+    return (uint32_t)ProtocolU16Get(pData) | 
+                                ((uint32_t)ProtocolU16Get(&pData[2]) << 16);
+}
+
+static void ProtocolU32Put(uint8_t *pData, uint32_t value)
+{
+    ProtocolU16Put(pData, (uint16_t)value);
+    ProtocolU16Put(&pData[2], (uint16_t)(value >> 16));
+}
+
+static uint16_t ProtocolSaturateU16(float value)
+{
+    if(value <= 0)
+    {
+        return 0;
+    }
+    else if(value >= 65535.0f)
+    {
+        return 0xFFFF;
+    }
+    return (uint16_t)value;
+}
+
+// </editor-fold>
+
+#endif
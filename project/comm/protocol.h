@@ -0,0 +1,153 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file protocol.h
+ *
+ * @brief This header file lists the frame format, command codes and interface
+ * functions of the binary command/response protocol on UART1
+ *
+ * Frame : SOF(0xA5) | CMD | LEN | PAYLOAD[LEN] | CRC16 low | CRC16 high
+ * CRC16-CCITT (polynomial 0x1021, initial value 0xFFFF) is computed over
+ * CMD, LEN and PAYLOAD. Multi byte payload fields are little endian.
+ * Response to a valid command has CMD | 0x80, rejected command is answered
+ * with PROTOCOL_CMD_NAK carrying the command code and the error code.
+ *
+ * Component: PROTOCOL
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+#ifndef __PROTOCOL_H
+#define __PROTOCOL_H
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "diagnostics.h"
+
+// </editor-fold>
+
+#ifdef __cplusplus  // Provide C++ Compatability
+    extern "C" {
+#endif
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/CONSTANTS ">
+
+/* Define ENABLE_PROTOCOL to control the drive through binary protocol on
+   UART1. X2CScope uses the same UART, hence ENABLE_DIAGNOSTICS in
+   diagnostics.h must be undefined when protocol is enabled */
+#undef ENABLE_PROTOCOL
+
+#if defined(ENABLE_PROTOCOL) && defined(ENABLE_DIAGNOSTICS)
+#error "ENABLE_PROTOCOL and ENABLE_DIAGNOSTICS both use UART1, undefine one"
+#endif
+
+/* 100M/(16*54) = 115.7 kbps, same as X2CScope */
+#define PROTOCOL_BAUDRATE_DIVIDER   54
+
+#define PROTOCOL_SOF                0xA5
+#define PROTOCOL_MAX_PAYLOAD        32
+#define PROTOCOL_RESPONSE_FLAG      0x80
+#define PROTOCOL_TX_BUFFER_SIZE     128
+
+/* Fault counters per response of PROTOCOL_CMD_GET_FAULT_COUNTS, after the 
+   first fault index and the number of faults */
+#define PROTOCOL_FAULT_COUNTS_PER_FRAME ((PROTOCOL_MAX_PAYLOAD - 2) / 2)
+
+/* Remote control is stopped if no valid frame is received within timeout,
+   counted in Timer1 periods of 100us */
+#define PROTOCOL_LINK_TIMEOUT_MS    500
+#define PROTOCOL_LINK_TIMEOUT_COUNT (uint32_t)(PROTOCOL_LINK_TIMEOUT_MS * 10)
+
+/* Interrupt priorities, lower than Timer1 and control loop */
+#define PROTOCOL_RX_INTERRUPT_PRIORITY  3
+#define PROTOCOL_TX_INTERRUPT_PRIORITY  2
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="ENUMERATED CONSTANTS ">
+
+typedef enum
+{
+    PROTOCOL_CMD_PING = 0x01,           /* No payload, echoes protocol version */
+    PROTOCOL_CMD_SET_REMOTE = 0x02,     /* u8 : 1 = remote, 0 = local control */
+    PROTOCOL_CMD_SET_RUN = 0x10,        /* u8 : 1 = run, 0 = stop */
+    PROTOCOL_CMD_SET_DIRECTION = 0x11,  /* u8 : run direction */
+    PROTOCOL_CMD_SET_SPEED = 0x12,      /* u16 : target speed (RPM) */
+    PROTOCOL_CMD_SET_CURRENT = 0x13,    /* u16 : reference current (mA) */
+    PROTOCOL_CMD_AUTOTUNE = 0x14,       /* No payload, starts speed autotune */
+    PROTOCOL_CMD_SET_POSITION = 0x15,   /* u32 : target position (0.1 degree) */
+    PROTOCOL_CMD_GET_STATUS = 0x20,     /* No payload, returns drive status */
+    PROTOCOL_CMD_GET_FAULTS = 0x21,     /* No payload, returns fault status */
+    PROTOCOL_CMD_GET_FAULT_LOG = 0x22,  /* u8 : entry index, 0 = latest */
+    PROTOCOL_CMD_GET_CAPTURE = 0x23,    /* u16 : sample index, 0 = oldest */
+    PROTOCOL_CMD_ARM_CAPTURE = 0x24,    /* No payload, restarts fault capture */
+    PROTOCOL_CMD_GET_FAULT_COUNTS = 0x25,/* u8 : first fault index, optional */
+    PROTOCOL_CMD_CLEAR_FAULTS = 0x26,   /* No payload, resets faults and lockout */
+    PROTOCOL_CMD_GET_THERMAL = 0x27,    /* No payload, returns estimated temperatures */
+    PROTOCOL_CMD_SWEEP = 0x28,          /* u8 : 1 = start, 0 = abort efficiency sweep */
+    PROTOCOL_CMD_GET_SWEEP = 0x29,      /* No payload, returns efficiency sweep status */
+    PROTOCOL_CMD_GET_SWEEP_POINT = 0x2A,/* u8 : point index, 0 = first measured */
+    PROTOCOL_CMD_NAK = 0x7F,            /* u8 command, u8 error code */
+}PROTOCOL_COMMAND_T;
+
+typedef enum
+{
+    PROTOCOL_ERROR_CRC = 1,             /* Frame CRC mismatch */
+    PROTOCOL_ERROR_COMMAND = 2,         /* Unknown command */
+    PROTOCOL_ERROR_LENGTH = 3,          /* Payload length invalid for command */
+    PROTOCOL_ERROR_VALUE = 4,           /* Payload value out of range */
+    PROTOCOL_ERROR_STATE = 5,           /* Command not allowed in present state */
+}PROTOCOL_ERROR_T;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+
+void ProtocolInit(void);
+void ProtocolStepMain(void);
+void ProtocolStepIsr(void);
+bool ProtocolRemoteCommandGet(uint32_t *, uint32_t *, float *);
+
+// </editor-fold>
+
+#ifdef __cplusplus  // Provide C++ Compatibility
+    }
+#endif
+#endif      // end of __PROTOCOL_H
@@ -0,0 +1,247 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file autotune.c
+ *
+ * @brief This module implements speed loop autotune by relay feedback.
+ *
+ * The relay switches the reference current between currentHigh and currentLow
+ * whenever the speed leaves the hysteresis band around the setpoint. With the
+ * mechanical model dw/dt = accelGain * (i - frictionCurrent), the acceleration
+ * and deceleration slopes of the resulting speed oscillation give
+ *     accelGain       = (slopeUp + slopeDown) / (currentHigh - currentLow)
+ *     frictionCurrent = currentHigh - slopeUp / accelGain
+ * and the PI gains for the target bandwidth wc are
+ *     kp = wc / accelGain,  ki = kp * wc / 4 * sampleTime
+ *
+ * Component: AUTOTUNE
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <stdint.h>
+#include "autotune.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
+
+static void MCAPP_AutotuneIdentify(MCAPP_AUTOTUNE_T *);
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+
+/**
+* <B> Function: MCAPP_AutotuneInit(MCAPP_AUTOTUNE_T *)  </B>
+*
+* @brief Function to stop the autotune experiment. Identified results and
+*        configuration parameters are retained.
+*
+* @param Pointer to the data structure containing autotune parameters.
+* @return none.
+*
+* @example
+* <CODE> MCAPP_AutotuneInit(&autotune); </CODE>
+*
+*/
+void MCAPP_AutotuneInit(MCAPP_AUTOTUNE_T *pAutotune)
+{
+    if(pAutotune->state == AUTOTUNE_RELAY)
+    {
+        pAutotune->state = AUTOTUNE_IDLE;
+    }
+    pAutotune->request = 0;
+    pAutotune->relayHigh = 1;
+    pAutotune->cycle = 0;
+    pAutotune->counter = 0;
+    pAutotune->timeoutCounter = 0;
+}
+
+/**
+* <B> Function: MCAPP_AutotuneStart(MCAPP_AUTOTUNE_T *)  </B>
+*
+* @brief Function to start the relay feedback experiment.
+*
+* @param Pointer to the data structure containing autotune parameters.
+* @return none.
+*
+* @example
+* <CODE> MCAPP_AutotuneStart(&autotune); </CODE>
+*
+*/
+void MCAPP_AutotuneStart(MCAPP_AUTOTUNE_T *pAutotune)
+{
+    pAutotune->request = 0;
+    pAutotune->relayHigh = 1;
+    pAutotune->cycle = 0;
+    pAutotune->counter = 0;
+    pAutotune->timeoutCounter = 0;
+    pAutotune->speedMax = 0;
+    pAutotune->speedMin = pAutotune->setpoint;
+    pAutotune->timeUp = 0;
+    pAutotune->sumSwing = 0;
+    pAutotune->sumTimeUp = 0;
+    pAutotune->sumTimeDown = 0;
+    pAutotune->state = AUTOTUNE_RELAY;
+}
+
+/**
+* <B> Function: MCAPP_AutotuneStep(MCAPP_AUTOTUNE_T *, float)  </B>
+*
+* @brief Function executes the relay feedback experiment, to be called at
+*        the speed loop rate while state is AUTOTUNE_RELAY.
+*
+* @param Pointer to the data structure containing autotune parameters.
+* @param Measured speed (RPM).
+* @return Reference current (A).
+*
+* @example
+* <CODE> referenceCurrent = MCAPP_AutotuneStep(&autotune, speed); </CODE>
+*
+*/
+float MCAPP_AutotuneStep(MCAPP_AUTOTUNE_T *pAutotune, float speed)
+{
+    pAutotune->counter++;
+    pAutotune->timeoutCounter++;
+
+    if(speed > pAutotune->speedMax)
+    {
+        pAutotune->speedMax = speed;
+    }
+    if(speed < pAutotune->speedMin)
+    {
+        pAutotune->speedMin = speed;
+    }
+
+    if((pAutotune->relayHigh == 1) &&
+            (speed >= (pAutotune->setpoint + pAutotune->hysteresis)))
+    {
+        /* End of acceleration half period */
+        pAutotune->timeUp = (float)pAutotune->counter * pAutotune->sampleTime;
+        pAutotune->counter = 0;
+        pAutotune->relayHigh = 0;
+    }
+    else if((pAutotune->relayHigh == 0) &&
+            (speed <= (pAutotune->setpoint - pAutotune->hysteresis)))
+    {
+        /* End of deceleration half period completes a relay cycle */
+        if(pAutotune->cycle >= pAutotune->skipCycles)
+        {
+            pAutotune->sumSwing += pAutotune->speedMax - pAutotune->speedMin;
+            pAutotune->sumTimeUp += pAutotune->timeUp;
+            pAutotune->sumTimeDown +=
+                            (float)pAutotune->counter * pAutotune->sampleTime;
+        }
+        pAutotune->cycle++;
+        pAutotune->counter = 0;
+        pAutotune->relayHigh = 1;
+        pAutotune->speedMax = speed;
+        pAutotune->speedMin = speed;
+
+        if(pAutotune->cycle >=
+                            (pAutotune->skipCycles + pAutotune->measureCycles))
+        {
+            MCAPP_AutotuneIdentify(pAutotune);
+        }
+    }
+
+    if((pAutotune->state == AUTOTUNE_RELAY) &&
+            (pAutotune->timeoutCounter >= pAutotune->timeoutCount))
+    {
+        pAutotune->state = AUTOTUNE_FAILED;
+    }
+
+    if(pAutotune->relayHigh == 1)
+    {
+        return pAutotune->currentHigh;
+    }
+    else
+    {
+        return pAutotune->currentLow;
+    }
+}
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
+
+/**
+* <B> Function: MCAPP_AutotuneIdentify(MCAPP_AUTOTUNE_T *)  </B>
+*
+* @brief Function identifies acceleration gain and friction current from the
+*        averaged relay cycles and computes PI gains for target bandwidth.
+*
+* @param Pointer to the data structure containing autotune parameters.
+* @return none.
+*
+* @example
+* <CODE> MCAPP_AutotuneIdentify(&autotune); </CODE>
+*
+*/
+static void MCAPP_AutotuneIdentify(MCAPP_AUTOTUNE_T *pAutotune)
+{
+    float slopeUp, slopeDown;
+
+    if((pAutotune->sumSwing <= 0) || (pAutotune->sumTimeUp <= 0) ||
+        (pAutotune->sumTimeDown <= 0) ||
+                        (pAutotune->currentHigh <= pAutotune->currentLow))
+    {
+        pAutotune->state = AUTOTUNE_FAILED;
+        return;
+    }
+
+    /* Averaging over cycles cancels in the ratio of sums */
+    slopeUp   = pAutotune->sumSwing / pAutotune->sumTimeUp;
+    slopeDown = pAutotune->sumSwing / pAutotune->sumTimeDown;
+
+    pAutotune->accelGain = (slopeUp + slopeDown) /
+                            (pAutotune->currentHigh - pAutotune->currentLow);
+    pAutotune->inertia = 1.0f / pAutotune->accelGain;
+    pAutotune->frictionCurrent = pAutotune->currentHigh -
+                                            slopeUp * pAutotune->inertia;
+
+    pAutotune->kp = pAutotune->bandwidth * pAutotune->inertia;
+    pAutotune->ki = pAutotune->kp * pAutotune->bandwidth * 0.25f *
+                                                        pAutotune->sampleTime;
+
+    pAutotune->state = AUTOTUNE_COMPLETE;
+}
+
+// </editor-fold>
@@ -0,0 +1,124 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file autotune.h
+ *
+ * @brief This header file lists data type definitions and interface functions
+ * of the speed loop autotune module
+ *
+ * Component: AUTOTUNE
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+#ifndef __AUTOTUNE_H
+#define __AUTOTUNE_H
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// </editor-fold>
+
+#ifdef __cplusplus  // Provide C++ Compatability
+    extern "C" {
+#endif
+
+// <editor-fold defaultstate="expanded" desc="ENUMERATED CONSTANTS ">
+
+typedef enum
+{
+    AUTOTUNE_IDLE = 0,          /* Autotune not running */
+    AUTOTUNE_RELAY = 1,         /* Relay feedback experiment is running */
+    AUTOTUNE_COMPLETE = 2,      /* Identification completed, gains are valid */
+    AUTOTUNE_FAILED = 3,        /* Experiment timed out or result is invalid */
+}MCAPP_AUTOTUNE_STATE_T;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="TYPE DEFINITIONS ">
+
+/**
+ * Autotune data type
+*/
+typedef struct
+{
+    uint32_t
+        request,            /* Set to 1 to start autotune (from X2CScope or UART) */
+        state,              /* Autotune state MCAPP_AUTOTUNE_STATE_T */
+        relayHigh,          /* Relay output, 1 = currentHigh, 0 = currentLow */
+        cycle,              /* Number of completed relay cycles */
+        skipCycles,         /* Relay cycles ignored while oscillation settles */
+        measureCycles,      /* Relay cycles used for identification */
+        counter,            /* Executions in the present relay half period */
+        timeoutCounter,     /* Executions since start of the experiment */
+        timeoutCount;       /* Maximum executions of the experiment */
+    float
+        setpoint,           /* Speed around which relay oscillates (RPM) */
+        hysteresis,         /* Relay hysteresis band (RPM) */
+        currentHigh,        /* Relay output current while accelerating (A) */
+        currentLow,         /* Relay output current while decelerating (A) */
+        bandwidth,          /* Target speed loop bandwidth (rad/s) */
+        sampleTime,         /* Execution period of autotune and speed loop (s) */
+        speedMax,           /* Maximum speed of present relay cycle */
+        speedMin,           /* Minimum speed of present relay cycle */
+        timeUp,             /* Acceleration time of present relay cycle */
+        sumSwing,           /* Accumulated peak to peak speed of relay cycles */
+        sumTimeUp,          /* Accumulated acceleration time of relay cycles */
+        sumTimeDown,        /* Accumulated deceleration time of relay cycles */
+        accelGain,          /* Identified acceleration per ampere (RPM/s/A) */
+        inertia,            /* Identified normalized inertia (A/(RPM/s)) */
+        frictionCurrent,    /* Identified current to overcome friction (A) */
+        kp,                 /* Computed proportional gain */
+        ki;                 /* Computed integral gain */
+} MCAPP_AUTOTUNE_T;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+
+void MCAPP_AutotuneInit(MCAPP_AUTOTUNE_T *);
+void MCAPP_AutotuneStart(MCAPP_AUTOTUNE_T *);
+float MCAPP_AutotuneStep(MCAPP_AUTOTUNE_T *, float);
+
+// </editor-fold>
+
+#ifdef __cplusplus  // Provide C++ Compatibility
+    }
+#endif
+#endif      // end of __AUTOTUNE_H
@@ -53,6 +53,28 @@
 
 // <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
 
+/**
+* <B> Function: void MCAPP_ControllerHysteresisLimits(MCAPP_HCCPARMIN_T *, MCAPP_HCCSTATE_T *)  </B>
+*
+* @brief Function computes the upper and lower current limits of the 
+*        tolerance band around the reference current
+*
+* @param Pointer to the data structure containing HCC Controller input.
+* @param Pointer to the data structure containing HCC Controller state.
+* @return none.
+* @example
+* <CODE> MCAPP_ControllerHysteresisLimits(&pHCCParmInput, &pHCCState); </CODE>
+*
+*/
+void MCAPP_ControllerHysteresisLimits ( MCAPP_HCCPARMIN_T *pHCCParmInput, 
+               MCAPP_HCCSTATE_T *pHCCState)
+{
+    pHCCState->currentUpperLimit = (float) pHCCParmInput->currentReference * 
+                                                        ( 1 + pHCCState->beta );
+    pHCCState->currentLowerLimit = (float) pHCCParmInput->currentReference * 
+                                                        ( 1 - pHCCState->beta );
+}
+
 /**
 * <B> Function: void MCAPP_ControllerHysteresis(float, float, float)  </B>
 *
@@ -69,10 +91,7 @@
 void MCAPP_ControllerHysteresis ( MCAPP_HCCPARMIN_T *pHCCParmInput, 
                MCAPP_HCCSTATE_T *pHCCState, MCAPP_HCCPARMOUT_T *pHCCParmOutput)
 {            
-    pHCCState->currentUpperLimit = (float) pHCCParmInput->currentReference * 
-                                                        ( 1 + pHCCState->beta );
-    pHCCState->currentLowerLimit = (float) pHCCParmInput->currentReference * 
-                                                        ( 1 - pHCCState->beta );
+    MCAPP_ControllerHysteresisLimits(pHCCParmInput, pHCCState);
     
     if(pHCCParmInput->currentActual <= pHCCState->currentLowerLimit)
     {
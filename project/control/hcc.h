@@ -63,6 +63,7 @@ extern "C" {
 
 // <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
 
+void MCAPP_ControllerHysteresisLimits ( MCAPP_HCCPARMIN_T *, MCAPP_HCCSTATE_T *);
 void MCAPP_ControllerHysteresis ( MCAPP_HCCPARMIN_T *, MCAPP_HCCSTATE_T *,
                                                         MCAPP_HCCPARMOUT_T *);
     
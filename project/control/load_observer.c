@@ -0,0 +1,118 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file load_observer.c
+ *
+ * @brief This module implements the load torque observer.
+ *
+ * From the mechanical equation J * dw/dt = Kt * i - TL, the load torque is
+ * estimated as TL = LPF(Kt * i - J * dw/dt) using the reference current
+ * applied in the previous execution and the measured speed.
+ *
+ * Component: LOAD OBSERVER
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <stdint.h>
+#include "load_observer.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+
+/**
+* <B> Function: MCAPP_LoadObserverInit(MCAPP_LOAD_OBSERVER_T *, float)  </B>
+*
+* @brief Function to reset the observer states.
+*
+* @param Pointer to the data structure containing observer parameters.
+* @param Measured speed (RPM).
+* @return none.
+*
+* @example
+* <CODE> MCAPP_LoadObserverInit(&loadObserver, speed); </CODE>
+*
+*/
+void MCAPP_LoadObserverInit(MCAPP_LOAD_OBSERVER_T *pObserver, float speed)
+{
+    pObserver->speedPrev = speed * RPM_TO_RAD_PER_SEC;
+    pObserver->accelTorque = 0;
+    pObserver->loadTorque = 0;
+    pObserver->feedForwardCurrent = 0;
+}
+
+/**
+* <B> Function: MCAPP_LoadObserverUpdate(MCAPP_LOAD_OBSERVER_T *, float, float)  </B>
+*
+* @brief Function to estimate the load torque, to be called at the speed 
+*        loop rate.
+*
+* @param Pointer to the data structure containing observer parameters.
+* @param Reference current applied in the previous execution (A).
+* @param Measured speed (RPM).
+* @return none.
+*
+* @example
+* <CODE> MCAPP_LoadObserverUpdate(&loadObserver, referenceCurrent, speed); </CODE>
+*
+*/
+void MCAPP_LoadObserverUpdate(MCAPP_LOAD_OBSERVER_T *pObserver, 
+                                        float referenceCurrent, float speed)
+{
+    float speedRad;
+    float loadTorque;
+    
+    speedRad = speed * RPM_TO_RAD_PER_SEC;
+    
+    pObserver->accelTorque = pObserver->inertia * 
+                        (speedRad - pObserver->speedPrev) / pObserver->sampleTime;
+    pObserver->speedPrev = speedRad;
+    
+    loadTorque = pObserver->torqueConstant * referenceCurrent - 
+                                                        pObserver->accelTorque;
+    
+    pObserver->loadTorque = pObserver->loadTorque + 
+        pObserver->filterCoefficient * (loadTorque - pObserver->loadTorque);
+    
+    pObserver->feedForwardCurrent = pObserver->loadTorque / 
+                                                    pObserver->torqueConstant;
+}
+
+// </editor-fold>
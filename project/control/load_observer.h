@@ -0,0 +1,101 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file load_observer.h
+ *
+ * @brief This header file lists data type definitions and interface functions
+ * of the load torque observer module
+ *
+ * Component: LOAD OBSERVER
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+#ifndef __LOAD_OBSERVER_H
+#define __LOAD_OBSERVER_H
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// </editor-fold>
+
+#ifdef __cplusplus  // Provide C++ Compatability
+    extern "C" {
+#endif
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/CONSTANTS ">
+
+/* Conversion of speed from RPM to rad/s */
+#define RPM_TO_RAD_PER_SEC      0.10471976f
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="TYPE DEFINITIONS ">
+
+/**
+ * Load torque observer data type
+*/
+typedef struct
+{
+    uint32_t
+        feedForwardEnable;  /* 1 = observed load is fed forward to reference current */
+    float
+        torqueConstant,     /* Torque per ampere model of the motor (Nm/A) */
+        inertia,            /* Inertia of motor and load (kg.m^2) */
+        filterCoefficient,  /* Low pass filter co-efficient of the estimate (0 to 1) */
+        sampleTime,         /* Execution period of the observer (s) */
+        speedPrev,          /* Speed of previous execution (rad/s) */
+        accelTorque,        /* Torque required for acceleration (Nm) */
+        loadTorque,         /* Estimated load torque (Nm) */
+        feedForwardCurrent; /* Current to compensate the estimated load (A) */
+} MCAPP_LOAD_OBSERVER_T;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+
+void MCAPP_LoadObserverInit(MCAPP_LOAD_OBSERVER_T *, float);
+void MCAPP_LoadObserverUpdate(MCAPP_LOAD_OBSERVER_T *, float, float);
+
+// </editor-fold>
+
+#ifdef __cplusplus  // Provide C++ Compatibility
+    }
+#endif
+#endif      // end of __LOAD_OBSERVER_H
@@ -0,0 +1,249 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file noise_shaping.c
+ *
+ * @brief This module implements the acoustic noise shaping of the phase
+ * current at turn-off.
+ *
+ * The reference current is ramped down at the end of the sector (soft
+ * turn-off), the phase turned off may freewheel at zero voltage before it is
+ * demagnetized (two-stage turn-off) and the HCC band is randomized on each
+ * commutation to spread the chopping frequency. The phase switching itself
+ * is done by the SRM control.
+ *
+ * Component: NOISE SHAPING
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <stdint.h>
+#include "math.h"
+#include "noise_shaping.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
+
+static float MCAPP_NoiseRandom(uint32_t *);
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+
+/**
+* <B> Function: MCAPP_NoiseShapingInit(MCAPP_NOISE_SHAPING_T *,
+*                                                   MCAPP_HCCSTATE_T *)  </B>
+*
+* @brief Function to clear the turn-off state and the force slew metric and
+*        to set the nominal HCC band.
+*
+* @param Pointer to the noise shaping data structure.
+* @param Pointer to the HCC state.
+* @return none.
+* @example
+* <CODE> MCAPP_NoiseShapingInit(&noise, &hccState); </CODE>
+*
+*/
+void MCAPP_NoiseShapingInit(MCAPP_NOISE_SHAPING_T *pNoise,
+                                                MCAPP_HCCSTATE_T *pHccState)
+{
+    pNoise->phasePrev        = 0;
+    pNoise->phaseOff         = 0;
+    pNoise->freewheelCounter = 0;
+    pNoise->decaying         = 0;
+    pNoise->metricReset      = 0;
+    pNoise->profileScale     = 1.0f;
+    pNoise->forcePrev        = 0;
+    pNoise->forceSlew        = 0;
+    pNoise->forceSlewPeak    = 0;
+    pHccState->beta          = pNoise->betaNominal;
+}
+
+/**
+* <B> Function: MCAPP_NoiseProfileUpdate(MCAPP_NOISE_SHAPING_T *, float)  </B>
+*
+* @brief Function to update the reference scale of the soft turn-off. The
+*        scale ramps linearly from 1 at rampStart share of the sector to
+*        rampEndScale at the end of the sector.
+*
+* @param Pointer to the noise shaping data structure.
+* @param Progress of the active phase in its sector 0 - 1.
+* @return none.
+* @example
+* <CODE> MCAPP_NoiseProfileUpdate(&noise, progress); </CODE>
+*
+*/
+void MCAPP_NoiseProfileUpdate(MCAPP_NOISE_SHAPING_T *pNoise, float progress)
+{
+    pNoise->profileScale = 1.0f;
+    if((pNoise->softTurnOff == 1) && (progress > pNoise->rampStart))
+    {
+        pNoise->profileScale = 1.0f - ((1.0f - pNoise->rampEndScale) *
+                                        (progress - pNoise->rampStart) /
+                                                (1.0f - pNoise->rampStart));
+    }
+}
+
+/**
+* <B> Function: MCAPP_NoiseCommutationUpdate(MCAPP_NOISE_SHAPING_T *,
+*                                       uint32_t, MCAPP_HCCSTATE_T *)  </B>
+*
+* @brief Function to detect commutation of the active phase. The phase turned
+*        off is freewheeled for freewheelCount executions before it is
+*        demagnetized (two-stage turn-off), and the HCC band of the phase
+*        turned on is randomized within betaSpread to spread the chopping
+*        frequency. Decay of the phase turned off is measured by the noise
+*        metric.
+*
+* @param Pointer to the noise shaping data structure.
+* @param Active phase.
+* @param Pointer to the HCC state.
+* @return none.
+* @example
+* <CODE> MCAPP_NoiseCommutationUpdate(&noise, phaseOn, &hccState); </CODE>
+*
+*/
+void MCAPP_NoiseCommutationUpdate(MCAPP_NOISE_SHAPING_T *pNoise,
+                            uint32_t phaseOn, MCAPP_HCCSTATE_T *pHccState)
+{
+    if(phaseOn == pNoise->phasePrev)
+    {
+        return;
+    }
+
+    if(pNoise->phasePrev != 0)
+    {
+        pNoise->phaseOff = pNoise->phasePrev;
+        pNoise->decaying = 1;
+        pNoise->forcePrev = -1.0f;
+        if(pNoise->twoStageTurnOff == 1)
+        {
+            pNoise->freewheelCounter = pNoise->freewheelCount;
+        }
+    }
+    if(pNoise->randomBand == 1)
+    {
+        pHccState->beta = pNoise->betaNominal + (pNoise->betaSpread * 
+                                    MCAPP_NoiseRandom(&pNoise->randomState));
+    }
+    pNoise->phasePrev = phaseOn;
+}
+
+/**
+* <B> Function: MCAPP_NoiseMetricUpdate(MCAPP_NOISE_SHAPING_T *, float)  </B>
+*
+* @brief Function to update the radial force proxy for acoustic noise.
+*        Radial force of a phase is proportional to the square of its current.
+*        Noise is excited by the fast drop of the force at turn-off, hence the
+*        change of the squared current of the phase turned off per execution
+*        is filtered and its peak is held from commutation until the current
+*        has decayed, to compare turn-off profiles. Turn-on and chopping of
+*        the active phase are the same for all profiles and not measured.
+*
+* @param Pointer to the noise shaping data structure.
+* @param Measured current of the phase turned off (A).
+* @return none.
+* @example
+* <CODE> MCAPP_NoiseMetricUpdate(&noise, currentOff); </CODE>
+*
+*/
+void MCAPP_NoiseMetricUpdate(MCAPP_NOISE_SHAPING_T *pNoise, float currentOff)
+{
+    float force, slew;
+
+    if(pNoise->metricReset == 1)
+    {
+        pNoise->forceSlew = 0;
+        pNoise->forceSlewPeak = 0;
+        pNoise->metricReset = 0;
+    }
+    if(pNoise->decaying == 0)
+    {
+        return;
+    }
+
+    force = currentOff * currentOff;
+
+    /* First execution after commutation sets the reference of the change */
+    if(pNoise->forcePrev >= 0)
+    {
+        slew = fabsf(force - pNoise->forcePrev);
+        pNoise->forceSlew += pNoise->forceFilter * (slew - pNoise->forceSlew);
+        if(slew > pNoise->forceSlewPeak)
+        {
+            pNoise->forceSlewPeak = slew;
+        }
+    }
+    pNoise->forcePrev = force;
+
+    if(fabsf(currentOff) <= pNoise->decayCurrent)
+    {
+        pNoise->decaying = 0;
+    }
+}
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
+
+/**
+* <B> Function: float MCAPP_NoiseRandom(uint32_t *)  </B>
+*
+* @brief Function to generate a pseudo random number by xorshift.
+*
+* @param Pointer to the generator state, nonzero.
+* @return Pseudo random number 0 - 1.
+* @example
+* <CODE> MCAPP_NoiseRandom(&randomState); </CODE>
+*
+*/
+static float MCAPP_NoiseRandom(uint32_t *pState)
+{
+    uint32_t x = *pState;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *pState = x;
+
+    return (float)(x >> 8) * (1.0f / 16777216.0f);
+}
+
+// </editor-fold>
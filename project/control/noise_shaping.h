@@ -0,0 +1,109 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file noise_shaping.h
+ *
+ * @brief This header file lists data type definitions and interface functions
+ * of the acoustic noise shaping module
+ *
+ * Component: NOISE SHAPING
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+#ifndef __NOISE_SHAPING_H
+#define __NOISE_SHAPING_H
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hcc_types.h"
+
+// </editor-fold>
+
+#ifdef __cplusplus  // Provide C++ Compatability
+    extern "C" {
+#endif
+
+// <editor-fold defaultstate="collapsed" desc="TYPE DEFINITIONS ">
+
+/**
+ * Acoustic noise shaping data type
+*/
+typedef struct
+{
+    uint32_t
+        softTurnOff,        /* 1 = reference ramps down at the end of the sector */
+        twoStageTurnOff,    /* 1 = phase freewheels before demagnetization */
+        randomBand,         /* 1 = HCC band is randomized on commutation */
+        phasePrev,          /* Active phase of previous execution */
+        phaseOff,           /* Phase in freewheel stage of turn-off */
+        freewheelCount,     /* Control loop executions of freewheel stage */
+        freewheelCounter,   /* Remaining executions of freewheel stage */
+        randomState,        /* State of pseudo random generator */
+        decaying,           /* 1 = current of phase turned off is decaying */
+        metricReset;        /* Set to 1 to clear the force slew metric */
+    float
+        rampStart,          /* Share of sector at which the ramp starts */
+        rampEndScale,       /* Reference scale at the end of the sector */
+        profileScale,       /* Reference scale of present execution */
+        betaNominal,        /* HCC band without randomization */
+        betaSpread,         /* Range of random band added to betaNominal */
+        forceFilter,        /* Filter coefficient of force slew metric */
+        decayCurrent,       /* Current at which turn-off is complete (A) */
+        forcePrev,          /* Squared current of phase turned off, previous execution (A^2) */
+        forceSlew,          /* Filtered change of squared current at turn-off (A^2) */
+        forceSlewPeak;      /* Peak change of squared current at turn-off (A^2) */
+} MCAPP_NOISE_SHAPING_T;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+
+void MCAPP_NoiseShapingInit(MCAPP_NOISE_SHAPING_T *, MCAPP_HCCSTATE_T *);
+void MCAPP_NoiseProfileUpdate(MCAPP_NOISE_SHAPING_T *, float);
+void MCAPP_NoiseCommutationUpdate(MCAPP_NOISE_SHAPING_T *, uint32_t,
+                                                        MCAPP_HCCSTATE_T *);
+void MCAPP_NoiseMetricUpdate(MCAPP_NOISE_SHAPING_T *, float);
+
+// </editor-fold>
+
+#ifdef __cplusplus  // Provide C++ Compatibility
+    }
+#endif
+#endif      // end of __NOISE_SHAPING_H
@@ -47,6 +47,7 @@
 // <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
 
 #include <stdint.h>
+#include <stddef.h>
 #include "pi.h"
 
 // </editor-fold>
@@ -99,4 +100,148 @@ void MC_ControllerPIUpdate(MC_PIPARMIN_T *pPIParmInput,MCAPP_PISTATE_T *pPIState
     
 }
 
+/**
+* <B> Function: MC_ControllerPIExtendedUpdate(MC_PIPARMIN_T *,MCAPP_PISTATE_T *,
+*                                                       MC_PIPARMOUT_T *)  </B>
+*
+* @brief Function implementing PI Controller with gain scheduling, reference 
+*        feed-forward, filtered derivative on measurement and selectable 
+*        anti-windup. With kd, kff set to zero, no gain table and back 
+*        calculation anti-windup, the output is identical to 
+*        MC_ControllerPIUpdate.
+*        
+* @param Pointer to the data structure containing PI Controller input.
+* @param Pointer to the data structure containing PI Controller state.
+* @param Pointer to the data structure containing PI Controller output.
+* @return none.
+* 
+* @example
+* <CODE> MC_ControllerPIExtendedUpdate(&piInput,&piInput.piState,&piOutput); </CODE>
+*
+*/
+void MC_ControllerPIExtendedUpdate(MC_PIPARMIN_T *pPIParmInput,
+                      MCAPP_PISTATE_T *pPIState, MC_PIPARMOUT_T *pPIParmOutput)
+{
+    float error;
+    float U;
+    float excess;
+    float feedForward;
+
+    if(pPIState->pGainTable != NULL)
+    {
+        MC_ControllerPIGainSchedule(pPIState, pPIParmInput->inMeasure);
+    }
+    
+    error  = pPIParmInput->inReference - pPIParmInput->inMeasure;
+
+    /* Derivative on measurement avoids derivative kick on reference change */
+    pPIState->derivative = pPIState->derivative + pPIState->kdFilter *
+            (-pPIState->kd * (pPIParmInput->inMeasure - pPIState->measurePrev) 
+                                                    - pPIState->derivative);
+    
+    /* Feed-forward of reference change per execution (acceleration) */
+    feedForward = pPIState->kff * 
+                    (pPIParmInput->inReference - pPIState->referencePrev);
+    
+    pPIState->measurePrev   = pPIParmInput->inMeasure;
+    pPIState->referencePrev = pPIParmInput->inReference;
+    
+    U  = pPIState->integrator + pPIState->kp * error + pPIState->derivative +
+                                                                    feedForward;
+
+    if( U > pPIState->outMax )
+    {
+        pPIParmOutput->out = pPIState->outMax;
+    }
+    else if( U < pPIState->outMin )
+    {
+        pPIParmOutput->out = pPIState->outMin;
+    }
+    else
+    {
+        pPIParmOutput->out = U;
+    }
+
+    if(pPIState->antiWindup == MC_PI_ANTIWINDUP_CLAMPING)
+    {
+        /* Stop integration while output is saturated in direction of error */
+        if(((U > pPIState->outMax) && (error > 0)) ||
+                                    ((U < pPIState->outMin) && (error < 0)))
+        {
+            /* Hold integrator */
+        }
+        else
+        {
+            pPIState->integrator = pPIState->integrator + pPIState->ki * error;
+        }
+        
+        if(pPIState->integrator > pPIState->outMax)
+        {
+            pPIState->integrator = pPIState->outMax;
+        }
+        else if(pPIState->integrator < pPIState->outMin)
+        {
+            pPIState->integrator = pPIState->outMin;
+        }
+    }
+    else
+    {
+        excess = U - pPIParmOutput->out;
+        pPIState->integrator = pPIState->integrator +
+                               pPIState->ki * error -
+                               pPIState->kc * excess;
+    }
+}
+
+/**
+* <B> Function: MC_ControllerPIGainSchedule(MCAPP_PISTATE_T *, float)  </B>
+*
+* @brief Function to update kp and ki by linear interpolation of the gain 
+*        scheduling table. Gains are held constant outside the table range.
+*        
+* @param Pointer to the data structure containing PI Controller state.
+* @param Scheduling variable, magnitude is used.
+* @return none.
+* 
+* @example
+* <CODE> MC_ControllerPIGainSchedule(&piInput.piState, speed); </CODE>
+*
+*/
+void MC_ControllerPIGainSchedule(MCAPP_PISTATE_T *pPIState, float input)
+{
+    const MC_PIGAINPOINT_T *pTable = pPIState->pGainTable;
+    uint32_t index;
+    float ratio;
+    
+    if(input < 0)
+    {
+        input = -input;
+    }
+    
+    if(input <= pTable[0].input)
+    {
+        pPIState->kp = pTable[0].kp;
+        pPIState->ki = pTable[0].ki;
+    }
+    else if(input >= pTable[pPIState->gainTableSize - 1].input)
+    {
+        pPIState->kp = pTable[pPIState->gainTableSize - 1].kp;
+        pPIState->ki = pTable[pPIState->gainTableSize - 1].ki;
+    }
+    else
+    {
+        index = 1;
+        while(input > pTable[index].input)
+        {
+            index++;
+        }
+        ratio = (input - pTable[index - 1].input) /
+                            (pTable[index].input - pTable[index - 1].input);
+        pPIState->kp = pTable[index - 1].kp + 
+                            ratio * (pTable[index].kp - pTable[index - 1].kp);
+        pPIState->ki = pTable[index - 1].ki + 
+                            ratio * (pTable[index].ki - pTable[index - 1].ki);
+    }
+}
+
 // </editor-fold>
\ No newline at end of file
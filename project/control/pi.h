@@ -61,6 +61,31 @@
 
 // <editor-fold defaultstate="collapsed" desc="TYPE DEFINITIONS ">
 
+/**
+ * PI Controller anti-windup modes
+*/
+typedef enum
+{
+    MC_PI_ANTIWINDUP_BACK_CALCULATION = 0, /* Integrator corrected by kc * excess */
+    MC_PI_ANTIWINDUP_CLAMPING = 1,         /* Integration stopped when saturated */
+} MC_PI_ANTIWINDUP_T;
+
+/**
+ * PI Controller gain scheduling point data type
+*/
+typedef struct
+{
+    /** Scheduling variable (e.g. speed) at which the gains apply */
+    float input;
+
+    /** Proportional gain co-efficient term */
+    float kp;
+
+    /** Integral gain co-efficient term */
+    float ki;
+
+} MC_PIGAINPOINT_T;
+
 /**
  * PI Controller State data type
 */
@@ -84,6 +109,33 @@ typedef struct
     /** Minimum output limit */
     float outMin;
 
+    /** Derivative (on measurement) gain co-efficient term */
+    float kd;
+
+    /** Low pass filter co-efficient of derivative term */
+    float kdFilter;
+
+    /** Filtered derivative term */
+    float derivative;
+
+    /** Reference feed-forward gain co-efficient term */
+    float kff;
+
+    /** Measured value of previous execution */
+    float measurePrev;
+
+    /** Reference of previous execution */
+    float referencePrev;
+
+    /** Anti-windup mode MC_PI_ANTIWINDUP_T */
+    uint32_t antiWindup;
+
+    /** Gain scheduling table sorted by increasing input, NULL if not used */
+    const MC_PIGAINPOINT_T *pGainTable;
+
+    /** Number of points in gain scheduling table */
+    uint32_t gainTableSize;
+
 } MCAPP_PISTATE_T;
 
 /**
@@ -115,6 +167,9 @@ typedef struct
 
 void MC_ControllerPIUpdate(MC_PIPARMIN_T *, MCAPP_PISTATE_T *,
                                                               MC_PIPARMOUT_T *);
+void MC_ControllerPIExtendedUpdate(MC_PIPARMIN_T *, MCAPP_PISTATE_T *,
+                                                              MC_PIPARMOUT_T *);
+void MC_ControllerPIGainSchedule(MCAPP_PISTATE_T *, float);
 
 // </editor-fold>
 
@@ -48,6 +48,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include "math.h"
 
 #include "srm_control.h"
@@ -57,8 +58,29 @@
 
 // <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
 static void MCAPP_GetControlInputs(MCAPP_SRM_CONTROL_T *);
-static void MCAPP_SRMControl(MCAPP_SRM_CONTROL_T *, MCAPP_CONTROL_T *);
+static void MCAPP_SRMControl(MCAPP_SRM_CONTROL_T *, MCAPP_CONTROL_T *, 
+                                                                    uint32_t);
 static void SRM_RunMotor(MCAPP_SRM_CONTROL_T *, uint32_t, uint32_t);
+static void SRM_PhaseCurrentControl(MCAPP_SRM_CONTROL_T *, uint32_t, float,
+                                                        void (*)(uint32_t));
+static void SRM_AutotuneGainsApply(MCAPP_SRM_CONTROL_T *);
+static void SRM_SpeedLoop(MCAPP_SRM_CONTROL_T *);
+static void SRM_PositionLoop(MCAPP_SRM_CONTROL_T *);
+static void SRM_HoldPhasePair(MCAPP_SRM_CONTROL_T *);
+static void SRM_PhaseSelect(MCAPP_SRM_CONTROL_T *, uint32_t, float *, 
+                                                        void (**)(uint32_t));
+static void SRM_RegenCurrentLimit(MCAPP_SRM_CONTROL_T *);
+static void SRM_VdcCompensation(MCAPP_SRM_CONTROL_T *);
+static void SRM_StallDetect(MCAPP_SRM_CONTROL_T *);
+static void SRM_StallUnjam(MCAPP_SRM_CONTROL_T *);
+static void SRM_LimpHomeCommutation(MCAPP_SRM_CONTROL_T *, MCAPP_CONTROL_T *,
+                                                                    uint32_t);
+static void SRM_DirectionReversal(MCAPP_SRM_CONTROL_T *);
+static float SRM_SectorProgress(MCAPP_SRM_CONTROL_T *, uint32_t);
+static void SRM_ChopModeSelect(MCAPP_SRM_CONTROL_T *);
+static void SRM_NoiseMetricUpdate(MCAPP_SRM_CONTROL_T *);
+static void SRM_BootstrapPrecharge(MCAPP_SRM_CONTROL_T *);
+static void SRM_BootstrapSchedule(MCAPP_SRM_CONTROL_T *, uint32_t);
 // </editor-fold>
 
 /**
@@ -75,6 +97,8 @@ static void SRM_RunMotor(MCAPP_SRM_CONTROL_T *, uint32_t, uint32_t);
 */
 void MCAPP_SRMControlInit(MCAPP_SRM_CONTROL_T *pSRM)
 {
+    uint32_t index;
+    
     pSRM->controlTheta              = 0;
     pSRM->controlThetaBuf           = 0;
     pSRM->warpTheta                 = 0;
@@ -83,7 +107,10 @@ void MCAPP_SRMControlInit(MCAPP_SRM_CONTROL_T *pSRM)
     pSRM->iabcd.c                   = 0;
     pSRM->iabcd.d                   = 0;
     pSRM->speed                     = 0;
+    pSRM->velocity                  = 0;
+    pSRM->position                  = 0;
     pSRM->speedRateCounter          = 0;
+    pSRM->controlDirection          = pSRM->runDirection;
     pSRM->theta                     = 0;
     pSRM->referenceCurrent          = 0;
     
@@ -92,6 +119,8 @@ void MCAPP_SRMControlInit(MCAPP_SRM_CONTROL_T *pSRM)
     pSRM->ctrlParam.controlInput    = 0;
     pSRM->ctrlParam.currentInput    = 0;
     pSRM->ctrlParam.speedInput      = 0;
+    pSRM->ctrlParam.speedTarget     = 0;
+    pSRM->ctrlParam.positionTarget  = 0;
     
     pSRM->hccInput.currentActual    = 0;
     pSRM->hccInput.currentReference = 0;
@@ -99,10 +128,63 @@ void MCAPP_SRMControlInit(MCAPP_SRM_CONTROL_T *pSRM)
     pSRM->hccInput.hccState.currentUpperLimit = 0;
     pSRM->hccOutput.out             = 0;
     
+    pSRM->hwHccPhase                = 0;
+    pSRM->hwHccReference            = 0;
+    pSRM->hwHccActive               = false;
+    
     pSRM->piSpeedInput.inMeasure    = 0;
     pSRM->piSpeedInput.inReference  = 0;
     pSRM->piSpeedInput.piState.integrator = 0;
+    pSRM->piSpeedInput.piState.derivative = 0;
+    pSRM->piSpeedInput.piState.measurePrev = 0;
+    pSRM->piSpeedInput.piState.referencePrev = 0;
     pSRM->piSpeedOutput.out = 0;
+    
+    MCAPP_AutotuneInit(&pSRM->autotune);
+    MCAPP_LoadObserverInit(&pSRM->loadObserver, pSRM->speed);
+    MCAPP_SpeedRampInit(&pSRM->speedRamp, pSRM->speed);
+    
+    pSRM->positionControl.profileReset  = 1;
+    pSRM->positionControl.holdActive    = 0;
+    pSRM->positionControl.error         = 0;
+    pSRM->positionControl.speedCommand  = 0;
+    pSRM->positionControl.hccOutput.out = 0;
+    
+    pSRM->regen.brakeStop   = 0;
+    pSRM->regen.generating  = 0;
+    pSRM->regen.currentLimit = 0;
+    
+    pSRM->flyingStart.counter = 0;
+    pSRM->flyingStart.active  = 0;
+    
+    pSRM->reversal.active = 0;
+    
+    pSRM->stall.counter     = 0;
+    pSRM->stall.detected    = 0;
+    pSRM->stall.unjamActive = 0;
+    pSRM->stall.unjamAttempt = 0;
+    pSRM->stall.unjamCounter = 0;
+    pSRM->stall.reverse     = 0;
+    
+    pSRM->vdcComp.derate    = 1.0f;
+    pSRM->vdcComp.advance   = 0;
+    pSRM->vdcComp.hccOffset = 0;
+    
+    MCAPP_NoiseShapingInit(&pSRM->noise, &pSRM->hccInput.hccState);
+    
+    pSRM->chopping.mode     = pSRM->chopping.modeDefault;
+    pSRM->chopping.offState = MC1_FREEWHEELING;
+    
+    /* State of bootstrap capacitors is not known at start */
+    pSRM->bootstrap.prechargeCounter = pSRM->bootstrap.prechargeCount;
+    pSRM->bootstrap.pulses = 0;
+    for(index = 0; index < 4; index++)
+    {
+        pSRM->bootstrap.age[index] = pSRM->bootstrap.refreshCount;
+        pSRM->bootstrap.chargeCounter[index] = 0;
+    }
+    
+    pSRM->currentDerate = 1.0f;
      
     pSRM->controlState = SRM_CONTROL; 
 }
@@ -132,6 +214,14 @@ void MCAPP_SRMStateMachine (MCAPP_SRM_CONTROL_T *pSRM)
             /* Inputs for control */
             MCAPP_GetControlInputs(pSRM);
             
+            if(pSRM->bootstrap.prechargeCounter > 0)
+            {
+                /* Bootstrap capacitors of all phases are charged before the
+                   first phase is magnetized */
+                SRM_BootstrapPrecharge(pSRM);
+                break;
+            }
+            
             if(pSRM->ctrlParam.speedLoop == 1)
             {
                 /* PI Speed control loop */
@@ -139,14 +229,7 @@ void MCAPP_SRMStateMachine (MCAPP_SRM_CONTROL_T *pSRM)
                 if( pSRM->speedRateCounter > pSRM->ctrlParam.speedRate )
                 {
                     pSRM->speedRateCounter = 0;
-
-                    /* PI control for current in Speed Loop */
-                    pSRM->piSpeedInput.inMeasure = pSRM->speed;
-                    pSRM->piSpeedInput.inReference = pSRM->ctrlParam.speedInput;
-                    MC_ControllerPIUpdate(&pSRM->piSpeedInput, 
-                            &pSRM->piSpeedInput.piState , &pSRM->piSpeedOutput);
-
-                    pSRM->referenceCurrent = pSRM->piSpeedOutput.out;
+                    SRM_SpeedLoop(pSRM);
                 }
                 else
                 {
@@ -156,12 +239,43 @@ void MCAPP_SRMStateMachine (MCAPP_SRM_CONTROL_T *pSRM)
             else
             {
                 /* Current Loop */
-                pSRM->referenceCurrent = pSRM->ctrlParam.currentInput;
+                pSRM->referenceCurrent = pSRM->ctrlParam.currentInput * 
+                                pSRM->currentDerate * pSRM->vdcComp.derate;
+            }
+            
+            if(pSRM->stall.unjamActive == 1)
+            {
+                /* Unjamming pulses replace the speed loop output */
+                SRM_StallUnjam(pSRM);
+            }
+            
+            /* Negative reference current brakes the motor by commutation 
+               of the opposite direction, within the DC bus voltage limit */
+            pSRM->regen.generating = 0;
+            if(pSRM->referenceCurrent < 0)
+            {
+                pSRM->regen.generating = 1;
+                if(pSRM->referenceCurrent < -pSRM->regen.currentLimit)
+                {
+                    pSRM->referenceCurrent = -pSRM->regen.currentLimit;
+                }
             }
             
+            SRM_ChopModeSelect(pSRM);
+            
             /* Run motor */
-            MCAPP_SRMControl(pSRM,pCtrlParam);
-            SRM_RunMotor(pSRM,pCtrlParam->phaseOn,pCtrlParam->cBootOn);
+            if(pSRM->positionControl.holdActive == 1)
+            {
+                SRM_HoldPhasePair(pSRM);
+            }
+            else
+            {
+                MCAPP_SRMControl(pSRM,pCtrlParam, pSRM->controlDirection ^ 
+                            pSRM->regen.generating ^ pSRM->stall.reverse);
+                SRM_RunMotor(pSRM,pCtrlParam->phaseOn,pCtrlParam->cBootOn);
+            }
+            
+            SRM_NoiseMetricUpdate(pSRM);
             break;
                  
         case SRM_FAULT:
@@ -175,6 +289,126 @@ void MCAPP_SRMStateMachine (MCAPP_SRM_CONTROL_T *pSRM)
     } /* End Of switch - case */
 }
 
+/**
+* <B> Function: void MCAPP_SRMCoastObserve (MCAPP_SRM_CONTROL_T *)  </B>
+*
+* @brief Updates the control inputs and the load torque observer while the 
+*        outputs are disabled, so that a coasting rotor can be restarted from
+*        its speed. Without motor current the observer estimates the load 
+*        torque from the coasting deceleration. The observer is held at the 
+*        measured speed until the speed estimate has settled.
+*
+* @param Pointer to the data structure containing control parameters.
+* @return none.
+* @example
+* <CODE> MCAPP_SRMCoastObserve(&pSRM); </CODE>
+*
+*/
+void MCAPP_SRMCoastObserve(MCAPP_SRM_CONTROL_T *pSRM)
+{
+    MCAPP_GetControlInputs(pSRM);
+    
+    if( pSRM->speedRateCounter > pSRM->ctrlParam.speedRate )
+    {
+        pSRM->speedRateCounter = 0;
+        if(pSRM->flyingStart.counter < pSRM->flyingStart.settleCount)
+        {
+            pSRM->flyingStart.counter++;
+            MCAPP_LoadObserverInit(&pSRM->loadObserver, pSRM->speed);
+        }
+        else
+        {
+            MCAPP_LoadObserverUpdate(&pSRM->loadObserver, 0, pSRM->speed);
+        }
+    }
+    else
+    {
+        pSRM->speedRateCounter++;
+    }
+}
+
+/**
+* <B> Function: bool MCAPP_SRMFlyingStartReady (MCAPP_SRM_CONTROL_T *)  </B>
+*
+* @brief Checks if the rotor is coasting in the run direction fast enough for
+*        flying start in speed control.
+*
+* @param Pointer to the data structure containing control parameters.
+* @return true if the motor is to be started by flying start.
+* @example
+* <CODE> MCAPP_SRMFlyingStartReady(&pSRM); </CODE>
+*
+*/
+bool MCAPP_SRMFlyingStartReady(MCAPP_SRM_CONTROL_T *pSRM)
+{
+    MCAPP_FLYING_START_T *pFlyingStart = &pSRM->flyingStart;
+    float velocity;
+    
+    if((pFlyingStart->enable == 0) || (pSRM->ctrlParam.speedLoop == 0) ||
+                                        (pSRM->ctrlParam.positionLoop == 1) ||
+                            (pFlyingStart->counter < pFlyingStart->settleCount))
+    {
+        return false;
+    }
+    
+    /* Velocity in run direction */
+    if(pSRM->runDirection == 0)
+    {
+        velocity = pSRM->velocity;
+    }
+    else
+    {
+        velocity = -pSRM->velocity;
+    }
+    
+    return (velocity >= pFlyingStart->minSpeed);
+}
+
+/**
+* <B> Function: void MCAPP_SRMFlyingStart (MCAPP_SRM_CONTROL_T *)  </B>
+*
+* @brief Loads the speed ramp with the measured speed and the speed PI 
+*        integrator with the load current estimated while coasting, for a 
+*        bumpless start of the coasting rotor.
+*
+* @param Pointer to the data structure containing control parameters.
+* @return none.
+* @example
+* <CODE> MCAPP_SRMFlyingStart(&pSRM); </CODE>
+*
+*/
+void MCAPP_SRMFlyingStart(MCAPP_SRM_CONTROL_T *pSRM)
+{
+    MCAPP_PISTATE_T *pPIState = &pSRM->piSpeedInput.piState;
+    
+    MCAPP_SpeedRampInit(&pSRM->speedRamp, pSRM->speed);
+    pSRM->ctrlParam.speedInput = pSRM->speed;
+    
+    if(pSRM->loadObserver.feedForwardEnable == 1)
+    {
+        /* Load current is added by the feed-forward */
+        pPIState->integrator = 0;
+    }
+    else
+    {
+        pPIState->integrator = pSRM->loadObserver.feedForwardCurrent;
+    }
+    if(pPIState->integrator > pSRM->speedLoopOutMax)
+    {
+        pPIState->integrator = pSRM->speedLoopOutMax;
+    }
+    else if(pPIState->integrator < pSRM->speedLoopOutMin)
+    {
+        pPIState->integrator = pSRM->speedLoopOutMin;
+    }
+    pPIState->measurePrev   = pSRM->speed;
+    pPIState->referencePrev = pSRM->speed;
+    pPIState->derivative    = 0;
+    
+    pSRM->referenceCurrent = pPIState->integrator;
+    pSRM->flyingStart.active = 1;
+}
+
 /**
 * <B> Function: void MCAPP_GetControlInputs (MCAPP_SRM_CONTROL_T *)  </B>
 *
@@ -194,17 +428,43 @@ static void MCAPP_GetControlInputs(MCAPP_SRM_CONTROL_T *pSRM)
     pSRM->iabcd.c = *(pSRM->pIc);
     pSRM->iabcd.d = *(pSRM->pId);
     pSRM->speed   = *(pSRM->pSpeed);
+    pSRM->velocity = *(pSRM->pVelocity);
+    pSRM->position = *(pSRM->pPosition);
+    pSRM->vdc      = *(pSRM->pVdc);
     pSRM->theta   = *(pSRM->pTheta);
     /* Theta buffer warp to control angle */
     pSRM->warpTheta = fmod( pSRM->theta , pSRM->ctrlParam.crtlTheta );
     
+    if(pSRM->ctrlParam.positionLoop == 0)
+    {
+        SRM_DirectionReversal(pSRM);
+    }
+    
     /* Selection of control input */
-    if(pSRM->ctrlParam.speedLoop == 1)
+    if(pSRM->ctrlParam.positionLoop == 1)
     {
-        /* Speed Input from control input for speed control */
-        pSRM->ctrlParam.speedInput = (float)pSRM->motor.minSpeed + 
+        /* Target position from control input for position control, direction
+           of commutation is selected by the position loop */
+        pSRM->ctrlParam.positionTarget = pSRM->positionControl.range * 
+                            (float)(pSRM->ctrlParam.controlInput / 4095.0);
+    }
+    else if(pSRM->ctrlParam.speedLoop == 1)
+    {
+        /* Target speed from control input for speed control */
+        pSRM->ctrlParam.speedTarget = (float)pSRM->motor.minSpeed + 
                 ((float)(pSRM->motor.maxSpeed - pSRM->motor.minSpeed)* 
                 (float)(pSRM->ctrlParam.controlInput / 4095.0));
+        if((pSRM->disabledPhases != 0) && 
+                    (pSRM->ctrlParam.speedTarget > pSRM->limpHome.speedMax))
+        {
+            /* Speed is derated while running with a failed phase */
+            pSRM->ctrlParam.speedTarget = pSRM->limpHome.speedMax;
+        }
+        if((pSRM->regen.brakeStop == 1) || (pSRM->reversal.active == 1))
+        {
+            /* Decelerate to stop */
+            pSRM->ctrlParam.speedTarget = 0;
+        }
     }
     else
     {
@@ -212,26 +472,40 @@ static void MCAPP_GetControlInputs(MCAPP_SRM_CONTROL_T *pSRM)
         pSRM->ctrlParam.currentInput = ((float)(pSRM->ctrlParam.controlInput * 
                 pSRM->maxCurrentRef) / 4095.0 );
     } 
+    
+    SRM_RegenCurrentLimit(pSRM);
+    SRM_VdcCompensation(pSRM);
 }
 
 /**
-* <B> Function: void MCAPP_SRMControl(MCAPP_SRM_CONTROL_T *, MCAPP_CONTROL_T *)  </B>
+* <B> Function: void MCAPP_SRMControl(MCAPP_SRM_CONTROL_T *, MCAPP_CONTROL_T *, uint32_t)  </B>
 *
 * @brief Executes Speed and Current Control Loops and performs actions
 *        associated with SRM control 
 *
 * @param Pointer to the data structure containing control parameters.
+* @param Direction of commutation, 0 = clockwise, 1 = counter clockwise.
 * @return none.
 * @example
-* <CODE> MCAPP_SRMControl(&pSRM, &pCtrlParam); </CODE>
+* <CODE> MCAPP_SRMControl(&pSRM, &pCtrlParam, direction); </CODE>
 *
 */
-void MCAPP_SRMControl(MCAPP_SRM_CONTROL_T *pSRM, MCAPP_CONTROL_T *pCtrlParam)
+void MCAPP_SRMControl(MCAPP_SRM_CONTROL_T *pSRM, MCAPP_CONTROL_T *pCtrlParam,
+                                                            uint32_t direction)
 {    
-    if(pSRM->runDirection == 0)
+    float advance = 0, progress;
+    
+    if(pSRM->regen.generating == 0)
+    {
+        /* Commutation angle correction for DC bus voltage in motoring */
+        advance = pSRM->vdcComp.advance;
+    }
+    
+    if(direction == 0)
     {
         /* Control theta buffer for offset correction */
-        pSRM->controlThetaBuf = pSRM->warpTheta + pSRM->ctrlParam.cwThetaOffset;
+        pSRM->controlThetaBuf = pSRM->warpTheta + pSRM->ctrlParam.cwThetaOffset +
+                                                                        advance;
         /* Control theta buffer warp to control angle */
         pSRM->controlTheta = fmod( pSRM->controlThetaBuf , 
                                                     pSRM->ctrlParam.crtlTheta );
@@ -260,7 +534,8 @@ void MCAPP_SRMControl(MCAPP_SRM_CONTROL_T *pSRM, MCAPP_CONTROL_T *pCtrlParam)
     else
     {
         /* Control theta buffer for offset correction */
-        pSRM->controlThetaBuf = pSRM->warpTheta + pSRM->ctrlParam.ccwThetaOffset;
+        pSRM->controlThetaBuf = pSRM->warpTheta + pSRM->ctrlParam.ccwThetaOffset +
+                                        pSRM->ctrlParam.crtlTheta - advance;
         /* Control theta buffer warp to control angle */
         pSRM->controlTheta = fmod( pSRM->controlThetaBuf , 
                                                     pSRM->ctrlParam.crtlTheta );
@@ -286,6 +561,38 @@ void MCAPP_SRMControl(MCAPP_SRM_CONTROL_T *pSRM, MCAPP_CONTROL_T *pCtrlParam)
             pCtrlParam->cBootOn = THETA_4_CBOOT_CCW;
         }
     }
+    
+    if(pSRM->disabledPhases != 0)
+    {
+        SRM_LimpHomeCommutation(pSRM, pCtrlParam, direction);
+    }
+    
+    /* Reference profile at turn-off in motoring and chopping strategy near 
+       turn-off, sectors are not known to the profile in limp-home */
+    pSRM->noise.profileScale = 1.0f;
+    if(pSRM->chopping.mode == MC1_CHOP_HARD)
+    {
+        pSRM->chopping.offState = MC1_DEMAGNETIZE;
+    }
+    else
+    {
+        pSRM->chopping.offState = MC1_FREEWHEELING;
+    }
+    if((pSRM->disabledPhases == 0) && ((pSRM->noise.softTurnOff == 1) || 
+                                    (pSRM->chopping.mode == MC1_CHOP_MIXED)))
+    {
+        progress = SRM_SectorProgress(pSRM, direction);
+        
+        if(pSRM->regen.generating == 0)
+        {
+            MCAPP_NoiseProfileUpdate(&pSRM->noise, progress);
+        }
+        if((pSRM->chopping.mode == MC1_CHOP_MIXED) && 
+                                    (progress >= pSRM->chopping.hardStart))
+        {
+            pSRM->chopping.offState = MC1_DEMAGNETIZE;
+        }
+    }
 }
 
 /**
@@ -301,6 +608,24 @@ void MCAPP_SRMControl(MCAPP_SRM_CONTROL_T *pSRM, MCAPP_CONTROL_T *pCtrlParam)
 */
 void SRM_RunMotor(MCAPP_SRM_CONTROL_T *pSRM, uint32_t phaseOn, uint32_t cBootOn)
 {   
+    void (*PhaseControl)(uint32_t);
+    float current;
+    
+    if((phaseOn != 0) && ((pSRM->disabledPhases & (1UL << (phaseOn - 1))) != 0))
+    {
+        /* Faulty phase is not excited in degraded mode, the motor runs on
+           the remaining phases */
+        pSRM->PhaseA_Control(MC1_DEMAGNETIZE);
+        pSRM->PhaseB_Control(MC1_DEMAGNETIZE);
+        pSRM->PhaseC_Control(MC1_DEMAGNETIZE);
+        pSRM->PhaseD_Control(MC1_DEMAGNETIZE);
+        pSRM->switchState = false;
+        phaseOn = 0;
+    }
+    
+    MCAPP_NoiseCommutationUpdate(&pSRM->noise, phaseOn, 
+                                                    &pSRM->hccInput.hccState);
+    
     /* Switch case for Inverter output */
     switch (phaseOn)
     {
@@ -310,19 +635,8 @@ void SRM_RunMotor(MCAPP_SRM_CONTROL_T *pSRM, uint32_t phaseOn, uint32_t cBootOn)
             pSRM->PhaseC_Control(MC1_DEMAGNETIZE);
             pSRM->PhaseB_Control(MC1_DEMAGNETIZE);
             /* Hysteresis Current Controller */
-            pSRM->hccInput.currentReference = pSRM->referenceCurrent;
-            pSRM->hccInput.currentActual    = pSRM->iabcd.a;
-            MCAPP_ControllerHysteresis(&pSRM->hccInput, &pSRM->hccInput.hccState, 
-                    &pSRM->hccOutput);
-            pSRM->switchState = pSRM->hccOutput.out;
-            if(pSRM->switchState == true)
-            {               
-                pSRM->PhaseA_Control(MC1_MAGNETIZE);
-            }
-            else
-            {
-                pSRM->PhaseA_Control(MC1_FREEWHEELING);
-            }
+            SRM_PhaseCurrentControl(pSRM, phaseOn, pSRM->iabcd.a, 
+                                                        pSRM->PhaseA_Control);
             break;
         case PHASEB_COMMUTATION:
             /* Demagnetize other phases */
@@ -330,19 +644,8 @@ void SRM_RunMotor(MCAPP_SRM_CONTROL_T *pSRM, uint32_t phaseOn, uint32_t cBootOn)
             pSRM->PhaseC_Control(MC1_DEMAGNETIZE);
             pSRM->PhaseA_Control(MC1_DEMAGNETIZE);
             /* Hysteresis Current Controller */
-            pSRM->hccInput.currentReference = pSRM->referenceCurrent;
-            pSRM->hccInput.currentActual    = pSRM->iabcd.b;
-            MCAPP_ControllerHysteresis(&pSRM->hccInput, &pSRM->hccInput.hccState, 
-                    &pSRM->hccOutput);
-            pSRM->switchState = pSRM->hccOutput.out;
-            if(pSRM->switchState == true)
-            {
-                pSRM->PhaseB_Control(MC1_MAGNETIZE);
-            }
-            else
-            {
-                pSRM->PhaseB_Control(MC1_FREEWHEELING);
-            }
+            SRM_PhaseCurrentControl(pSRM, phaseOn, pSRM->iabcd.b, 
+                                                        pSRM->PhaseB_Control);
         break;
         case PHASEC_COMMUTATION:
             /* Demagnetize other phases */
@@ -350,19 +653,8 @@ void SRM_RunMotor(MCAPP_SRM_CONTROL_T *pSRM, uint32_t phaseOn, uint32_t cBootOn)
             pSRM->PhaseB_Control(MC1_DEMAGNETIZE);
             pSRM->PhaseA_Control(MC1_DEMAGNETIZE);
             /* Hysteresis Current Controller */
-            pSRM->hccInput.currentReference = pSRM->referenceCurrent;
-            pSRM->hccInput.currentActual    = pSRM->iabcd.c;
-            MCAPP_ControllerHysteresis(&pSRM->hccInput, &pSRM->hccInput.hccState, 
-                    &pSRM->hccOutput);
-            pSRM->switchState = pSRM->hccOutput.out;
-            if(pSRM->switchState == true)
-            {
-                pSRM->PhaseC_Control(MC1_MAGNETIZE);
-            }
-            else
-            {
-                pSRM->PhaseC_Control(MC1_FREEWHEELING);
-            }
+            SRM_PhaseCurrentControl(pSRM, phaseOn, pSRM->iabcd.c, 
+                                                        pSRM->PhaseC_Control);
         break;
         case PHASED_COMMUTATION:
             /* Demagnetize other phases */
@@ -370,22 +662,32 @@ void SRM_RunMotor(MCAPP_SRM_CONTROL_T *pSRM, uint32_t phaseOn, uint32_t cBootOn)
             pSRM->PhaseB_Control(MC1_DEMAGNETIZE);
             pSRM->PhaseA_Control(MC1_DEMAGNETIZE);
             /* Hysteresis Current Controller */
-            pSRM->hccInput.currentReference = pSRM->referenceCurrent;
-            pSRM->hccInput.currentActual    = pSRM->iabcd.d;
-            MCAPP_ControllerHysteresis(&pSRM->hccInput, &pSRM->hccInput.hccState, 
-                    &pSRM->hccOutput);
-            pSRM->switchState = pSRM->hccOutput.out;
-            if(pSRM->switchState == true)
-            {
-                pSRM->PhaseD_Control(MC1_MAGNETIZE); 
-            }
-            else
-            {
-                pSRM->PhaseD_Control(MC1_FREEWHEELING);
-            }
+            SRM_PhaseCurrentControl(pSRM, phaseOn, pSRM->iabcd.d, 
+                                                        pSRM->PhaseD_Control);
         break;
     }
     
+    if(pSRM->noise.freewheelCounter > 0)
+    {
+        /* First stage of turn-off at zero voltage, the phase current decays
+           slowly before the negative DC bus voltage is applied */
+        pSRM->noise.freewheelCounter--;
+        if((pSRM->noise.phaseOff != phaseOn) && 
+                                        (pSRM->noise.phaseOff != cBootOn))
+        {
+            SRM_PhaseSelect(pSRM, pSRM->noise.phaseOff, &current, 
+                                                                &PhaseControl);
+            PhaseControl(MC1_FREEWHEELING);
+            pSRM->bootstrap.age[pSRM->noise.phaseOff - 1] = 0;
+        }
+    }
+    
+    if(pSRM->bootstrap.enable == 1)
+    {
+        SRM_BootstrapSchedule(pSRM, phaseOn);
+        return;
+    }
+    
     /* Switch case for Boot Strap capacitor charging */
     switch (cBootOn)
     {
@@ -407,4 +709,1004 @@ void SRM_RunMotor(MCAPP_SRM_CONTROL_T *pSRM, uint32_t phaseOn, uint32_t cBootOn)
     } 
 }
 
+/**
+* <B> Function: void SRM_PhaseCurrentControl(MCAPP_SRM_CONTROL_T *, uint32_t, float, void (*)(uint32_t))  </B>
+*
+* @brief Regulates the current of the active phase to the reference current.
+*        With HARDWARE_HCC the current limits are loaded to the comparator 
+*        DAC only on commutation or reference current change and the phase is
+*        chopped by hardware, else the phase is chopped by software HCC with
+*        the chopping strategy of the operating region.
+*
+* @param Pointer to the data structure containing control parameters.
+* @param Active phase.
+* @param Measured current of the active phase.
+* @param Function pointer for PWM control of the active phase.
+* @return none.
+* @example
+* <CODE> SRM_PhaseCurrentControl(&pSRM, phaseOn, pSRM->iabcd.a, pSRM->PhaseA_Control); </CODE>
+*
+*/
+static void SRM_PhaseCurrentControl(MCAPP_SRM_CONTROL_T *pSRM, uint32_t phaseOn,
+                            float currentActual, void (*PhaseControl)(uint32_t))
+{
+    /* Negative reference current is the braking current magnitude, shaped 
+       by the turn-off profile */
+    pSRM->hccInput.currentReference = fabsf(pSRM->referenceCurrent) * 
+                                                    pSRM->noise.profileScale;
+    pSRM->hccInput.currentActual    = currentActual;
+    
+#ifdef HARDWARE_HCC
+    if((phaseOn != pSRM->hwHccPhase) || 
+            (pSRM->hccInput.currentReference != pSRM->hwHccReference))
+    {
+        MCAPP_ControllerHysteresisLimits(&pSRM->hccInput, 
+                                                &pSRM->hccInput.hccState);
+        pSRM->hwHccPhase     = phaseOn;
+        pSRM->hwHccReference = pSRM->hccInput.currentReference;
+        pSRM->hwHccActive    = pSRM->HCC_ThresholdSet(phaseOn, 
+                                pSRM->hccInput.hccState.currentUpperLimit,
+                                pSRM->hccInput.hccState.currentLowerLimit);
+    }
+    
+    if(pSRM->hwHccActive == true)
+    {
+        /* Phase current is chopped by comparator */
+        PhaseControl(MC1_HW_CHOPPING);
+    }
+    else
+#endif
+    {
+        /* Current overshoots the upper limit by up to a sample of rise */
+        if(pSRM->vdcComp.hccOffset < (0.5f * pSRM->hccInput.currentReference))
+        {
+            pSRM->hccInput.currentReference -= pSRM->vdcComp.hccOffset;
+        }
+        else
+        {
+            pSRM->hccInput.currentReference *= 0.5f;
+        }
+        MCAPP_ControllerHysteresis(&pSRM->hccInput, &pSRM->hccInput.hccState, 
+                &pSRM->hccOutput);
+        pSRM->switchState = pSRM->hccOutput.out;
+        if(pSRM->switchState == true)
+        {               
+            PhaseControl(MC1_MAGNETIZE);
+        }
+        else
+        {
+            PhaseControl(pSRM->chopping.offState);
+            if(pSRM->chopping.offState == MC1_FREEWHEELING)
+            {
+                /* Low side is on, bootstrap capacitor is charged */
+                pSRM->bootstrap.age[phaseOn - 1] = 0;
+            }
+        }
+    }
+}
+
+/**
+* <B> Function: void SRM_AutotuneGainsApply(MCAPP_SRM_CONTROL_T *)  </B>
+*
+* @brief Writes the autotune gains to the speed PI controller. The integrator
+*        is preloaded with the identified friction current for a bumpless 
+*        transfer and gain scheduling is disabled to retain the tuned gains.
+*        The identified inertia is converted to kg.m^2 for the load observer.
+*
+* @param Pointer to the data structure containing control parameters.
+* @return none.
+* @example
+* <CODE> SRM_AutotuneGainsApply(&pSRM); </CODE>
+*
+*/
+static void SRM_AutotuneGainsApply(MCAPP_SRM_CONTROL_T *pSRM)
+{
+    MCAPP_PISTATE_T *pPIState = &pSRM->piSpeedInput.piState;
+    
+    pPIState->kp = pSRM->autotune.kp;
+    pPIState->ki = pSRM->autotune.ki;
+    pPIState->pGainTable = NULL;
+    
+    pPIState->integrator = pSRM->autotune.frictionCurrent;
+    if(pPIState->integrator > pPIState->outMax)
+    {
+        pPIState->integrator = pPIState->outMax;
+    }
+    else if(pPIState->integrator < pPIState->outMin)
+    {
+        pPIState->integrator = pPIState->outMin;
+    }
+    pPIState->measurePrev   = pSRM->speed;
+    pPIState->referencePrev = pSRM->ctrlParam.speedInput;
+    pPIState->derivative    = 0;
+    
+    pSRM->loadObserver.inertia = pSRM->loadObserver.torqueConstant * 
+                                pSRM->autotune.inertia / RPM_TO_RAD_PER_SEC;
+}
+
+/**
+* <B> Function: void SRM_SpeedLoop(MCAPP_SRM_CONTROL_T *)  </B>
+*
+* @brief Executes the speed loop - speed reference ramp, load torque observer, 
+*        autotune experiment or speed PI controller with load torque 
+*        feed-forward.
+*
+* @param Pointer to the data structure containing control parameters.
+* @return none.
+* @example
+* <CODE> SRM_SpeedLoop(&pSRM); </CODE>
+*
+*/
+static void SRM_SpeedLoop(MCAPP_SRM_CONTROL_T *pSRM)
+{
+    MCAPP_PISTATE_T *pPIState = &pSRM->piSpeedInput.piState;
+    float feedForward = 0;
+    
+    if(pSRM->ctrlParam.positionLoop == 1)
+    {
+        /* Position loop commands speed reference and direction */
+        SRM_PositionLoop(pSRM);
+        if(pSRM->positionControl.holdActive == 1)
+        {
+            /* Phase pair currents are set by holding mode */
+            pSRM->referenceCurrent = pSRM->positionControl.holdCurrent;
+            return;
+        }
+    }
+    else
+    {
+        /* Jerk limited ramp from target speed to speed reference */
+        pSRM->ctrlParam.speedInput = MCAPP_SpeedRampUpdate(&pSRM->speedRamp, 
+                                                pSRM->ctrlParam.speedTarget);
+    }
+    
+    /* Load torque estimate from reference current of previous execution */
+    MCAPP_LoadObserverUpdate(&pSRM->loadObserver, pSRM->referenceCurrent,
+                                                                pSRM->speed);
+    
+    if(pSRM->autotune.request == 1)
+    {
+        MCAPP_AutotuneStart(&pSRM->autotune);
+    }
+    
+    /* Relay currents are not derated, identification would be invalid with
+       limited currents, hence the experiment fails and the speed controller
+       applies the derated current */
+    if((pSRM->autotune.state == AUTOTUNE_RELAY) && 
+                    ((pSRM->currentDerate * pSRM->vdcComp.derate) < 1.0f))
+    {
+        pSRM->autotune.state = AUTOTUNE_FAILED;
+    }
 
+    if(pSRM->autotune.state == AUTOTUNE_RELAY)
+    {
+        /* Relay feedback experiment replaces speed controller */
+        pSRM->referenceCurrent = MCAPP_AutotuneStep(&pSRM->autotune, 
+                                                                pSRM->speed);
+        if(pSRM->autotune.state == AUTOTUNE_COMPLETE)
+        {
+            SRM_AutotuneGainsApply(pSRM);
+        }
+    }
+    else
+    {
+        if(pSRM->loadObserver.feedForwardEnable == 1)
+        {
+            feedForward = pSRM->loadObserver.feedForwardCurrent;
+            if(feedForward > pSRM->speedLoopOutMax)
+            {
+                feedForward = pSRM->speedLoopOutMax;
+            }
+            else if(feedForward < pSRM->speedLoopOutMin)
+            {
+                feedForward = pSRM->speedLoopOutMin;
+            }
+        }
+        
+        /* PI output limits leave room for the feed-forward current, with 
+           regenerative braking the PI output may go down to the braking 
+           current limit */
+        pPIState->outMax = (pSRM->speedLoopOutMax * pSRM->currentDerate * 
+                                        pSRM->vdcComp.derate) - feedForward;
+        if(pSRM->regen.enable == 1)
+        {
+            pPIState->outMin = -pSRM->regen.currentLimit - feedForward;
+        }
+        else
+        {
+            pPIState->outMin = pSRM->speedLoopOutMin - feedForward;
+        }
+        
+        /* PI control for current in Speed Loop */
+        if(pSRM->ctrlParam.positionLoop == 1)
+        {
+            /* Speed in the commanded direction, negative while the rotor 
+               moves opposite to it, so that full current brakes the rotor */
+            if(pSRM->controlDirection == 0)
+            {
+                pSRM->piSpeedInput.inMeasure = pSRM->velocity;
+            }
+            else
+            {
+                pSRM->piSpeedInput.inMeasure = -pSRM->velocity;
+            }
+        }
+        else
+        {
+            pSRM->piSpeedInput.inMeasure = pSRM->speed;
+        }
+        pSRM->piSpeedInput.inReference = pSRM->ctrlParam.speedInput;
+        pSRM->SpeedController(&pSRM->piSpeedInput, pPIState, 
+                                                        &pSRM->piSpeedOutput);
+
+        pSRM->referenceCurrent = pSRM->piSpeedOutput.out + feedForward;
+        
+        if(pSRM->ctrlParam.positionLoop == 0)
+        {
+            SRM_StallDetect(pSRM);
+        }
+    }
+}
+
+/**
+* <B> Function: void SRM_PositionLoop(MCAPP_SRM_CONTROL_T *)  </B>
+*
+* @brief Executes the position loop - trapezoidal profile to the target 
+*        position and proportional position controller with profile velocity
+*        feed-forward. The signed speed command selects the direction of 
+*        commutation and the speed reference. Holding mode is entered when the
+*        profile is complete and the rotor is within the hold window.
+*
+* @param Pointer to the data structure containing control parameters.
+* @return none.
+* @example
+* <CODE> SRM_PositionLoop(&pSRM); </CODE>
+*
+*/
+static void SRM_PositionLoop(MCAPP_SRM_CONTROL_T *pSRM)
+{
+    MCAPP_POSITION_CONTROL_T *pPosition = &pSRM->positionControl;
+    float profileVelocity;
+    
+    if(pPosition->profileReset == 1)
+    {
+        /* Start the profile from the first valid rotor position */
+        MCAPP_PositionProfileInit(&pPosition->profile, pSRM->position);
+        pPosition->profileReset = 0;
+    }
+    
+    profileVelocity = MCAPP_PositionProfileUpdate(&pPosition->profile, 
+                                            pSRM->ctrlParam.positionTarget);
+    
+    pPosition->error = pPosition->profile.position - pSRM->position;
+    pPosition->speedCommand = (profileVelocity / RPM_TO_RAD_PER_SEC) + 
+                                            (pPosition->kp * pPosition->error);
+    
+    if((pPosition->profile.complete == 1) && 
+                        (fabsf(pPosition->error) <= pPosition->holdWindow))
+    {
+        pPosition->holdActive = 1;
+    }
+    else if((pPosition->profile.complete == 0) || 
+                    (fabsf(pPosition->error) > (2.0f * pPosition->holdWindow)))
+    {
+        pPosition->holdActive = 0;
+    }
+    
+    if(pPosition->speedCommand >= 0)
+    {
+        pSRM->controlDirection = 0;
+        pSRM->ctrlParam.speedInput = pPosition->speedCommand;
+    }
+    else
+    {
+        pSRM->controlDirection = 1;
+        pSRM->ctrlParam.speedInput = -pPosition->speedCommand;
+    }
+    if(pSRM->ctrlParam.speedInput > pSRM->motor.maxSpeed)
+    {
+        pSRM->ctrlParam.speedInput = pSRM->motor.maxSpeed;
+    }
+}
+
+/**
+* <B> Function: void SRM_HoldPhasePair(MCAPP_SRM_CONTROL_T *)  </B>
+*
+* @brief Holds the rotor at standstill by energizing the phase producing 
+*        clockwise torque and the phase producing counter clockwise torque at
+*        the present rotor angle. The hold current is shifted between the 
+*        phases in proportion to the position error. The clockwise phase uses
+*        the phase current control, the counter clockwise phase is chopped by
+*        software HCC.
+*
+* @param Pointer to the data structure containing control parameters.
+* @return none.
+* @example
+* <CODE> SRM_HoldPhasePair(&pSRM); </CODE>
+*
+*/
+static void SRM_HoldPhasePair(MCAPP_SRM_CONTROL_T *pSRM)
+{
+    MCAPP_POSITION_CONTROL_T *pPosition = &pSRM->positionControl;
+    MCAPP_CONTROL_T *pCtrlParam = &pSRM->ctrlParam;
+    void (*PhaseControl)(uint32_t);
+    float current, split;
+    uint32_t phase;
+    
+    /* Phases producing torque in each direction at the rotor angle */
+    MCAPP_SRMControl(pSRM, pCtrlParam, 1);
+    pPosition->holdPhaseCcw = pCtrlParam->phaseOn;
+    MCAPP_SRMControl(pSRM, pCtrlParam, 0);
+    pPosition->holdPhaseCw = pCtrlParam->phaseOn;
+    pSRM->noise.profileScale = 1.0f;
+    
+    split = pPosition->holdGain * pPosition->error;
+    if(split > 1.0f)
+    {
+        split = 1.0f;
+    }
+    else if(split < -1.0f)
+    {
+        split = -1.0f;
+    }
+    
+    for(phase = PHASEA_COMMUTATION; phase <= PHASED_COMMUTATION; phase++)
+    {
+        if((phase != pPosition->holdPhaseCw) && 
+                                        (phase != pPosition->holdPhaseCcw))
+        {
+            SRM_PhaseSelect(pSRM, phase, &current, &PhaseControl);
+            if(phase == pCtrlParam->cBootOn)
+            {
+                PhaseControl(MC1_CHG_BOOTCAP);
+            }
+            else
+            {
+                PhaseControl(MC1_DEMAGNETIZE);
+            }
+        }
+    }
+    
+    if(pPosition->holdPhaseCw == pPosition->holdPhaseCcw)
+    {
+        pSRM->referenceCurrent = pPosition->holdCurrent;
+    }
+    else
+    {
+        pSRM->referenceCurrent = pPosition->holdCurrent * (1.0f + split);
+        
+        SRM_PhaseSelect(pSRM, pPosition->holdPhaseCcw, &current, 
+                                                                &PhaseControl);
+        pPosition->hccInput.currentReference = 
+                                pPosition->holdCurrent * (1.0f - split);
+        pPosition->hccInput.currentActual = current;
+        MCAPP_ControllerHysteresis(&pPosition->hccInput, 
+                            &pPosition->hccInput.hccState, &pPosition->hccOutput);
+        if(pPosition->hccOutput.out == true)
+        {
+            PhaseControl(MC1_MAGNETIZE);
+        }
+        else
+        {
+            PhaseControl(MC1_FREEWHEELING);
+        }
+    }
+    
+    SRM_PhaseSelect(pSRM, pPosition->holdPhaseCw, &current, &PhaseControl);
+    SRM_PhaseCurrentControl(pSRM, pPosition->holdPhaseCw, current, 
+                                                                PhaseControl);
+}
+
+/**
+* <B> Function: void SRM_PhaseSelect(MCAPP_SRM_CONTROL_T *, uint32_t, float *, void (**)(uint32_t))  </B>
+*
+* @brief Returns the measured current and PWM control function of a phase.
+*
+* @param Pointer to the data structure containing control parameters.
+* @param Phase MCAPP_SRM_PHASE_T.
+* @param Pointer to measured current of the phase.
+* @param Pointer to PWM control function of the phase.
+* @return none.
+* @example
+* <CODE> SRM_PhaseSelect(&pSRM, phase, &current, &PhaseControl); </CODE>
+*
+*/
+static void SRM_PhaseSelect(MCAPP_SRM_CONTROL_T *pSRM, uint32_t phase, 
+                        float *pCurrent, void (**pPhaseControl)(uint32_t))
+{
+    switch(phase)
+    {
+        case PHASEA_COMMUTATION:
+            *pCurrent = pSRM->iabcd.a;
+            *pPhaseControl = pSRM->PhaseA_Control;
+            break;
+        case PHASEB_COMMUTATION:
+            *pCurrent = pSRM->iabcd.b;
+            *pPhaseControl = pSRM->PhaseB_Control;
+            break;
+        case PHASEC_COMMUTATION:
+            *pCurrent = pSRM->iabcd.c;
+            *pPhaseControl = pSRM->PhaseC_Control;
+            break;
+        default:
+            *pCurrent = pSRM->iabcd.d;
+            *pPhaseControl = pSRM->PhaseD_Control;
+            break;
+    }
+}
+
+/**
+* <B> Function: void SRM_RegenCurrentLimit(MCAPP_SRM_CONTROL_T *)  </B>
+*
+* @brief Computes the braking current limit from the DC bus voltage. The limit
+*        is reduced linearly from the maximum braking current at vdcDerateStart 
+*        to zero at vdcLimit, so that the energy returned to the DC bus does
+*        not raise the voltage above the maximum operating voltage.
+*
+* @param Pointer to the data structure containing control parameters.
+* @return none.
+* @example
+* <CODE> SRM_RegenCurrentLimit(&pSRM); </CODE>
+*
+*/
+static void SRM_RegenCurrentLimit(MCAPP_SRM_CONTROL_T *pSRM)
+{
+    MCAPP_REGEN_T *pRegen = &pSRM->regen;
+    
+    if(pRegen->enable == 0)
+    {
+        pRegen->currentLimit = 0;
+    }
+    else if(pSRM->vdc <= pRegen->vdcDerateStart)
+    {
+        pRegen->currentLimit = pRegen->currentMax;
+    }
+    else if(pSRM->vdc >= pRegen->vdcLimit)
+    {
+        pRegen->currentLimit = 0;
+    }
+    else
+    {
+        pRegen->currentLimit = pRegen->currentMax * 
+                                    (pRegen->vdcLimit - pSRM->vdc) / 
+                                    (pRegen->vdcLimit - pRegen->vdcDerateStart);
+    }
+}
+
+/**
+* <B> Function: void SRM_DirectionReversal (MCAPP_SRM_CONTROL_T *)  </B>
+*
+* @brief Changes the commutation direction to the run direction. In speed 
+*        control with reversal enabled, the speed target is held at zero 
+*        until the speed is below the switch speed (with regenerative braking
+*        the rotor is braked), then the commutation direction is switched and
+*        the speed ramp restarts from zero to the speed target.
+*        Otherwise the commutation direction follows the run direction 
+*        immediately.
+*
+* @param Pointer to the data structure containing control parameters.
+* @return none.
+* @example
+* <CODE> SRM_DirectionReversal(&pSRM); </CODE>
+*
+*/
+static void SRM_DirectionReversal(MCAPP_SRM_CONTROL_T *pSRM)
+{
+    MCAPP_PISTATE_T *pPIState = &pSRM->piSpeedInput.piState;
+    
+    if(pSRM->controlDirection == pSRM->runDirection)
+    {
+        pSRM->reversal.active = 0;
+        return;
+    }
+    
+    if((pSRM->reversal.enable == 0) || (pSRM->ctrlParam.speedLoop == 0) ||
+                                (pSRM->speed <= pSRM->reversal.switchSpeed))
+    {
+        pSRM->controlDirection = pSRM->runDirection;
+        if(pSRM->reversal.active == 1)
+        {
+            /* Accelerate from zero speed in the new direction */
+            pSRM->reversal.active = 0;
+            MCAPP_SpeedRampInit(&pSRM->speedRamp, 0);
+            pSRM->ctrlParam.speedInput = 0;
+            pPIState->integrator    = 0;
+            pPIState->derivative    = 0;
+            pPIState->measurePrev   = pSRM->speed;
+            pPIState->referencePrev = 0;
+        }
+        return;
+    }
+    
+    if(pSRM->reversal.active == 0)
+    {
+        pSRM->reversal.active = 1;
+        if(pSRM->autotune.state == AUTOTUNE_RELAY)
+        {
+            /* Relay experiment is invalid once the speed target changes */
+            pSRM->autotune.state = AUTOTUNE_FAILED;
+        }
+    }
+}
+
+/**
+* <B> Function: void SRM_VdcCompensation(MCAPP_SRM_CONTROL_T *)  </B>
+*
+* @brief Function to derate the current limit as the DC bus voltage sags and
+*        to compensate the commutation angles and HCC reference for the DC bus
+*        voltage. Current builds up at turn-on in (unaligned inductance x 
+*        reference current / DC bus voltage), the angles are corrected by the
+*        change of this time from nominal DC bus voltage at present speed.
+*
+* @param Pointer to the data structure containing control parameters.
+* @return none.
+* @example
+* <CODE> SRM_VdcCompensation(&pSRM); </CODE>
+*
+*/
+static void SRM_VdcCompensation(MCAPP_SRM_CONTROL_T *pSRM)
+{
+    MCAPP_VDC_COMPENSATION_T *pComp = &pSRM->vdcComp;
+    float speedRad;
+    
+    if(pSRM->vdc >= pComp->derateStart)
+    {
+        pComp->derate = 1.0f;
+    }
+    else if(pSRM->vdc <= pComp->derateEnd)
+    {
+        pComp->derate = pComp->derateMin;
+    }
+    else
+    {
+        pComp->derate = pComp->derateMin + (1.0f - pComp->derateMin) * 
+                                    (pSRM->vdc - pComp->derateEnd) / 
+                                    (pComp->derateStart - pComp->derateEnd);
+    }
+    
+    if((pComp->enable == 0) || (pSRM->vdc <= pComp->derateEnd))
+    {
+        pComp->advance   = 0;
+        pComp->hccOffset = 0;
+        return;
+    }
+    
+    speedRad = fabsf(pSRM->speed) * (2.0f * M_PI / 60.0f);
+    pComp->advance = speedRad * pComp->inductanceUnaligned * 
+                            fabsf(pSRM->referenceCurrent) * 
+                            ((1.0f / pSRM->vdc) - (1.0f / pComp->vdcNominal));
+    if(pComp->advance > pComp->advanceMax)
+    {
+        pComp->advance = pComp->advanceMax;
+    }
+    else if(pComp->advance < -pComp->advanceMax)
+    {
+        pComp->advance = -pComp->advanceMax;
+    }
+    
+    pComp->hccOffset = 0.5f * pComp->chopDelayGain * pSRM->vdc;
+}
+
+/**
+* <B> Function: void SRM_StallDetect(MCAPP_SRM_CONTROL_T *)  </B>
+*
+* @brief Function to detect a locked rotor in speed control, to be called at
+*        the speed loop rate. Speed PI output at its upper limit while the 
+*        speed stays below stall speed for detectCount executions starts the
+*        unjamming routine, or reports the stall once the unjamming routines 
+*        are used up.
+*
+* @param Pointer to the data structure containing control parameters.
+* @return none.
+* @example
+* <CODE> SRM_StallDetect(&pSRM); </CODE>
+*
+*/
+static void SRM_StallDetect(MCAPP_SRM_CONTROL_T *pSRM)
+{
+    MCAPP_STALL_T *pStall = &pSRM->stall;
+    
+    if((pStall->enable == 0) || (pStall->unjamActive == 1))
+    {
+        return;
+    }
+    
+    if(pSRM->speed > pStall->speedMax)
+    {
+        /* Rotor is turning, a new stall starts the unjamming again */
+        pStall->counter = 0;
+        pStall->unjamAttempt = 0;
+        return;
+    }
+    if((pSRM->piSpeedOutput.out < pSRM->piSpeedInput.piState.outMax) ||
+        (pSRM->ctrlParam.speedInput <= pStall->speedMax) ||
+        (pSRM->regen.brakeStop == 1) || (pSRM->reversal.active == 1))
+    {
+        /* Speed loop is not saturated or stop is commanded */
+        pStall->counter = 0;
+        return;
+    }
+    
+    if(pStall->counter < pStall->detectCount)
+    {
+        pStall->counter++;
+        return;
+    }
+    pStall->counter = 0;
+    
+    if((pStall->unjamEnable == 1) && 
+                            (pStall->unjamAttempt < pStall->unjamAttempts))
+    {
+        pStall->unjamAttempt++;
+        pStall->unjamCounter = 0;
+        pStall->unjamActive = 1;
+    }
+    else
+    {
+        pStall->detected = 1;
+    }
+}
+
+/**
+* <B> Function: void SRM_StallUnjam(MCAPP_SRM_CONTROL_T *)  </B>
+*
+* @brief Function to execute the unjamming routine - pairs of a reverse and a
+*        forward current pulse, each of unjamPulseCount control loop 
+*        executions, to free the jammed shaft. Speed loop resumes after the 
+*        last pulse.
+*
+* @param Pointer to the data structure containing control parameters.
+* @return none.
+* @example
+* <CODE> SRM_StallUnjam(&pSRM); </CODE>
+*
+*/
+static void SRM_StallUnjam(MCAPP_SRM_CONTROL_T *pSRM)
+{
+    MCAPP_STALL_T *pStall = &pSRM->stall;
+    uint32_t pulse;
+    
+    pulse = pStall->unjamCounter / pStall->unjamPulseCount;
+    if(pulse >= (2 * pStall->unjamPulses))
+    {
+        pStall->unjamActive = 0;
+        pStall->reverse = 0;
+        return;
+    }
+    pStall->unjamCounter++;
+    
+    /* Even pulses are reverse, odd pulses are forward */
+    pStall->reverse = ((pulse & 1) == 0) ? 1 : 0;
+    pSRM->referenceCurrent = pStall->unjamCurrent * pSRM->currentDerate * 
+                                                        pSRM->vdcComp.derate;
+}
+
+/**
+* <B> Function: void SRM_LimpHomeCommutation(MCAPP_SRM_CONTROL_T *, 
+*                                       MCAPP_CONTROL_T *, uint32_t)  </B>
+*
+* @brief Function to remove a failed phase from the commutation sequence. 
+*        Sector of the failed phase is shared by its neighbours - conduction
+*        of the previous phase is extended for the overlap share of the 
+*        sector and the next phase is turned on early for the rest, so that
+*        torque is produced over the full revolution with three phases.
+*
+* @param Pointer to the data structure containing control parameters.
+* @param Pointer to the data structure containing commutation outputs.
+* @param Direction of commutation, 0 = clockwise, 1 = counter clockwise.
+* @return none.
+* @example
+* <CODE> SRM_LimpHomeCommutation(&pSRM, &pCtrlParam, direction); </CODE>
+*
+*/
+static void SRM_LimpHomeCommutation(MCAPP_SRM_CONTROL_T *pSRM, 
+                            MCAPP_CONTROL_T *pCtrlParam, uint32_t direction)
+{
+    static const uint32_t cwSequence[4] = {THETA_1_COMMUTATE_CW,
+            THETA_2_COMMUTATE_CW, THETA_3_COMMUTATE_CW, THETA_4_COMMUTATE_CW};
+    static const uint32_t ccwSequence[4] = {THETA_1_COMMUTATE_CCW,
+            THETA_2_COMMUTATE_CCW, THETA_3_COMMUTATE_CCW, THETA_4_COMMUTATE_CCW};
+    const uint32_t *pSequence;
+    float bound[5], progress;
+    uint32_t sector, phaseOn;
+    
+    if((pSRM->disabledPhases & (1UL << (pCtrlParam->phaseOn - 1))) == 0)
+    {
+        return;
+    }
+    
+    /* Sector boundaries in the direction of rotation */
+    if(direction == 0)
+    {
+        pSequence = cwSequence;
+        bound[0] = 0;
+        bound[1] = pSRM->ctrlParam.cwTheta1Commutation;
+        bound[2] = pSRM->ctrlParam.cwTheta2Commutation;
+        bound[3] = pSRM->ctrlParam.cwTheta3Commutation;
+        bound[4] = pSRM->ctrlParam.crtlTheta;
+    }
+    else
+    {
+        pSequence = ccwSequence;
+        bound[0] = pSRM->ctrlParam.crtlTheta;
+        bound[1] = pSRM->ctrlParam.ccwTheta1Commutation;
+        bound[2] = pSRM->ctrlParam.ccwTheta2Commutation;
+        bound[3] = pSRM->ctrlParam.ccwTheta3Commutation;
+        bound[4] = 0;
+    }
+    
+    for(sector = 0; sector < 4; sector++)
+    {
+        if(pSequence[sector] == pCtrlParam->phaseOn)
+        {
+            break;
+        }
+    }
+    if((sector >= 4) || (bound[sector + 1] == bound[sector]))
+    {
+        return;
+    }
+    
+    progress = (pSRM->controlTheta - bound[sector]) / 
+                                        (bound[sector + 1] - bound[sector]);
+    if(progress < pSRM->limpHome.overlap)
+    {
+        phaseOn = pSequence[(sector + 3) % 4];
+    }
+    else
+    {
+        phaseOn = pSequence[(sector + 1) % 4];
+    }
+    
+    if((pSRM->disabledPhases & (1UL << (phaseOn - 1))) != 0)
+    {
+        /* Both neighbours failed, sector is left without torque */
+        return;
+    }
+    pCtrlParam->phaseOn = phaseOn;
+    if(pCtrlParam->cBootOn == phaseOn)
+    {
+        /* Bootstrap capacitor of the conducting phase is not charged */
+        pCtrlParam->cBootOn = 0;
+    }
+}
+
+/**
+* <B> Function: float SRM_SectorProgress(MCAPP_SRM_CONTROL_T *, uint32_t)  </B>
+*
+* @brief Function to compute the share of the commutation sector of the active
+*        phase passed by the rotor, 0 at turn-on and 1 at turn-off.
+*
+* @param Pointer to the data structure containing control parameters.
+* @param Direction of commutation, 0 = clockwise, 1 = counter clockwise.
+* @return Progress in the sector 0 - 1.
+* @example
+* <CODE> SRM_SectorProgress(&pSRM, direction); </CODE>
+*
+*/
+static float SRM_SectorProgress(MCAPP_SRM_CONTROL_T *pSRM, uint32_t direction)
+{
+    float bound[5], progress;
+    uint32_t sector;
+    
+    /* Sector boundaries in the direction of rotation */
+    if(direction == 0)
+    {
+        bound[0] = 0;
+        bound[1] = pSRM->ctrlParam.cwTheta1Commutation;
+        bound[2] = pSRM->ctrlParam.cwTheta2Commutation;
+        bound[3] = pSRM->ctrlParam.cwTheta3Commutation;
+        bound[4] = pSRM->ctrlParam.crtlTheta;
+        for(sector = 0; sector < 3; sector++)
+        {
+            if(pSRM->controlTheta <= bound[sector + 1])
+            {
+                break;
+            }
+        }
+    }
+    else
+    {
+        bound[0] = pSRM->ctrlParam.crtlTheta;
+        bound[1] = pSRM->ctrlParam.ccwTheta1Commutation;
+        bound[2] = pSRM->ctrlParam.ccwTheta2Commutation;
+        bound[3] = pSRM->ctrlParam.ccwTheta3Commutation;
+        bound[4] = 0;
+        for(sector = 0; sector < 3; sector++)
+        {
+            if(pSRM->controlTheta >= bound[sector + 1])
+            {
+                break;
+            }
+        }
+    }
+    
+    if(bound[sector + 1] == bound[sector])
+    {
+        return 0;
+    }
+    
+    progress = (pSRM->controlTheta - bound[sector]) / 
+                                        (bound[sector + 1] - bound[sector]);
+    if(progress > 1.0f)
+    {
+        progress = 1.0f;
+    }
+    
+    return progress;
+}
+
+/**
+* <B> Function: void SRM_ChopModeSelect(MCAPP_SRM_CONTROL_T *)  </B>
+*
+* @brief Function to select the chopping strategy of software HCC from the
+*        speed and reference current region table. Hard chopping gives fast
+*        current fall, soft chopping lower switching loss and current ripple.
+*
+* @param Pointer to the data structure containing control parameters.
+* @return none.
+* @example
+* <CODE> SRM_ChopModeSelect(&pSRM); </CODE>
+*
+*/
+static void SRM_ChopModeSelect(MCAPP_SRM_CONTROL_T *pSRM)
+{
+    MCAPP_CHOPPING_T *pChopping = &pSRM->chopping;
+    const MCAPP_CHOP_REGION_T *pRegion;
+    float current = fabsf(pSRM->referenceCurrent);
+    uint32_t index;
+    
+    pChopping->mode = pChopping->modeDefault;
+    if(pChopping->pTable == NULL)
+    {
+        return;
+    }
+    
+    for(index = 0; index < pChopping->tableSize; index++)
+    {
+        pRegion = &pChopping->pTable[index];
+        if((pSRM->speed <= pRegion->speedMax) && 
+                                            (current <= pRegion->currentMax))
+        {
+            pChopping->mode = pRegion->mode;
+            break;
+        }
+    }
+}
+
+/**
+* <B> Function: void SRM_NoiseMetricUpdate(MCAPP_SRM_CONTROL_T *)  </B>
+*
+* @brief Function to update the radial force proxy for acoustic noise with
+*        the measured current of the phase turned off.
+*
+* @param Pointer to the data structure containing control parameters.
+* @return none.
+* @example
+* <CODE> SRM_NoiseMetricUpdate(&pSRM); </CODE>
+*
+*/
+static void SRM_NoiseMetricUpdate(MCAPP_SRM_CONTROL_T *pSRM)
+{
+    float current = 0;
+    
+    switch(pSRM->noise.phaseOff)
+    {
+    case PHASEA_COMMUTATION:
+        current = pSRM->iabcd.a;
+        break;
+    case PHASEB_COMMUTATION:
+        current = pSRM->iabcd.b;
+        break;
+    case PHASEC_COMMUTATION:
+        current = pSRM->iabcd.c;
+        break;
+    case PHASED_COMMUTATION:
+        current = pSRM->iabcd.d;
+        break;
+    default:
+        break;
+    }
+    MCAPP_NoiseMetricUpdate(&pSRM->noise, current);
+}
+
+/**
+* <B> Function: void SRM_BootstrapPrecharge(MCAPP_SRM_CONTROL_T *)  </B>
+*
+* @brief Function to charge the bootstrap capacitors of all phases at start.
+*        Only the low side switches are on, no current flows in the phases.
+*
+* @param Pointer to the data structure containing control parameters.
+* @return none.
+* @example
+* <CODE> SRM_BootstrapPrecharge(&pSRM); </CODE>
+*
+*/
+static void SRM_BootstrapPrecharge(MCAPP_SRM_CONTROL_T *pSRM)
+{
+    MCAPP_BOOTSTRAP_T *pBoot = &pSRM->bootstrap;
+    void (*PhaseControl)(uint32_t);
+    float current;
+    uint32_t phase;
+    
+    pBoot->prechargeCounter--;
+    for(phase = PHASEA_COMMUTATION; phase <= PHASED_COMMUTATION; phase++)
+    {
+        SRM_PhaseSelect(pSRM, phase, &current, &PhaseControl);
+        if((pSRM->disabledPhases & (1UL << (phase - 1))) != 0)
+        {
+            PhaseControl(MC1_DEMAGNETIZE);
+        }
+        else
+        {
+            PhaseControl(MC1_CHG_BOOTCAP);
+            if(pBoot->prechargeCounter == 0)
+            {
+                pBoot->age[phase - 1] = 0;
+            }
+        }
+    }
+}
+
+/**
+* <B> Function: void SRM_BootstrapSchedule(MCAPP_SRM_CONTROL_T *, uint32_t)  </B>
+*
+* @brief Function to charge bootstrap capacitors only when needed. Time since
+*        the low side switch of each phase was on is tracked, chopping by 
+*        freewheeling charges the capacitor of the active phase. A phase whose
+*        low side was off for refreshCount executions is charged for 
+*        chargeCount executions, when it is not active and its current has 
+*        decayed below idleCurrent, so that charging does not slow down the
+*        demagnetization of the phase.
+*
+* @param Pointer to the data structure containing control parameters.
+* @param Active phase.
+* @return none.
+* @example
+* <CODE> SRM_BootstrapSchedule(&pSRM, phaseOn); </CODE>
+*
+*/
+static void SRM_BootstrapSchedule(MCAPP_SRM_CONTROL_T *pSRM, uint32_t phaseOn)
+{
+    MCAPP_BOOTSTRAP_T *pBoot = &pSRM->bootstrap;
+    void (*PhaseControl)(uint32_t);
+    float current;
+    uint32_t phase, index;
+    
+    for(phase = PHASEA_COMMUTATION; phase <= PHASED_COMMUTATION; phase++)
+    {
+        index = phase - 1;
+        if(pBoot->age[index] < pBoot->refreshCount)
+        {
+            pBoot->age[index]++;
+        }
+        
+        if((phase == phaseOn) || 
+                    ((pSRM->disabledPhases & (1UL << index)) != 0) ||
+                    ((pSRM->noise.freewheelCounter > 0) && 
+                                            (phase == pSRM->noise.phaseOff)))
+        {
+            pBoot->chargeCounter[index] = 0;
+            continue;
+        }
+        
+        SRM_PhaseSelect(pSRM, phase, &current, &PhaseControl);
+        if((pBoot->chargeCounter[index] == 0) && 
+                (pBoot->age[index] >= pBoot->refreshCount) &&
+                                        (fabsf(current) < pBoot->idleCurrent))
+        {
+            pBoot->chargeCounter[index] = pBoot->chargeCount;
+            pBoot->pulses++;
+        }
+        
+        if(pBoot->chargeCounter[index] > 0)
+        {
+            PhaseControl(MC1_CHG_BOOTCAP);
+            pBoot->chargeCounter[index]--;
+            if(pBoot->chargeCounter[index] == 0)
+            {
+                pBoot->age[index] = 0;
+            }
+        }
+    }
+}
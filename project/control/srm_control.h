@@ -68,6 +68,9 @@ extern "C" {
 
 void MCAPP_SRMControlInit(MCAPP_CONTROL_SCHEME_T *);
 void MCAPP_SRMStateMachine (MCAPP_CONTROL_SCHEME_T *);
+void MCAPP_SRMCoastObserve(MCAPP_CONTROL_SCHEME_T *);
+bool MCAPP_SRMFlyingStartReady(MCAPP_CONTROL_SCHEME_T *);
+void MCAPP_SRMFlyingStart(MCAPP_CONTROL_SCHEME_T *);
    
 // </editor-fold>
 
@@ -78,6 +78,8 @@ typedef struct
         ccwTheta3Commutation,
         ccwTheta4Commutation, 
             
+        speedTarget,        /* Target speed from control input */
+        positionTarget,     /* Target position (rad) from control input */
         speedInput,         /* Input for speed control loop */
         currentInput,       /* Input for current control loop */
         controlInput;       /* User input for control  */
@@ -86,6 +88,7 @@ typedef struct
         phaseOn,            /* Variable for phase On */
         cBootOn,            /* Variable for CBoot On */
         speedLoop,          /* Variable for control loop */
+        positionLoop,       /* 1 = position loop cascaded with speed loop */
         speedRate;          /* Variable for rate of execution of speed loop */
     
 } MCAPP_CONTROL_T;
@@ -61,6 +61,10 @@ extern "C" {
 #include "motor_params.h"
 #include "hcc.h"
 #include "pi.h"
+#include "autotune.h"
+#include "load_observer.h"
+#include "trajectory.h"
+#include "noise_shaping.h"
 // </editor-fold>
 
 // <editor-fold defaultstate="expanded" desc="ENUMERATED CONSTANTS ">
@@ -78,21 +82,173 @@ typedef enum
     MC1_MAGNETIZE    = 1,       /* Magnetize   the phase current by turning on  both the switches */
     MC1_FREEWHEELING = 2,       /* Freewheeling the phase current by turning on only the lower switch */
     MC1_CHG_BOOTCAP  = 3,       /* Charge the Bootstrap Capacitor */
+    MC1_HW_CHOPPING  = 4,       /* Phase current chopped by comparator and feed-forward PCI */
             
 }MCAPP_SRM_PHASE_CRTL_T;
+
+typedef enum
+{
+    MC1_CHOP_SOFT    = 0,       /* Chopping between magnetizing and freewheeling */
+    MC1_CHOP_HARD    = 1,       /* Chopping between magnetizing and demagnetizing */
+    MC1_CHOP_MIXED   = 2,       /* Soft chopping, hard chopping near turn-off */
+}MCAPP_CHOP_MODE_T;
 // </editor-fold>
 
 // <editor-fold defaultstate="collapsed" desc="VARIABLE TYPE DEFINITIONS ">
 
+typedef struct
+{
+    uint32_t
+        enable,             /* 1 = negative reference current brakes the motor */
+        brakeStop,          /* 1 = speed target is forced to zero for stop */
+        generating;         /* 1 = phases are excited in generating mode */
+    float
+        currentMax,         /* Maximum braking current (A) */
+        vdcDerateStart,     /* DC bus voltage to start derating (V) */
+        vdcLimit,           /* DC bus voltage at zero braking current (V) */
+        currentLimit;       /* Braking current limit at present DC bus voltage */
+} MCAPP_REGEN_T;
+
+typedef struct
+{
+    uint32_t
+        enable,             /* 1 = locked rotor in speed control is detected */
+        unjamEnable,        /* 1 = unjamming is tried before the stall fault */
+        counter,            /* Speed loop executions with locked rotor */
+        detectCount,        /* Speed loop executions to detect the stall */
+        detected,           /* 1 = stall fault to be reported */
+        unjamActive,        /* 1 = unjamming pulses replace the speed loop */
+        unjamAttempts,      /* Unjamming routines allowed in a stall */
+        unjamAttempt,       /* Unjamming routines done in the present stall */
+        unjamPulses,        /* Reverse and forward pulse pairs in a routine */
+        unjamPulseCount,    /* Control loop executions of a pulse */
+        unjamCounter,       /* Control loop executions of present routine */
+        reverse;            /* 1 = commutation opposite to control direction */
+    float
+        speedMax,           /* Speed below which the rotor is locked (RPM) */
+        unjamCurrent;       /* Reference current of unjamming pulses (A) */
+} MCAPP_STALL_T;
+
+typedef struct
+{
+    float
+        overlap,            /* Share of failed phase sector given to previous phase */
+        speedMax;           /* Speed target limit with a failed phase (RPM) */
+} MCAPP_LIMP_HOME_T;
+
+
+typedef struct
+{
+    float
+        speedMax,           /* Region applies up to this speed (RPM) */
+        currentMax;         /* Region applies up to this reference current (A) */
+    uint32_t
+        mode;               /* Chopping strategy MCAPP_CHOP_MODE_T */
+} MCAPP_CHOP_REGION_T;
+
+typedef struct
+{
+    uint32_t
+        mode,               /* Chopping strategy of present region */
+        modeDefault,        /* Strategy outside the regions of the table */
+        offState,           /* Phase output when the current is above the band */
+        tableSize;          /* Number of regions in the table */
+    float
+        hardStart;          /* Share of sector from which mixed chopping is hard */
+    /* Regions checked in order, first match selects the strategy, NULL if 
+       not used */
+    const MCAPP_CHOP_REGION_T *pTable;
+} MCAPP_CHOPPING_T;
+
+typedef struct
+{
+    uint32_t
+        enable,             /* 1 = bootstrap capacitors charged when needed */
+        prechargeCount,     /* Control loop executions charging all phases at start */
+        prechargeCounter,   /* Remaining executions of precharge */
+        refreshCount,       /* Executions without low side on before charging */
+        chargeCount,        /* Control loop executions of a charging pulse */
+        age[4],             /* Executions since low side of each phase was on */
+        chargeCounter[4],   /* Remaining executions of charging pulse of each phase */
+        pulses;             /* Charging pulses since start */
+    float
+        idleCurrent;        /* Current below which a phase is charged (A) */
+} MCAPP_BOOTSTRAP_T;
+
+typedef struct
+{
+    uint32_t
+        enable;             /* 1 = angles and reference compensated for DC bus */
+    float
+        derateStart,        /* DC bus voltage to start derating (V) */
+        derateEnd,          /* DC bus voltage at minimum current limit (V) */
+        derateMin,          /* Current limit scale at derateEnd */
+        derate,             /* Current limit scale at present DC bus voltage */
+        vdcNominal,         /* DC bus voltage the commutation angles are set for (V) */
+        inductanceUnaligned,/* Phase inductance at turn-on (H) */
+        chopDelayGain,      /* Current rise in a sample per DC bus volt (A/V) */
+        advanceMax,         /* Limit of commutation angle correction (rad) */
+        advance,            /* Commutation angle correction, positive advances (rad) */
+        hccOffset;          /* Reference reduction for sampling delay of HCC (A) */
+} MCAPP_VDC_COMPENSATION_T;
+
+typedef struct
+{
+    uint32_t
+        enable,             /* 1 = start a coasting rotor from measured speed */
+        settleCount,        /* Speed loop executions for speed estimate to settle */
+        counter,            /* Speed loop executions since stop */
+        active;             /* 1 = present run was started as flying start */
+    float
+        minSpeed;           /* Minimum speed in run direction (RPM) */
+} MCAPP_FLYING_START_T;
+
+typedef struct
+{
+    uint32_t
+        enable,             /* 1 = direction is reversed while running */
+        active;             /* 1 = decelerating to switch commutation direction */
+    float
+        switchSpeed;        /* Speed to switch commutation direction (RPM) */
+} MCAPP_REVERSAL_T;
+
+typedef struct
+{
+    uint32_t
+        profileReset,       /* 1 = start profile from measured position */
+        holdActive,         /* 1 = rotor is held by the phase pair */
+        holdPhaseCw,        /* Phase producing clockwise torque in hold */
+        holdPhaseCcw;       /* Phase producing counter clockwise torque in hold */
+    float
+        kp,                 /* Proportional gain (RPM/rad) */
+        error,              /* Profile position - measured position (rad) */
+        speedCommand,       /* Signed speed command to speed loop (RPM) */
+        holdWindow,         /* Position error to enter holding mode (rad) */
+        holdCurrent,        /* Current of each phase at zero error (A) */
+        holdGain,           /* Current shift per position error (1/rad) */
+        range;              /* Position range of control input 0 - 4095 (rad) */
+    
+    MCAPP_POSITION_PROFILE_T
+        profile;            /* Trapezoidal position profile */
+    
+    /* HCC for the counter clockwise phase in hold */
+    MCAPP_HCCPARMIN_T hccInput;
+    MCAPP_HCCPARMOUT_T hccOutput;
+} MCAPP_POSITION_CONTROL_T;
+
 typedef struct
 {
     uint32_t
         faultStatus,        /* Fault Status */
         runDirection,       /* Variable for motor run direction */
         controlState,       /* State variable for control state machine */
-        speedRateCounter;   /* Index counter for PI speed loop */
+        controlDirection,   /* Direction of commutation */
+        speedRateCounter,   /* Index counter for PI speed loop */
+        hwHccPhase,         /* Phase whose current limits are loaded to comparator DAC */
+        disabledPhases;     /* Bit per phase kept demagnetized, phase A = bit 0 */
     bool
-        switchState;        /* Variable for switch ON or OFF */
+        switchState,        /* Variable for switch ON or OFF */
+        hwHccActive;        /* Active phase is chopped by comparator */
     float
         *pIa,               /* Pointer for Ia */
         *pIb,               /* Pointer for Ib */
@@ -100,13 +256,22 @@ typedef struct
         *pId,               /* Pointer for Id */
         *pSpeed,            /* Pointer for Speed */
         speed,              /* variable for speed */
+        *pVelocity,         /* Pointer for signed speed */
+        velocity,           /* Signed speed, positive in clockwise direction */
+        *pPosition,         /* Pointer for multi-turn position */
+        position,           /* Multi-turn position (rad) */
+        *pVdc,              /* Pointer for DC bus voltage */
+        vdc,                /* DC bus voltage (V) */
         referenceCurrent,   /* Reference current for control */
         theta,              /* theta mechanical 0 to 2pi*/        
         *pTheta,            /* Pointer for theta */
         warpTheta,          /* variable for warp theta */
         controlTheta,       /* warp theta used for control */
         controlThetaBuf,    /* Buffer variable for theta used for offset correction */
-        maxCurrentRef;      /* Maximum current reference limit for current control */
+        maxCurrentRef,      /* Maximum current reference limit for current control */
+        speedLoopOutMax,    /* Maximum reference current from speed loop */
+        speedLoopOutMin,    /* Minimum reference current from speed loop */
+        hwHccReference;     /* Reference current loaded to comparator DAC */
     
     /* Parameters for HCC control */
     MCAPP_HCCPARMIN_T hccInput;
@@ -116,6 +281,48 @@ typedef struct
     MC_PIPARMIN_T   piSpeedInput;
     MC_PIPARMOUT_T  piSpeedOutput;
     
+    /* Parameters for speed reference ramp */
+    MCAPP_SPEED_RAMP_T speedRamp;
+    
+    /* Parameters for load torque observer */
+    MCAPP_LOAD_OBSERVER_T loadObserver;
+    
+    /* Parameters for speed loop autotune */
+    MCAPP_AUTOTUNE_T autotune;
+    
+    /* Parameters for position control */
+    MCAPP_POSITION_CONTROL_T positionControl;
+    
+    /* Parameters for regenerative braking */
+    MCAPP_REGEN_T regen;
+    
+    /* Parameters for flying start */
+    MCAPP_FLYING_START_T flyingStart;
+    
+    /* Parameters for direction reversal while running */
+    MCAPP_REVERSAL_T reversal;
+    
+    /* Parameters for stall detection and unjamming */
+    MCAPP_STALL_T stall;
+    
+    /* Parameters for operation with a failed phase */
+    MCAPP_LIMP_HOME_T limpHome;
+    
+    /* Parameters for acoustic noise reduction */
+    MCAPP_NOISE_SHAPING_T noise;
+    
+    /* Parameters for selection of chopping strategy */
+    MCAPP_CHOPPING_T chopping;
+    
+    /* Parameters for bootstrap capacitor charging */
+    MCAPP_BOOTSTRAP_T bootstrap;
+    
+    /* Parameters for DC bus voltage derating and compensation */
+    MCAPP_VDC_COMPENSATION_T vdcComp;
+    
+    /* Scale of current limits, reduced by fault and thermal derating */
+    float currentDerate;
+    
     MC_ABCD_T
         iabcd,              /* Iabcd */
         vabcd;              /* Vabcd */
@@ -132,6 +339,13 @@ typedef struct
     void (*PhaseC_Control) (uint32_t);
     void (*PhaseD_Control) (uint32_t);
     
+    /* Function pointer for speed controller */
+    void (*SpeedController) (MC_PIPARMIN_T *, MCAPP_PISTATE_T *, 
+                                                            MC_PIPARMOUT_T *);
+    
+    /* Function pointer to load current limits to comparator DAC */
+    bool (*HCC_ThresholdSet) (uint32_t, float, float);
+    
 }MCAPP_SRM_CONTROL_T;
 
 // </editor-fold>
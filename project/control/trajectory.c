@@ -0,0 +1,255 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file trajectory.c
+ *
+ * @brief This module implements the trajectory generator.
+ *
+ * The speed ramp is an S-curve - the acceleration changes at the jerk limit
+ * and is bounded by the acceleration limit. The acceleration is reduced in
+ * time so that it reaches zero as the output reaches the target speed.
+ *
+ * The position profile is trapezoidal - the velocity changes at the 
+ * acceleration limit and is bounded by the velocity limit. Deceleration 
+ * starts when the distance to the target equals the braking distance, the 
+ * target may be changed while the profile is in motion.
+ *
+ * Component: TRAJECTORY
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <stdint.h>
+#include "math.h"
+#include "trajectory.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+
+/**
+* <B> Function: MCAPP_SpeedRampInit(MCAPP_SPEED_RAMP_T *, float)  </B>
+*
+* @brief Function to initialize the ramp output with zero acceleration.
+*
+* @param Pointer to the data structure containing ramp parameters.
+* @param Initial output speed (RPM).
+* @return none.
+*
+* @example
+* <CODE> MCAPP_SpeedRampInit(&speedRamp, speed); </CODE>
+*
+*/
+void MCAPP_SpeedRampInit(MCAPP_SPEED_RAMP_T *pRamp, float speed)
+{
+    pRamp->output = speed;
+    pRamp->accel = 0;
+}
+
+/**
+* <B> Function: MCAPP_SpeedRampUpdate(MCAPP_SPEED_RAMP_T *, float)  </B>
+*
+* @brief Function to move the ramp output towards the target speed, to be 
+*        called at the speed loop rate.
+*
+* @param Pointer to the data structure containing ramp parameters.
+* @param Target speed (RPM).
+* @return Ramp output speed (RPM).
+*
+* @example
+* <CODE> speedInput = MCAPP_SpeedRampUpdate(&speedRamp, speedTarget); </CODE>
+*
+*/
+float MCAPP_SpeedRampUpdate(MCAPP_SPEED_RAMP_T *pRamp, float target)
+{
+    float error;
+    float accelStep;
+    float speedToStop;
+    float direction;
+    float accelNext;
+    
+    if(pRamp->enable == 0)
+    {
+        pRamp->output = target;
+        pRamp->accel = 0;
+        return pRamp->output;
+    }
+    
+    error = target - pRamp->output;
+    accelStep = pRamp->jerkMax * pRamp->sampleTime;
+    
+    /* Target is reached within one step with acceleration close to zero */
+    if((fabsf(error) <= (fabsf(pRamp->accel) + 0.5f * accelStep) * 
+                pRamp->sampleTime) && (fabsf(pRamp->accel) <= accelStep))
+    {
+        pRamp->output = target;
+        pRamp->accel = 0;
+        return pRamp->output;
+    }
+    
+    /* Acceleration towards the target is raised only if the speed change 
+       with the raised acceleration reduced to zero at jerk limit still does
+       not pass the target. The half step term is the speed change of the 
+       discrete steps, without it short speed changes overshoot */
+    direction = (error >= 0) ? 1.0f : -1.0f;
+    accelNext = direction * pRamp->accel + accelStep;
+    if(accelNext > pRamp->accelMax)
+    {
+        accelNext = pRamp->accelMax;
+    }
+    speedToStop = (accelNext * fabsf(accelNext) / (2.0f * pRamp->jerkMax)) +
+                                    (0.5f * accelNext * pRamp->sampleTime);
+    
+    if((direction * error) > speedToStop)
+    {
+        pRamp->accel += direction * accelStep;
+    }
+    else
+    {
+        pRamp->accel -= direction * accelStep;
+    }
+    if(pRamp->accel > pRamp->accelMax)
+    {
+        pRamp->accel = pRamp->accelMax;
+    }
+    else if(pRamp->accel < -pRamp->accelMax)
+    {
+        pRamp->accel = -pRamp->accelMax;
+    }
+    
+    pRamp->output += pRamp->accel * pRamp->sampleTime;
+    
+    return pRamp->output;
+}
+
+/**
+* <B> Function: MCAPP_PositionProfileInit(MCAPP_POSITION_PROFILE_T *, float)  </B>
+*
+* @brief Function to initialize the profile at standstill.
+*
+* @param Pointer to the data structure containing profile parameters.
+* @param Initial position (rad).
+* @return none.
+*
+* @example
+* <CODE> MCAPP_PositionProfileInit(&positionProfile, position); </CODE>
+*
+*/
+void MCAPP_PositionProfileInit(MCAPP_POSITION_PROFILE_T *pProfile, 
+                                                                float position)
+{
+    pProfile->position = position;
+    pProfile->velocity = 0;
+    pProfile->complete = 1;
+}
+
+/**
+* <B> Function: MCAPP_PositionProfileUpdate(MCAPP_POSITION_PROFILE_T *, float)  </B>
+*
+* @brief Function to move the profile position towards the target position, 
+*        to be called at the speed loop rate.
+*
+* @param Pointer to the data structure containing profile parameters.
+* @param Target position (rad).
+* @return Profile velocity (rad/s).
+*
+* @example
+* <CODE> velocity = MCAPP_PositionProfileUpdate(&positionProfile, target); </CODE>
+*
+*/
+float MCAPP_PositionProfileUpdate(MCAPP_POSITION_PROFILE_T *pProfile, 
+                                                                    float target)
+{
+    float error;
+    float velocityStep;
+    float distanceToStop;
+    float direction;
+    float velocityNext;
+    
+    error = target - pProfile->position;
+    velocityStep = pProfile->accelMax * pProfile->sampleTime;
+    
+    /* Target is reached within one step with velocity close to zero */
+    if((fabsf(error) <= (fabsf(pProfile->velocity) + 0.5f * velocityStep) * 
+            pProfile->sampleTime) && (fabsf(pProfile->velocity) <= velocityStep))
+    {
+        pProfile->position = target;
+        pProfile->velocity = 0;
+        pProfile->complete = 1;
+        return pProfile->velocity;
+    }
+    pProfile->complete = 0;
+    
+    /* Velocity towards the target is raised only if the distance travelled
+       with the raised velocity reduced to zero at acceleration limit still
+       does not pass the target. The half step term is the distance of the
+       discrete steps, without it the profile overshoots the target */
+    direction = (error >= 0) ? 1.0f : -1.0f;
+    velocityNext = direction * pProfile->velocity + velocityStep;
+    if(velocityNext > pProfile->velocityMax)
+    {
+        velocityNext = pProfile->velocityMax;
+    }
+    distanceToStop = (velocityNext * fabsf(velocityNext) / 
+                                            (2.0f * pProfile->accelMax)) +
+                                (0.5f * velocityNext * pProfile->sampleTime);
+    
+    if((direction * error) > distanceToStop)
+    {
+        pProfile->velocity += direction * velocityStep;
+    }
+    else
+    {
+        pProfile->velocity -= direction * velocityStep;
+    }
+    if(pProfile->velocity > pProfile->velocityMax)
+    {
+        pProfile->velocity = pProfile->velocityMax;
+    }
+    else if(pProfile->velocity < -pProfile->velocityMax)
+    {
+        pProfile->velocity = -pProfile->velocityMax;
+    }
+    
+    pProfile->position += pProfile->velocity * pProfile->sampleTime;
+    
+    return pProfile->velocity;
+}
+
+// </editor-fold>
@@ -0,0 +1,108 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file trajectory.h
+ *
+ * @brief This header file lists data type definitions and interface functions
+ * of the trajectory generator module
+ *
+ * Component: TRAJECTORY
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+#ifndef __TRAJECTORY_H
+#define __TRAJECTORY_H
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// </editor-fold>
+
+#ifdef __cplusplus  // Provide C++ Compatability
+    extern "C" {
+#endif
+
+// <editor-fold defaultstate="collapsed" desc="TYPE DEFINITIONS ">
+
+/**
+ * Jerk limited speed ramp data type
+*/
+typedef struct
+{
+    uint32_t
+        enable;             /* 1 = ramp enabled, 0 = output follows target */
+    float
+        accelMax,           /* Acceleration limit (RPM/s) */
+        jerkMax,            /* Jerk limit (RPM/s^2) */
+        sampleTime,         /* Execution period of the ramp (s) */
+        accel,              /* Present acceleration (RPM/s) */
+        output;             /* Ramp output speed (RPM) */
+} MCAPP_SPEED_RAMP_T;
+
+/**
+ * Trapezoidal position profile data type
+*/
+typedef struct
+{
+    uint32_t
+        complete;           /* 1 = profile position has reached the target */
+    float
+        velocityMax,        /* Velocity limit (rad/s) */
+        accelMax,           /* Acceleration limit (rad/s^2) */
+        sampleTime,         /* Execution period of the profile (s) */
+        velocity,           /* Profile velocity (rad/s) */
+        position;           /* Profile position (rad) */
+} MCAPP_POSITION_PROFILE_T;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+
+void MCAPP_SpeedRampInit(MCAPP_SPEED_RAMP_T *, float);
+float MCAPP_SpeedRampUpdate(MCAPP_SPEED_RAMP_T *, float);
+void MCAPP_PositionProfileInit(MCAPP_POSITION_PROFILE_T *, float);
+float MCAPP_PositionProfileUpdate(MCAPP_POSITION_PROFILE_T *, float);
+
+// </editor-fold>
+
+#ifdef __cplusplus  // Provide C++ Compatibility
+    }
+#endif
+#endif      // end of __TRAJECTORY_H
@@ -0,0 +1,415 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * efficiency_sweep.c
+ *
+ * This file implements the efficiency sweep. In speed control the speed
+ * target is stepped through the speed points for each load point, the load
+ * setpoint of the present point is applied by the host to the load machine.
+ * Each point is held until the speed stays within a band for the settling
+ * time, then speed, DC bus voltage, DC bus current, reference current and
+ * the mean squared phase currents are averaged. Input power is DC bus
+ * voltage x DC bus current, the phase RMS currents give the copper loss.
+ *
+ * Component: EFFICIENCY SWEEP
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+
+#include "efficiency_sweep.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
+
+static void EfficiencySweepPointStart(MCAPP_EFFICIENCY_SWEEP_T *);
+static void EfficiencySweepAverageStart(MCAPP_EFFICIENCY_SWEEP_T *, uint8_t);
+static void EfficiencySweepPointStore(MCAPP_EFFICIENCY_SWEEP_T *);
+static int32_t EfficiencySweepSaturate(float, float, float);
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+
+/**
+* <B> Function: MCAPP_EfficiencySweepInit(MCAPP_EFFICIENCY_SWEEP_T *) </B>
+*
+* @brief Function to initialize the efficiency sweep, tables and times are
+*        to be set before.
+*
+* @param Pointer to efficiency sweep data structure.
+* @return none.
+*
+* @example
+* <CODE> MCAPP_EfficiencySweepInit(&efficiencySweep); </CODE>
+*
+*/
+void MCAPP_EfficiencySweepInit(MCAPP_EFFICIENCY_SWEEP_T *pSweep)
+{
+    pSweep->request = 0;
+    pSweep->abortRequest = 0;
+    pSweep->state = EFFICIENCY_SWEEP_IDLE;
+    pSweep->speedIndex = 0;
+    pSweep->loadIndex = 0;
+    pSweep->point = 0;
+    pSweep->pointCount = pSweep->speedTableSize * pSweep->loadTableSize;
+    if(pSweep->pointCount > EFFICIENCY_SWEEP_POINTS_MAX)
+    {
+        pSweep->pointCount = EFFICIENCY_SWEEP_POINTS_MAX;
+    }
+    pSweep->speedTarget = 0;
+    pSweep->loadSetpoint = 0;
+}
+
+/**
+* <B> Function: MCAPP_EfficiencySweepStart(MCAPP_EFFICIENCY_SWEEP_T *) </B>
+*
+* @brief Function to start the sweep from the first speed and load point,
+*        results of the previous sweep are discarded.
+*
+* @param Pointer to efficiency sweep data structure.
+* @return none.
+*
+* @example
+* <CODE> MCAPP_EfficiencySweepStart(&efficiencySweep); </CODE>
+*
+*/
+void MCAPP_EfficiencySweepStart(MCAPP_EFFICIENCY_SWEEP_T *pSweep)
+{
+    pSweep->request = 0;
+    pSweep->abortRequest = 0;
+    pSweep->speedIndex = 0;
+    pSweep->loadIndex = 0;
+    pSweep->point = 0;
+
+    if(pSweep->pointCount == 0)
+    {
+        pSweep->state = EFFICIENCY_SWEEP_COMPLETE;
+        return;
+    }
+    EfficiencySweepPointStart(pSweep);
+}
+
+/**
+* <B> Function: MCAPP_EfficiencySweepAbort(MCAPP_EFFICIENCY_SWEEP_T *) </B>
+*
+* @brief Function to abort a running sweep and discard a pending request.
+*        Points measured before are retained.
+*
+* @param Pointer to efficiency sweep data structure.
+* @return none.
+*
+* @example
+* <CODE> MCAPP_EfficiencySweepAbort(&efficiencySweep); </CODE>
+*
+*/
+void MCAPP_EfficiencySweepAbort(MCAPP_EFFICIENCY_SWEEP_T *pSweep)
+{
+    pSweep->request = 0;
+    pSweep->abortRequest = 0;
+    if(MCAPP_EfficiencySweepActive(pSweep))
+    {
+        pSweep->state = EFFICIENCY_SWEEP_ABORTED;
+    }
+}
+
+/**
+* <B> Function: MCAPP_EfficiencySweepActive(MCAPP_EFFICIENCY_SWEEP_T *) </B>
+*
+* @brief Function to check if the sweep sets the speed target.
+*
+* @param Pointer to efficiency sweep data structure.
+* @return true if the sweep is running.
+*
+* @example
+* <CODE> active = MCAPP_EfficiencySweepActive(&efficiencySweep); </CODE>
+*
+*/
+bool MCAPP_EfficiencySweepActive(MCAPP_EFFICIENCY_SWEEP_T *pSweep)
+{
+    return ((pSweep->state == EFFICIENCY_SWEEP_SETTLE) ||
+                                (pSweep->state == EFFICIENCY_SWEEP_AVERAGE));
+}
+
+/**
+* <B> Function: MCAPP_EfficiencySweepUpdate(MCAPP_EFFICIENCY_SWEEP_T *,
+*                                       const MCAPP_EFFICIENCY_SAMPLE_T *) </B>
+*
+* @brief Function to step the sweep, to be called every control loop
+*        execution while the motor runs in speed control. A point is averaged
+*        once the speed has been within speedBand of the target for
+*        settleCount executions, or after timeoutCount executions with the
+*        result marked as not settled.
+*
+* @param Pointer to efficiency sweep data structure.
+* @param Pointer to the present control loop sample.
+* @return none.
+*
+* @example
+* <CODE> MCAPP_EfficiencySweepUpdate(&efficiencySweep, &sample); </CODE>
+*
+*/
+void MCAPP_EfficiencySweepUpdate(MCAPP_EFFICIENCY_SWEEP_T *pSweep,
+                                    const MCAPP_EFFICIENCY_SAMPLE_T *pSample)
+{
+    uint32_t index;
+
+    switch(pSweep->state)
+    {
+    case EFFICIENCY_SWEEP_SETTLE:
+        pSweep->counter++;
+        if(fabsf(pSample->speed - pSweep->speedTarget) <= pSweep->speedBand)
+        {
+            pSweep->settleCounter++;
+        }
+        else
+        {
+            pSweep->settleCounter = 0;
+        }
+
+        if(pSweep->settleCounter >= pSweep->settleCount)
+        {
+            EfficiencySweepAverageStart(pSweep, 1);
+        }
+        else if(pSweep->counter >= pSweep->timeoutCount)
+        {
+            EfficiencySweepAverageStart(pSweep, 0);
+        }
+        break;
+
+    case EFFICIENCY_SWEEP_AVERAGE:
+        pSweep->sumSpeed += pSample->speed;
+        pSweep->sumDcBusVoltage += pSample->dcBusVoltage;
+        pSweep->sumMotorCurrent += pSample->motorCurrent;
+        pSweep->sumReferenceCurrent += pSample->referenceCurrent;
+        for(index = 0; index < EFFICIENCY_SWEEP_PHASES; index++)
+        {
+            pSweep->sumSquare[index] +=
+                                pSample->current[index] * pSample->current[index];
+        }
+
+        pSweep->counter++;
+        if(pSweep->counter < pSweep->averageCount)
+        {
+            break;
+        }
+        EfficiencySweepPointStore(pSweep);
+
+        /* Speed points are stepped for each load point, so that the load
+           setpoint is changed least often */
+        pSweep->point++;
+        pSweep->speedIndex++;
+        if(pSweep->speedIndex >= pSweep->speedTableSize)
+        {
+            pSweep->speedIndex = 0;
+            pSweep->loadIndex++;
+        }
+        if(pSweep->point >= pSweep->pointCount)
+        {
+            pSweep->state = EFFICIENCY_SWEEP_COMPLETE;
+        }
+        else
+        {
+            EfficiencySweepPointStart(pSweep);
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+/**
+* <B> Function: MCAPP_EfficiencySweepPointGet(MCAPP_EFFICIENCY_SWEEP_T *,
+*                                   uint32_t, MCAPP_EFFICIENCY_POINT_T *) </B>
+*
+* @brief Function to read the result of a measured point.
+*
+* @param Pointer to efficiency sweep data structure.
+* @param Point index, in the order of measurement.
+* @param Pointer to the result to be updated.
+* @return true if the point is measured.
+*
+* @example
+* <CODE> MCAPP_EfficiencySweepPointGet(&efficiencySweep, 0, &result); </CODE>
+*
+*/
+bool MCAPP_EfficiencySweepPointGet(MCAPP_EFFICIENCY_SWEEP_T *pSweep,
+                            uint32_t index, MCAPP_EFFICIENCY_POINT_T *pResult)
+{
+    if(index >= pSweep->point)
+    {
+        return false;
+    }
+    *pResult = pSweep->result[index];
+    return true;
+}
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
+
+/**
+* <B> Function: EfficiencySweepPointStart(MCAPP_EFFICIENCY_SWEEP_T *) </B>
+*
+* @brief Function to set the speed target and load setpoint of the present
+*        point and wait for the speed to settle.
+*
+* @param Pointer to efficiency sweep data structure.
+* @return none.
+*
+* @example
+* <CODE> EfficiencySweepPointStart(&efficiencySweep); </CODE>
+*
+*/
+static void EfficiencySweepPointStart(MCAPP_EFFICIENCY_SWEEP_T *pSweep)
+{
+    pSweep->speedTarget = pSweep->pSpeedTable[pSweep->speedIndex];
+    pSweep->loadSetpoint = pSweep->pLoadTable[pSweep->loadIndex];
+    pSweep->counter = 0;
+    pSweep->settleCounter = 0;
+    pSweep->state = EFFICIENCY_SWEEP_SETTLE;
+}
+
+/**
+* <B> Function: EfficiencySweepAverageStart(MCAPP_EFFICIENCY_SWEEP_T *,
+*                                                           uint8_t) </B>
+*
+* @brief Function to clear the accumulated inputs and start averaging.
+*
+* @param Pointer to efficiency sweep data structure.
+* @param 1 = speed settled within timeout.
+* @return none.
+*
+* @example
+* <CODE> EfficiencySweepAverageStart(&efficiencySweep, 1); </CODE>
+*
+*/
+static void EfficiencySweepAverageStart(MCAPP_EFFICIENCY_SWEEP_T *pSweep,
+                                                                uint8_t settled)
+{
+    uint32_t index;
+
+    pSweep->sumSpeed = 0;
+    pSweep->sumDcBusVoltage = 0;
+    pSweep->sumMotorCurrent = 0;
+    pSweep->sumReferenceCurrent = 0;
+    for(index = 0; index < EFFICIENCY_SWEEP_PHASES; index++)
+    {
+        pSweep->sumSquare[index] = 0;
+    }
+    pSweep->settled = settled;
+    pSweep->counter = 0;
+    pSweep->state = EFFICIENCY_SWEEP_AVERAGE;
+}
+
+/**
+* <B> Function: EfficiencySweepPointStore(MCAPP_EFFICIENCY_SWEEP_T *) </B>
+*
+* @brief Function to store the averages of the present point in the table
+*        of results.
+*
+* @param Pointer to efficiency sweep data structure.
+* @return none.
+*
+* @example
+* <CODE> EfficiencySweepPointStore(&efficiencySweep); </CODE>
+*
+*/
+static void EfficiencySweepPointStore(MCAPP_EFFICIENCY_SWEEP_T *pSweep)
+{
+    MCAPP_EFFICIENCY_POINT_T *pResult = &pSweep->result[pSweep->point];
+    float samples = (float)pSweep->averageCount;
+    uint32_t index;
+
+    pResult->speed = (int16_t)EfficiencySweepSaturate(
+                        pSweep->sumSpeed / samples, -32768.0f, 32767.0f);
+    pResult->motorCurrent = (int16_t)EfficiencySweepSaturate(
+                        pSweep->sumMotorCurrent * 1000.0f / samples,
+                                                        -32768.0f, 32767.0f);
+    pResult->referenceCurrent = (int16_t)EfficiencySweepSaturate(
+                        pSweep->sumReferenceCurrent * 1000.0f / samples,
+                                                        -32768.0f, 32767.0f);
+    pResult->dcBusVoltage = (uint16_t)EfficiencySweepSaturate(
+                        pSweep->sumDcBusVoltage * 10.0f / samples,
+                                                            0, 65535.0f);
+    for(index = 0; index < EFFICIENCY_SWEEP_PHASES; index++)
+    {
+        pResult->currentRms[index] = (uint16_t)EfficiencySweepSaturate(
+                    sqrtf(pSweep->sumSquare[index] / samples) * 1000.0f,
+                                                            0, 65535.0f);
+    }
+    pResult->speedIndex = (uint8_t)pSweep->speedIndex;
+    pResult->loadIndex = (uint8_t)pSweep->loadIndex;
+    pResult->settled = pSweep->settled;
+    pResult->reserved = 0;
+}
+
+/**
+* <B> Function: EfficiencySweepSaturate(float, float, float) </B>
+*
+* @brief Function to round a value to integer within limits.
+*
+* @param Value.
+* @param Minimum.
+* @param Maximum.
+* @return Rounded and limited value.
+*
+* @example
+* <CODE> EfficiencySweepSaturate(value, 0, 65535.0f); </CODE>
+*
+*/
+static int32_t EfficiencySweepSaturate(float value, float min, float max)
+{
+    if(value < min)
+    {
+        value = min;
+    }
+    else if(value > max)
+    {
+        value = max;
+    }
+    return (int32_t)lroundf(value);
+}
+
+// </editor-fold>
@@ -0,0 +1,179 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file efficiency_sweep.h
+ *
+ * @brief This header file lists data type definitions and interface functions
+ * of the efficiency sweep. Speed target is stepped through a table of speed
+ * points for each load point of a table, each point is held until the speed
+ * has settled and the measured inputs are averaged into a table of results
+ * for rendering the efficiency and loss maps on the host.
+ *
+ * Component: EFFICIENCY SWEEP
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+#ifndef __EFFICIENCY_SWEEP_H
+#define __EFFICIENCY_SWEEP_H
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// </editor-fold>
+
+#ifdef __cplusplus  // Provide C++ Compatability
+    extern "C" {
+#endif
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/CONSTANTS ">
+
+/* Number of motor phases */
+#define EFFICIENCY_SWEEP_PHASES         4
+/* Maximum number of points, speed points x load points */
+#define EFFICIENCY_SWEEP_POINTS_MAX     32
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="ENUMERATED CONSTANTS ">
+
+typedef enum
+{
+    EFFICIENCY_SWEEP_IDLE = 0,      /* No sweep since start up */
+    EFFICIENCY_SWEEP_SETTLE = 1,    /* Waiting for speed to settle at a point */
+    EFFICIENCY_SWEEP_AVERAGE = 2,   /* Averaging the inputs at a point */
+    EFFICIENCY_SWEEP_COMPLETE = 3,  /* All points are measured */
+    EFFICIENCY_SWEEP_ABORTED = 4,   /* Motor stopped before the last point */
+}MCAPP_EFFICIENCY_SWEEP_STATE_T;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="TYPE DEFINITIONS ">
+
+/**
+ * Control loop sample of the inputs averaged at a point
+*/
+typedef struct
+{
+    float
+        speed,              /* Measured speed (RPM) */
+        dcBusVoltage,       /* DC bus voltage (V) */
+        motorCurrent,       /* DC bus current (A) */
+        referenceCurrent,   /* Reference current (A) */
+        current[EFFICIENCY_SWEEP_PHASES];   /* Phase currents (A) */
+} MCAPP_EFFICIENCY_SAMPLE_T;
+
+/**
+ * Result of a point, scaled to integers to limit the table size
+*/
+typedef struct
+{
+    int16_t
+        speed,              /* Averaged speed (RPM) */
+        motorCurrent,       /* Averaged DC bus current (mA) */
+        referenceCurrent;   /* Averaged reference current (mA) */
+    uint16_t
+        dcBusVoltage,       /* Averaged DC bus voltage (0.1V) */
+        currentRms[EFFICIENCY_SWEEP_PHASES];    /* Phase RMS currents (mA) */
+    uint8_t
+        speedIndex,         /* Index of the point in speed table */
+        loadIndex,          /* Index of the point in load table */
+        settled,            /* 0 = speed did not settle within timeout */
+        reserved;
+} MCAPP_EFFICIENCY_POINT_T;
+
+/**
+ * Efficiency sweep data type
+*/
+typedef struct
+{
+    uint32_t
+        request,            /* 1 = start sweep, cleared when started */
+        abortRequest,       /* 1 = abort sweep, cleared when handled */
+        state,              /* Sweep state MCAPP_EFFICIENCY_SWEEP_STATE_T */
+        speedIndex,         /* Index of present speed point */
+        loadIndex,          /* Index of present load point */
+        point,              /* Number of points measured */
+        pointCount,         /* Number of points of the sweep */
+        speedTableSize,     /* Number of speed points */
+        loadTableSize,      /* Number of load points */
+        counter,            /* Executions at present point */
+        settleCounter,      /* Executions with speed within the band */
+        settleCount,        /* Executions within the band to settle */
+        timeoutCount,       /* Executions to settle before the point is averaged anyway */
+        averageCount;       /* Executions averaged at a point */
+    float
+        speedBand,          /* Speed error band of settled speed (RPM) */
+        speedTarget,        /* Target speed of present point (RPM) */
+        loadSetpoint,       /* Load setpoint of present point, applied by host */
+        sumSpeed,           /* Accumulated inputs of present point */
+        sumDcBusVoltage,
+        sumMotorCurrent,
+        sumReferenceCurrent,
+        sumSquare[EFFICIENCY_SWEEP_PHASES];
+    uint8_t
+        settled;            /* 1 = present point settled within timeout */
+
+    /* Tables of speed points (RPM) and load points */
+    const float *pSpeedTable;
+    const float *pLoadTable;
+
+    MCAPP_EFFICIENCY_POINT_T
+        result[EFFICIENCY_SWEEP_POINTS_MAX];
+} MCAPP_EFFICIENCY_SWEEP_T;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+
+void MCAPP_EfficiencySweepInit(MCAPP_EFFICIENCY_SWEEP_T *);
+void MCAPP_EfficiencySweepStart(MCAPP_EFFICIENCY_SWEEP_T *);
+void MCAPP_EfficiencySweepAbort(MCAPP_EFFICIENCY_SWEEP_T *);
+bool MCAPP_EfficiencySweepActive(MCAPP_EFFICIENCY_SWEEP_T *);
+void MCAPP_EfficiencySweepUpdate(MCAPP_EFFICIENCY_SWEEP_T *,
+                                        const MCAPP_EFFICIENCY_SAMPLE_T *);
+bool MCAPP_EfficiencySweepPointGet(MCAPP_EFFICIENCY_SWEEP_T *, uint32_t,
+                                                MCAPP_EFFICIENCY_POINT_T *);
+
+// </editor-fold>
+
+#ifdef __cplusplus  // Provide C++ Compatibility
+    }
+#endif
+#endif      // end of __EFFICIENCY_SWEEP_H
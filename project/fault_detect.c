@@ -46,32 +46,823 @@
 
 // <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
 
+#include <math.h>
+
 #include "fault_detect.h"
 #include "mc1_init.h"
 
 // </editor-fold>
 
+/**
+* <B> Function: MCAPP_FaultDetect(MCAPP_FAULT_DETECT_T *, MCAPP_MEASURE_T *) </B>
+*
+* @brief Function to detect phase overcurrent faults. All phases are checked,
+*        so simultaneous faults are reported together.
+*
+* @param Pointer to fault detection data structure.
+* @param Pointer to measured motor inputs.
+* @return none.
+* @example
+* <CODE> MCAPP_FaultDetect(&faultDetect, &motorInputs); </CODE>
+*
+*/
 void MCAPP_FaultDetect(MCAPP_FAULT_DETECT_T *pfaultDetect,MCAPP_MEASURE_T *pMotorInputs)
 {   
+    uint32_t detected = 0;
+    
     /* Over Current Protection*/
     /* Phase A Over Current Protection*/
     if(pMotorInputs->iabcd.a > pfaultDetect->PhaseA_OC_Threshold)
     {
-        pfaultDetect->faultStatus = MC1_PHASEA_OVERCURRENT_FAULT_DETECT;
+        detected |= MC1_PHASEA_OVERCURRENT_FAULT_DETECT;
     }
     /* Phase B Over Current Protection*/
     if(pMotorInputs->iabcd.b > pfaultDetect->PhaseB_OC_Threshold)
     {
-        pfaultDetect->faultStatus = MC1_PHASEB_OVERCURRENT_FAULT_DETECT;
+        detected |= MC1_PHASEB_OVERCURRENT_FAULT_DETECT;
     }
     /* Phase C Over Current Protection*/
     if(pMotorInputs->iabcd.c > pfaultDetect->PhaseC_OC_Threshold)
     {
-        pfaultDetect->faultStatus = MC1_PHASEC_OVERCURRENT_FAULT_DETECT;
+        detected |= MC1_PHASEC_OVERCURRENT_FAULT_DETECT;
     }
     /* Phase D Over Current Protection*/
     if(pMotorInputs->iabcd.d > pfaultDetect->PhaseD_OC_Threshold)
     {
-        pfaultDetect->faultStatus = MC1_PHASED_OVERCURRENT_FAULT_DETECT;
+        detected |= MC1_PHASED_OVERCURRENT_FAULT_DETECT;
     }  
+    
+    MCAPP_FaultReport(pfaultDetect, detected, MC1_PHASE_OC_FAULTS);
+}
+
+/**
+* <B> Function: MCAPP_FaultDetectOcThresholdUpdate(MCAPP_FAULT_DETECT_T *, 
+*                                                       float, uint32_t) </B>
+*
+* @brief Function to set the phase overcurrent thresholds from the reference
+*        current, reference x (1 + refGain) + margin limited to the ceiling of
+*        each phase. The reference is held and decays by decayGain per
+*        execution, as the phase current does not follow a drop of the 
+*        reference at once. Thresholds are at the ceiling for blankCount executions 
+*        after commutation, as the current of the phase turned off is still
+*        decaying, and when no single phase is active. To be called before 
+*        MCAPP_FaultDetect.
+*
+* @param Pointer to fault detection data structure.
+* @param Reference current (A), negative in braking.
+* @param Active phase MCAPP_SRM_PHASE_T, 0 if no single phase is active.
+* @return none.
+* @example
+* <CODE> MCAPP_FaultDetectOcThresholdUpdate(&faultDetect, reference, phase); </CODE>
+*
+*/
+void MCAPP_FaultDetectOcThresholdUpdate(MCAPP_FAULT_DETECT_T *pfaultDetect,
+                                        float referenceCurrent, uint32_t phaseOn)
+{
+    MCAPP_OC_THRESHOLD_T *pThreshold = &pfaultDetect->ocThreshold;
+    float threshold[MC1_WINDING_PHASES], dynamic;
+    uint32_t index;
+    
+    if(phaseOn != pThreshold->phasePrev)
+    {
+        pThreshold->blankCounter = pThreshold->blankCount;
+        pThreshold->phasePrev = phaseOn;
+    }
+    
+    if(referenceCurrent < 0)
+    {
+        referenceCurrent = -referenceCurrent;
+    }
+    
+    /* Held reference rises at once and decays no faster than the phase 
+       current in zero voltage freewheeling */
+    pThreshold->referenceHeld -= pThreshold->referenceHeld * 
+                                                    pThreshold->decayGain;
+    if(referenceCurrent > pThreshold->referenceHeld)
+    {
+        pThreshold->referenceHeld = referenceCurrent;
+    }
+    dynamic = (pThreshold->referenceHeld * (1.0f + pThreshold->refGain)) + 
+                                                            pThreshold->margin;
+    
+    for(index = 0; index < MC1_WINDING_PHASES; index++)
+    {
+        threshold[index] = pThreshold->ceiling[index];
+        if((pThreshold->enable == 1) && (phaseOn != 0) && 
+            (pThreshold->blankCounter == 0) && (dynamic < threshold[index]))
+        {
+            threshold[index] = dynamic;
+        }
+    }
+    if(pThreshold->blankCounter > 0)
+    {
+        pThreshold->blankCounter--;
+    }
+    
+    pfaultDetect->PhaseA_OC_Threshold = threshold[0];
+    pfaultDetect->PhaseB_OC_Threshold = threshold[1];
+    pfaultDetect->PhaseC_OC_Threshold = threshold[2];
+    pfaultDetect->PhaseD_OC_Threshold = threshold[3];
+}
+
+/**
+* <B> Function: MCAPP_FaultDetectDcBus(MCAPP_FAULT_DETECT_T *, MCAPP_MEASURE_T *) </B>
+*
+* @brief Function to detect DC bus under voltage and over voltage faults. 
+*        Filtered DC bus voltage is to be beyond the limit for dcFaultCount 
+*        executions, so that transients on the DC bus are not reported.
+*
+* @param Pointer to fault detection data structure.
+* @param Pointer to measured motor inputs.
+* @return none.
+* @example
+* <CODE> MCAPP_FaultDetectDcBus(&faultDetect, &motorInputs); </CODE>
+*
+*/
+void MCAPP_FaultDetectDcBus(MCAPP_FAULT_DETECT_T *pfaultDetect,
+                                                MCAPP_MEASURE_T *pMotorInputs)
+{
+    uint32_t detected = 0;
+    float vdc = pMotorInputs->measureVdc.filtered;
+    
+    if(vdc < pfaultDetect->dcUndervoltage)
+    {
+        if(pfaultDetect->dcUndervoltageCounter < pfaultDetect->dcFaultCount)
+        {
+            pfaultDetect->dcUndervoltageCounter++;
+        }
+        else
+        {
+            detected |= MC1_DC_UNDERVOLTAGE_FAULT_DETECT;
+        }
+    }
+    else
+    {
+        pfaultDetect->dcUndervoltageCounter = 0;
+    }
+    
+    if(vdc > pfaultDetect->dcOvervoltage)
+    {
+        if(pfaultDetect->dcOvervoltageCounter < pfaultDetect->dcFaultCount)
+        {
+            pfaultDetect->dcOvervoltageCounter++;
+        }
+        else
+        {
+            detected |= MC1_DC_OVERVOLTAGE_FAULT_DETECT;
+        }
+    }
+    else
+    {
+        pfaultDetect->dcOvervoltageCounter = 0;
+    }
+    
+    MCAPP_FaultReport(pfaultDetect, detected, MC1_DC_BUS_FAULTS);
+}
+
+/**
+* <B> Function: MCAPP_FaultDetectWindingReset(MCAPP_FAULT_DETECT_T *) </B>
+*
+* @brief Function to reset the winding diagnostics counters, to be called 
+*        before the motor is started. Phases found faulty remain latched.
+*
+* @param Pointer to fault detection data structure.
+* @return none.
+* @example
+* <CODE> MCAPP_FaultDetectWindingReset(&faultDetect); </CODE>
+*
+*/
+void MCAPP_FaultDetectWindingReset(MCAPP_FAULT_DETECT_T *pfaultDetect)
+{
+    MCAPP_WINDING_DIAG_T *pDiag = &pfaultDetect->windingDiag;
+    uint32_t index;
+    
+    pDiag->phasePrev = 0;
+    pDiag->magnetizePrev = 0;
+    pDiag->riseCount = 0;
+    pDiag->openEvent = 0;
+    pDiag->shortEvent = 0;
+    pDiag->normalEvent = 0;
+    for(index = 0; index < MC1_WINDING_PHASES; index++)
+    {
+        pDiag->offCounter[index] = 0;
+        pDiag->openCounter[index] = 0;
+        pDiag->shortCounter[index] = 0;
+        pDiag->switchCounter[index] = 0;
+    }
+}
+
+/**
+* <B> Function: MCAPP_FaultDetectWinding(MCAPP_FAULT_DETECT_T *, 
+*                                   MCAPP_MEASURE_T *, uint32_t, bool) </B>
+*
+* @brief Function to detect winding and switch faults from the current rise.
+*        While the active phase is magnetized, current rises by DC bus voltage
+*        x sample time / phase inductance in a sample:
+*        (1) Open phase - rise expected with aligned inductance exceeds twice
+*            openCurrent while the measured rise is below openCurrent.
+*        (2) Shorted turns - rise in a sample exceeds the rise with unaligned
+*            inductance.
+*        (3) Failed switch - current remains above residualCurrent in a phase
+*            turned off for longer than the demagnetization time.
+*        Open phase and shorted turns are to be seen in eventCount consecutive
+*        conductions of the phase. In degraded mode the open phase is disabled.
+*
+* @param Pointer to fault detection data structure.
+* @param Pointer to measured motor inputs.
+* @param Active phase MCAPP_SRM_PHASE_T, 0 if no single phase is active.
+* @param true if the active phase is magnetized by software HCC.
+* @return none.
+* @example
+* <CODE> MCAPP_FaultDetectWinding(&faultDetect, &motorInputs, phase, on); </CODE>
+*
+*/
+void MCAPP_FaultDetectWinding(MCAPP_FAULT_DETECT_T *pfaultDetect,
+            MCAPP_MEASURE_T *pMotorInputs, uint32_t phaseOn, bool magnetize)
+{
+    MCAPP_WINDING_DIAG_T *pDiag = &pfaultDetect->windingDiag;
+    uint32_t index, phase, detected = 0;
+    float current[MC1_WINDING_PHASES], vdc, rise;
+    
+    if(pDiag->enable == 0)
+    {
+        return;
+    }
+    
+    current[0] = pMotorInputs->iabcd.a;
+    current[1] = pMotorInputs->iabcd.b;
+    current[2] = pMotorInputs->iabcd.c;
+    current[3] = pMotorInputs->iabcd.d;
+    vdc = pMotorInputs->measureVdc.filtered;
+    
+    /* Current decays after turn-off, a failed switch keeps it flowing */
+    for(index = 0; index < MC1_WINDING_PHASES; index++)
+    {
+        if((index + 1) == phaseOn)
+        {
+            pDiag->offCounter[index] = 0;
+            pDiag->switchCounter[index] = 0;
+        }
+        else if(pDiag->offCounter[index] < pDiag->demagCount)
+        {
+            pDiag->offCounter[index]++;
+        }
+        else if(current[index] > pDiag->residualCurrent)
+        {
+            if(pDiag->switchCounter[index] < pDiag->switchFaultCount)
+            {
+                pDiag->switchCounter[index]++;
+            }
+            else
+            {
+                pDiag->switchFaultPhases |= (1UL << index);
+            }
+        }
+        else
+        {
+            pDiag->switchCounter[index] = 0;
+        }
+    }
+    
+    /* Conduction of previous phase is complete on commutation */
+    if((pDiag->phasePrev != 0) && (phaseOn != pDiag->phasePrev))
+    {
+        index = pDiag->phasePrev - 1;
+        if(pDiag->normalEvent == 1)
+        {
+            pDiag->openCounter[index] = 0;
+        }
+        else if(pDiag->openEvent == 1)
+        {
+            pDiag->openCounter[index]++;
+        }
+        if(pDiag->shortEvent == 1)
+        {
+            pDiag->shortCounter[index]++;
+        }
+        else if(pDiag->normalEvent == 1)
+        {
+            pDiag->shortCounter[index] = 0;
+        }
+        if(pDiag->openCounter[index] >= pDiag->eventCount)
+        {
+            pDiag->openPhases |= (1UL << index);
+        }
+        if(pDiag->shortCounter[index] >= pDiag->eventCount)
+        {
+            pDiag->shortedPhases |= (1UL << index);
+        }
+        pDiag->openEvent = 0;
+        pDiag->shortEvent = 0;
+        pDiag->normalEvent = 0;
+        pDiag->riseCount = 0;
+        pDiag->magnetizePrev = 0;
+    }
+    
+    if((phaseOn != 0) && (phaseOn <= MC1_WINDING_PHASES))
+    {
+        phase = phaseOn - 1;
+        if(pDiag->magnetizePrev == 1)
+        {
+            /* Rise in the sample magnetized in previous execution */
+            rise = current[phase] - pDiag->currentPrev;
+            pDiag->riseCount++;
+            if(rise > (pDiag->riseGainMax * vdc))
+            {
+                pDiag->shortEvent = 1;
+            }
+            if((current[phase] - pDiag->riseStart) >= pDiag->openCurrent)
+            {
+                pDiag->normalEvent = 1;
+            }
+            else if((pDiag->riseGainMin * vdc * (float)pDiag->riseCount) >= 
+                                                    (2.0f * pDiag->openCurrent))
+            {
+                pDiag->openEvent = 1;
+            }
+        }
+        else
+        {
+            pDiag->riseCount = 0;
+            pDiag->riseStart = current[phase];
+        }
+        pDiag->currentPrev = current[phase];
+        pDiag->magnetizePrev = (magnetize == true) ? 1 : 0;
+    }
+    else
+    {
+        pDiag->magnetizePrev = 0;
+        phaseOn = 0;
+    }
+    pDiag->phasePrev = phaseOn;
+    
+    if(pDiag->openPhases != 0)
+    {
+        detected |= MC1_OPEN_PHASE_FAULT_DETECT;
+        if(pDiag->degradedMode == 1)
+        {
+            pDiag->disabledPhases |= pDiag->openPhases;
+        }
+    }
+    if(pDiag->shortedPhases != 0)
+    {
+        detected |= MC1_SHORTED_WINDING_FAULT_DETECT;
+        if(pDiag->degradedMode == 1)
+        {
+            pDiag->disabledPhases |= pDiag->shortedPhases;
+        }
+    }
+    if(pDiag->switchFaultPhases != 0)
+    {
+        detected |= MC1_SWITCH_FAULT_DETECT;
+    }
+    
+    MCAPP_FaultReport(pfaultDetect, detected, MC1_WINDING_FAULTS);
+}
+
+/**
+* <B> Function: MCAPP_FaultDetectSpeedReset(MCAPP_FAULT_DETECT_T *) </B>
+*
+* @brief Function to reset the speed and position sensor supervision, to be
+*        called before the motor is started.
+*
+* @param Pointer to fault detection data structure.
+* @return none.
+* @example
+* <CODE> MCAPP_FaultDetectSpeedReset(&faultDetect); </CODE>
+*
+*/
+void MCAPP_FaultDetectSpeedReset(MCAPP_FAULT_DETECT_T *pfaultDetect)
+{
+    MCAPP_SPEED_CHECK_T *pCheck = &pfaultDetect->speedCheck;
+    
+    pCheck->thetaValid = 0;
+    pCheck->overspeedCounter = 0;
+    pCheck->jumpCounter = 0;
+    pCheck->phasePrev = 0;
+    pCheck->strokeCounter = 0;
+    pCheck->conductCounter = 0;
+    pCheck->windowCounter = 0;
+    pCheck->mismatchCounter = 0;
+    pCheck->thetaPrev = 0;
+    pCheck->stepPrev = 0;
+}
+
+/**
+* <B> Function: MCAPP_FaultDetectSpeed(MCAPP_FAULT_DETECT_T *, 
+*                                                   MCAPP_MEASURE_T *) </B>
+*
+* @brief Function to supervise the speed and the position sensor:
+*        (1) Overspeed - measured speed above overspeed for faultCount 
+*            executions.
+*        (2) Position jump - change of rotor angle step between executions 
+*            above the acceleration a rotor can have, seen jumpCount times 
+*            more often than plausible steps.
+*        (3) Speed mismatch - changes of the conducting phase, found from 
+*            phase currents, counted in a window differ from the count 
+*            expected at sensor speed by more than tolerance in mismatchCount
+*            consecutive windows. Windows with phases conducting for less 
+*            than half the window are not checked.
+*        Position sensor checks are skipped when enable is 0.
+*
+* @param Pointer to fault detection data structure.
+* @param Pointer to measured motor inputs.
+* @return none.
+* @example
+* <CODE> MCAPP_FaultDetectSpeed(&faultDetect, &motorInputs); </CODE>
+*
+*/
+void MCAPP_FaultDetectSpeed(MCAPP_FAULT_DETECT_T *pfaultDetect,
+                                                MCAPP_MEASURE_T *pMotorInputs)
+{
+    MCAPP_SPEED_CHECK_T *pCheck = &pfaultDetect->speedCheck;
+    uint32_t index, phase, detected = 0;
+    float current[MC1_WINDING_PHASES], speed, theta, step, change, expected;
+    
+    speed = pMotorInputs->detectRotorPosition.speed;
+    theta = pMotorInputs->detectRotorPosition.theta;
+    
+    if(speed > pCheck->overspeed)
+    {
+        if(pCheck->overspeedCounter < pCheck->faultCount)
+        {
+            pCheck->overspeedCounter++;
+        }
+        else
+        {
+            detected |= MC1_OVERSPEED_FAULT_DETECT;
+        }
+    }
+    else
+    {
+        pCheck->overspeedCounter = 0;
+    }
+    
+    if(pCheck->enable == 1)
+    {
+        /* Angle step wrapped to +/- pi, so that a sensor wrap is no jump */
+        step = theta - pCheck->thetaPrev;
+        if(step > M_PI)
+        {
+            step -= 2.0f * M_PI;
+        }
+        else if(step < -M_PI)
+        {
+            step += 2.0f * M_PI;
+        }
+        change = step - pCheck->stepPrev;
+        if(pCheck->thetaValid < 2)
+        {
+            /* Step is known from the second execution, its change from the
+               third execution */
+            pCheck->thetaValid++;
+        }
+        else if((change > pCheck->stepChangeMax) || 
+                                            (change < -pCheck->stepChangeMax))
+        {
+            if(pCheck->jumpCounter < pCheck->jumpCount)
+            {
+                pCheck->jumpCounter++;
+            }
+            else
+            {
+                detected |= MC1_POSITION_JUMP_FAULT_DETECT;
+            }
+        }
+        else if(pCheck->jumpCounter > 0)
+        {
+            pCheck->jumpCounter--;
+        }
+        pCheck->thetaPrev = theta;
+        pCheck->stepPrev = step;
+        
+        /* Conducting phase is the phase of highest current above 
+           strokeCurrent */
+        current[0] = pMotorInputs->iabcd.a;
+        current[1] = pMotorInputs->iabcd.b;
+        current[2] = pMotorInputs->iabcd.c;
+        current[3] = pMotorInputs->iabcd.d;
+        phase = 0;
+        for(index = 0; index < MC1_WINDING_PHASES; index++)
+        {
+            if((current[index] > pCheck->strokeCurrent) && 
+                        ((phase == 0) || (current[index] > current[phase - 1])))
+            {
+                phase = index + 1;
+            }
+        }
+        if(phase != 0)
+        {
+            pCheck->conductCounter++;
+            if((pCheck->phasePrev != 0) && (phase != pCheck->phasePrev))
+            {
+                pCheck->strokeCounter++;
+            }
+            pCheck->phasePrev = phase;
+        }
+        
+        /* Window is checked if phases were conducting for most of it */
+        pCheck->windowCounter++;
+        if(pCheck->windowCounter >= pCheck->windowCount)
+        {
+            expected = speed * pCheck->strokeGain;
+            change = (float)pCheck->strokeCounter - expected;
+            if((speed > pCheck->minSpeed) && 
+                (pCheck->conductCounter > (pCheck->windowCount >> 1)) && 
+                ((change > (pCheck->tolerance * expected)) || 
+                                    (change < -(pCheck->tolerance * expected))))
+            {
+                if(pCheck->mismatchCounter < pCheck->mismatchCount)
+                {
+                    pCheck->mismatchCounter++;
+                }
+            }
+            else
+            {
+                pCheck->mismatchCounter = 0;
+            }
+            pCheck->windowCounter = 0;
+            pCheck->strokeCounter = 0;
+            pCheck->conductCounter = 0;
+        }
+        if(pCheck->mismatchCounter >= pCheck->mismatchCount)
+        {
+            detected |= MC1_SPEED_MISMATCH_FAULT_DETECT;
+        }
+    }
+    
+    MCAPP_FaultReport(pfaultDetect, detected, MC1_SPEED_FAULTS);
+}
+
+/**
+* <B> Function: MCAPP_FaultReport(MCAPP_FAULT_DETECT_T *, uint32_t, uint32_t) </B>
+*
+* @brief Function to update the faults checked by a detection source. New 
+*        faults are counted and latched, faults with trip reaction are latched
+*        for the reaction. The highest priority new fault is latched as first 
+*        fault if no fault was latched.
+*
+* @param Pointer to fault detection data structure.
+* @param Faults detected, bits of MC1_FAULT_DETECT_FLAG.
+* @param Faults checked by the detection source.
+* @return none.
+* @example
+* <CODE> MCAPP_FaultReport(&faultDetect, detected, MC1_PHASE_OC_FAULTS); </CODE>
+*
+*/
+void MCAPP_FaultReport(MCAPP_FAULT_DETECT_T *pfaultDetect, uint32_t detected,
+                                                                uint32_t mask)
+{
+    uint32_t newFaults, index;
+    
+    detected &= mask;
+    newFaults = detected & ~pfaultDetect->activeStatus;
+    pfaultDetect->activeStatus = (pfaultDetect->activeStatus & ~mask) | detected;
+    
+    if(newFaults == 0)
+    {
+        return;
+    }
+    
+    for(index = 0; index < MC1_FAULT_COUNT; index++)
+    {
+        if((newFaults & (1UL << index)) != 0)
+        {
+            pfaultDetect->faultCounter[index]++;
+            if(pfaultDetect->reactionClass[index] == MC1_FAULT_REACTION_TRIP)
+            {
+                pfaultDetect->tripStatus |= (1UL << index);
+            }
+        }
+    }
+    
+    if(pfaultDetect->faultStatus == 0)
+    {
+        /* Lowest bit is the highest priority fault */
+        pfaultDetect->firstFault = newFaults & (~newFaults + 1);
+    }
+    pfaultDetect->faultStatus |= newFaults;
+}
+
+/**
+* <B> Function: MCAPP_FaultReactionUpdate(MCAPP_FAULT_DETECT_T *) </B>
+*
+* @brief Function to evaluate the reaction to the faults, highest reaction 
+*        class of active faults and latched trip faults. Derating is held for
+*        derateHoldCount executions after the derate fault is removed. To be
+*        called every control loop execution.
+*
+* @param Pointer to fault detection data structure.
+* @return Reaction MC1_FAULT_REACTION_T.
+* @example
+* <CODE> reaction = MCAPP_FaultReactionUpdate(&faultDetect); </CODE>
+*
+*/
+uint32_t MCAPP_FaultReactionUpdate(MCAPP_FAULT_DETECT_T *pfaultDetect)
+{
+    uint32_t faults, index, reaction = MC1_FAULT_REACTION_NONE;
+    
+    faults = pfaultDetect->activeStatus | pfaultDetect->tripStatus;
+    for(index = 0; index < MC1_FAULT_COUNT; index++)
+    {
+        if(((faults & (1UL << index)) != 0) && 
+                            (pfaultDetect->reactionClass[index] > reaction))
+        {
+            reaction = pfaultDetect->reactionClass[index];
+        }
+    }
+    
+    if(reaction == MC1_FAULT_REACTION_DERATE)
+    {
+        pfaultDetect->derateCounter = pfaultDetect->derateHoldCount;
+    }
+    else if(pfaultDetect->derateCounter > 0)
+    {
+        pfaultDetect->derateCounter--;
+        if(reaction < MC1_FAULT_REACTION_DERATE)
+        {
+            reaction = MC1_FAULT_REACTION_DERATE;
+        }
+    }
+    
+    pfaultDetect->reaction = reaction;
+    return reaction;
+}
+
+/**
+* <B> Function: MCAPP_FaultClear(MCAPP_FAULT_DETECT_T *) </B>
+*
+* @brief Function to clear the latched faults. Fault counters are retained.
+*
+* @param Pointer to fault detection data structure.
+* @return none.
+* @example
+* <CODE> MCAPP_FaultClear(&faultDetect); </CODE>
+*
+*/
+void MCAPP_FaultClear(MCAPP_FAULT_DETECT_T *pfaultDetect)
+{
+    pfaultDetect->faultStatus = 0;
+    pfaultDetect->activeStatus = 0;
+    pfaultDetect->firstFault = 0;
+    pfaultDetect->tripStatus = 0;
+    pfaultDetect->derateCounter = 0;
+    pfaultDetect->dcUndervoltageCounter = 0;
+    pfaultDetect->dcOvervoltageCounter = 0;
+    pfaultDetect->windingDiag.openPhases = 0;
+    pfaultDetect->windingDiag.shortedPhases = 0;
+    pfaultDetect->windingDiag.switchFaultPhases = 0;
+    pfaultDetect->windingDiag.disabledPhases = 0;
+    pfaultDetect->reaction = MC1_FAULT_REACTION_NONE;
+}
+
+/**
+* <B> Function: MCAPP_FaultRecoveryStart(MCAPP_FAULT_DETECT_T *) </B>
+*
+* @brief Function to start the recovery from a trip. Retry of each latched 
+*        trip fault is counted, the drive is locked out if any trip fault has
+*        used up its restarts. Restart delay is doubled on each attempt since
+*        the drive was last healthy. To be called once on trip.
+*
+* @param Pointer to fault detection data structure.
+* @return none.
+* @example
+* <CODE> MCAPP_FaultRecoveryStart(&faultDetect); </CODE>
+*
+*/
+void MCAPP_FaultRecoveryStart(MCAPP_FAULT_DETECT_T *pfaultDetect)
+{
+    MCAPP_FAULT_RECOVERY_T *pRecovery = &pfaultDetect->recovery;
+    uint32_t index;
+    
+    if(pRecovery->enable == 0)
+    {
+        pRecovery->lockout = 1;
+        return;
+    }
+    
+    for(index = 0; index < MC1_FAULT_COUNT; index++)
+    {
+        if((pfaultDetect->tripStatus & (1UL << index)) != 0)
+        {
+            if(pRecovery->retryCounter[index] >= pRecovery->retryMax[index])
+            {
+                pRecovery->lockout = 1;
+            }
+            else
+            {
+                pRecovery->retryCounter[index]++;
+            }
+        }
+    }
+    
+    if(pRecovery->attempt == 0)
+    {
+        pRecovery->delayCount = pRecovery->delayMinCount;
+    }
+    else if(pRecovery->delayCount < (pRecovery->delayMaxCount >> 1))
+    {
+        pRecovery->delayCount <<= 1;
+    }
+    else
+    {
+        pRecovery->delayCount = pRecovery->delayMaxCount;
+    }
+    pRecovery->attempt++;
+    pRecovery->counter = 0;
+    pRecovery->healthyCounter = 0;
+}
+
+/**
+* <B> Function: MCAPP_FaultRecoveryStep(MCAPP_FAULT_DETECT_T *, bool) </B>
+*
+* @brief Function to execute the recovery in fault state. After the restart
+*        delay, the faults are cleared once the clear conditions are met. 
+*        Reset request clears the lockout, the retries and the faults. To be
+*        called every control loop execution in fault state.
+*
+* @param Pointer to fault detection data structure.
+* @param true if the clear conditions of the faults are met.
+* @return true if the faults are cleared and the drive can be restarted.
+* @example
+* <CODE> restart = MCAPP_FaultRecoveryStep(&faultDetect, clear); </CODE>
+*
+*/
+bool MCAPP_FaultRecoveryStep(MCAPP_FAULT_DETECT_T *pfaultDetect, 
+                                                        bool clearCondition)
+{
+    MCAPP_FAULT_RECOVERY_T *pRecovery = &pfaultDetect->recovery;
+    uint32_t index;
+    
+    if(pRecovery->resetRequest == 1)
+    {
+        pRecovery->resetRequest = 0;
+        if(clearCondition == false)
+        {
+            return false;
+        }
+        pRecovery->lockout = 0;
+        pRecovery->attempt = 0;
+        for(index = 0; index < MC1_FAULT_COUNT; index++)
+        {
+            pRecovery->retryCounter[index] = 0;
+        }
+        MCAPP_FaultClear(pfaultDetect);
+        return true;
+    }
+    
+    if(pRecovery->lockout == 1)
+    {
+        return false;
+    }
+    
+    if(pRecovery->counter < pRecovery->delayCount)
+    {
+        pRecovery->counter++;
+        return false;
+    }
+    
+    if(clearCondition == false)
+    {
+        return false;
+    }
+    
+    MCAPP_FaultClear(pfaultDetect);
+    return true;
+}
+
+/**
+* <B> Function: MCAPP_FaultRecoveryHealthy(MCAPP_FAULT_DETECT_T *) </B>
+*
+* @brief Function to reset the retries once the drive has run without trip 
+*        for healthyCount executions. To be called every control loop 
+*        execution while running.
+*
+* @param Pointer to fault detection data structure.
+* @return none.
+* @example
+* <CODE> MCAPP_FaultRecoveryHealthy(&faultDetect); </CODE>
+*
+*/
+void MCAPP_FaultRecoveryHealthy(MCAPP_FAULT_DETECT_T *pfaultDetect)
+{
+    MCAPP_FAULT_RECOVERY_T *pRecovery = &pfaultDetect->recovery;
+    uint32_t index;
+    
+    if(pRecovery->attempt == 0)
+    {
+        return;
+    }
+    
+    if(pRecovery->healthyCounter < pRecovery->healthyCount)
+    {
+        pRecovery->healthyCounter++;
+        return;
+    }
+    
+    pRecovery->attempt = 0;
+    for(index = 0; index < MC1_FAULT_COUNT; index++)
+    {
+        pRecovery->retryCounter[index] = 0;
+    }
 }
@@ -54,7 +54,20 @@
 extern "C" {
 #endif
 
-
+void MCAPP_FaultDetect(MCAPP_FAULT_DETECT_T *, MCAPP_MEASURE_T *);
+void MCAPP_FaultDetectOcThresholdUpdate(MCAPP_FAULT_DETECT_T *, float, uint32_t);
+void MCAPP_FaultReport(MCAPP_FAULT_DETECT_T *, uint32_t, uint32_t);
+uint32_t MCAPP_FaultReactionUpdate(MCAPP_FAULT_DETECT_T *);
+void MCAPP_FaultDetectDcBus(MCAPP_FAULT_DETECT_T *, MCAPP_MEASURE_T *);
+void MCAPP_FaultDetectWindingReset(MCAPP_FAULT_DETECT_T *);
+void MCAPP_FaultDetectWinding(MCAPP_FAULT_DETECT_T *, MCAPP_MEASURE_T *,
+                                                            uint32_t, bool);
+void MCAPP_FaultDetectSpeedReset(MCAPP_FAULT_DETECT_T *);
+void MCAPP_FaultDetectSpeed(MCAPP_FAULT_DETECT_T *, MCAPP_MEASURE_T *);
+void MCAPP_FaultClear(MCAPP_FAULT_DETECT_T *);
+void MCAPP_FaultRecoveryStart(MCAPP_FAULT_DETECT_T *);
+bool MCAPP_FaultRecoveryStep(MCAPP_FAULT_DETECT_T *, bool);
+void MCAPP_FaultRecoveryHealthy(MCAPP_FAULT_DETECT_T *);
 
 #ifdef	__cplusplus
 }
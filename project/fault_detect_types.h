@@ -54,30 +54,199 @@ extern "C" {
 #endif
 
 /**
- * Fault flag types 
+ * Fault flag types, bits of the fault word. Lower bit has higher priority.
  */  
 typedef enum
 {
-    MC1_OV_OC_FAULT_DETECT                  = 0x01,  /* Hardware DC bus Overvoltage and Overcurrent indicator */
-    MC1_OVERCURRENT_FAULT_DETECT            = 0x02,  /* Allegro Overcurrent fault indicator */
-    MC1_PHASEA_OVERCURRENT_FAULT_DETECT     = 0x03,  /* Phase A Overcurrent fault indicator */
-    MC1_PHASEB_OVERCURRENT_FAULT_DETECT     = 0x04,  /* Phase B Overcurrent fault indicator */
-    MC1_PHASEC_OVERCURRENT_FAULT_DETECT     = 0x05,  /* Phase C Overcurrent fault indicator */
-    MC1_PHASED_OVERCURRENT_FAULT_DETECT     = 0x06   /* Phase D Overcurrent fault indicator */
+    MC1_OV_OC_FAULT_DETECT                  = 0x0001,  /* Hardware DC bus Overvoltage and Overcurrent indicator */
+    MC1_OVERCURRENT_FAULT_DETECT            = 0x0002,  /* Allegro Overcurrent fault indicator */
+    MC1_PHASEA_OVERCURRENT_FAULT_DETECT     = 0x0004,  /* Phase A Overcurrent fault indicator */
+    MC1_PHASEB_OVERCURRENT_FAULT_DETECT     = 0x0008,  /* Phase B Overcurrent fault indicator */
+    MC1_PHASEC_OVERCURRENT_FAULT_DETECT     = 0x0010,  /* Phase C Overcurrent fault indicator */
+    MC1_PHASED_OVERCURRENT_FAULT_DETECT     = 0x0020,  /* Phase D Overcurrent fault indicator */
+    MC1_CONTROL_FAULT_DETECT                = 0x0040,  /* Control scheme fault indicator */
+    MC1_CURRENT_OFFSET_FAULT_DETECT         = 0x0080,  /* Phase current offset out of limit indicator */
+    MC1_DC_UNDERVOLTAGE_FAULT_DETECT        = 0x0100,  /* Filtered DC bus under voltage indicator */
+    MC1_DC_OVERVOLTAGE_FAULT_DETECT         = 0x0200,  /* Filtered DC bus over voltage indicator */
+    MC1_OPEN_PHASE_FAULT_DETECT             = 0x0400,  /* Magnetized phase carries no current indicator */
+    MC1_SHORTED_WINDING_FAULT_DETECT        = 0x0800,  /* Phase current rises too fast indicator */
+    MC1_SWITCH_FAULT_DETECT                 = 0x1000,  /* Current in a phase turned off indicator */
+    MC1_STALL_FAULT_DETECT                  = 0x2000,  /* Rotor locked at saturated speed loop indicator */
+    MC1_OVERSPEED_FAULT_DETECT              = 0x4000,  /* Measured speed above overspeed limit indicator */
+    MC1_POSITION_JUMP_FAULT_DETECT          = 0x8000,  /* Implausible rotor angle step indicator */
+    MC1_SPEED_MISMATCH_FAULT_DETECT         = 0x10000, /* Sensor speed differs from conduction strokes indicator */
+    MC1_SUPERVISOR_FAULT_DETECT             = 0x20000  /* Interrupt, main loop or SPI missed deadline indicator */
 } MC1_FAULT_DETECT_FLAG;
 
+/* Number of fault flags */
+#define MC1_FAULT_COUNT                     18
+
+/* Fault flags detected by hardware in PWM fault interrupt */
+#define MC1_HARDWARE_FAULTS     (MC1_OV_OC_FAULT_DETECT | MC1_OVERCURRENT_FAULT_DETECT)
+/* Fault flags detected by software in control loop */
+#define MC1_PHASE_OC_FAULTS     (MC1_PHASEA_OVERCURRENT_FAULT_DETECT | \
+                                 MC1_PHASEB_OVERCURRENT_FAULT_DETECT | \
+                                 MC1_PHASEC_OVERCURRENT_FAULT_DETECT | \
+                                 MC1_PHASED_OVERCURRENT_FAULT_DETECT)
+/* Fault flags of DC bus supervision in control loop */
+#define MC1_DC_BUS_FAULTS       (MC1_DC_UNDERVOLTAGE_FAULT_DETECT | \
+                                 MC1_DC_OVERVOLTAGE_FAULT_DETECT)
+/* Fault flags of winding diagnostics in control loop */
+#define MC1_WINDING_FAULTS      (MC1_OPEN_PHASE_FAULT_DETECT | \
+                                 MC1_SHORTED_WINDING_FAULT_DETECT | \
+                                 MC1_SWITCH_FAULT_DETECT)
+    
+/* Fault flags of speed and position sensor supervision in control loop */
+#define MC1_SPEED_FAULTS        (MC1_OVERSPEED_FAULT_DETECT | \
+                                 MC1_POSITION_JUMP_FAULT_DETECT | \
+                                 MC1_SPEED_MISMATCH_FAULT_DETECT)
+    
+/* Number of motor phases checked by winding diagnostics */
+#define MC1_WINDING_PHASES                  4
+
+/**
+ * Fault reaction classes, in increasing order of severity
+ */  
+typedef enum
+{
+    MC1_FAULT_REACTION_NONE     = 0,    /* No active fault */
+    MC1_FAULT_REACTION_WARN     = 1,    /* Fault is reported, motor runs */
+    MC1_FAULT_REACTION_DERATE   = 2,    /* Current limit is reduced while active */
+    MC1_FAULT_REACTION_TRIP     = 3     /* Outputs disabled until fault is cleared */
+} MC1_FAULT_REACTION_T;
+
 // <editor-fold defaultstate="collapsed" desc="VARIABLE TYPE DEFINITIONS ">
 
+typedef struct
+{
+    uint32_t
+        enable,             /* 1 = winding diagnostics are executed */
+        degradedMode,       /* 1 = open phase is disabled, motor runs on others */
+        phasePrev,          /* Active phase of previous execution, 0 = none */
+        magnetizePrev,      /* 1 = active phase was magnetized in previous execution */
+        riseCount,          /* Consecutive executions of magnetizing */
+        openEvent,          /* 1 = open phase seen in present conduction */
+        shortEvent,         /* 1 = too fast rise seen in present conduction */
+        normalEvent,        /* 1 = normal current rise seen in present conduction */
+        eventCount,         /* Consecutive conductions with event to detect fault */
+        demagCount,         /* Executions for current to decay after turn-off */
+        switchFaultCount,   /* Executions of current after decay to detect fault */
+        offCounter[MC1_WINDING_PHASES],     /* Executions since phase turn-off */
+        openCounter[MC1_WINDING_PHASES],    /* Conductions with open phase */
+        shortCounter[MC1_WINDING_PHASES],   /* Conductions with too fast rise */
+        switchCounter[MC1_WINDING_PHASES],  /* Executions of current after decay */
+        openPhases,         /* Bit per phase, phase A = bit 0, found open */
+        shortedPhases,      /* Bit per phase with shorted turns */
+        switchFaultPhases,  /* Bit per phase with failed switch */
+        disabledPhases;     /* Bit per phase excluded from commutation */
+    float
+        currentPrev,        /* Active phase current of previous execution (A) */
+        riseStart,          /* Active phase current at start of magnetizing (A) */
+        openCurrent,        /* Current rise below which the phase is open (A) */
+        riseGainMin,        /* Slowest healthy rise in a sample per DC bus volt (A/V) */
+        riseGainMax,        /* Fastest healthy rise in a sample per DC bus volt (A/V) */
+        residualCurrent;    /* Current in a phase after decay for switch fault (A) */
+} MCAPP_WINDING_DIAG_T;
+
+typedef struct
+{
+    uint32_t
+        enable,             /* 1 = thresholds follow the reference current */
+        phasePrev,          /* Active phase of previous execution, 0 = none */
+        blankCount,         /* Executions at ceiling after commutation */
+        blankCounter;       /* Remaining executions of blanking */
+    float
+        ceiling[MC1_WINDING_PHASES],    /* Absolute threshold of each phase (A) */
+        refGain,            /* Threshold above reference, relative */
+        margin,             /* Threshold above reference, absolute (A) */
+        decayGain,          /* Decay of held reference per execution */
+        referenceHeld;      /* Reference magnitude with decay limit (A) */
+} MCAPP_OC_THRESHOLD_T;
+
+typedef struct
+{
+    uint32_t
+        enable,             /* 1 = position sensor plausibility is checked */
+        thetaValid,         /* 1 = thetaPrev and stepPrev are valid */
+        overspeedCounter,   /* Executions above overspeed limit */
+        faultCount,         /* Executions above overspeed limit to detect fault */
+        jumpCounter,        /* Implausible steps, reduced by plausible steps */
+        jumpCount,          /* Implausible steps to detect fault */
+        phasePrev,          /* Conducting phase of previous execution, 0 = none */
+        strokeCounter,      /* Changes of conducting phase in present window */
+        conductCounter,     /* Executions with a conducting phase in window */
+        windowCounter,      /* Executions in present window */
+        windowCount,        /* Executions of stroke counting window */
+        mismatchCounter,    /* Consecutive windows with speed mismatch */
+        mismatchCount;      /* Windows with speed mismatch to detect fault */
+    float
+        overspeed,          /* Speed of overspeed fault (RPM) */
+        thetaPrev,          /* Rotor angle of previous execution (rad) */
+        stepPrev,           /* Rotor angle step of previous execution (rad) */
+        stepChangeMax,      /* Plausible change of angle step in a sample (rad) */
+        strokeCurrent,      /* Current of a conducting phase (A) */
+        strokeGain,         /* Strokes in a window per RPM */
+        minSpeed,           /* Speed above which the strokes are checked (RPM) */
+        tolerance;          /* Relative stroke error of speed mismatch */
+} MCAPP_SPEED_CHECK_T;
+
+typedef struct
+{
+    uint32_t
+        enable,             /* 1 = automatic restart after trip faults */
+        lockout,            /* 1 = restart disabled until fault reset */
+        resetRequest,       /* Set to 1 to clear lockout and faults */
+        attempt,            /* Restarts since the drive was last healthy */
+        counter,            /* Executions in the present restart delay */
+        delayCount,         /* Present restart delay in executions */
+        delayMinCount,      /* Delay before the first restart */
+        delayMaxCount,      /* Delay limit as it is doubled on each restart */
+        healthyCounter,     /* Executions running without trip fault */
+        healthyCount,       /* Executions of running to reset the retries */
+        retryMax[MC1_FAULT_COUNT],      /* Restarts allowed for each fault */
+        retryCounter[MC1_FAULT_COUNT];  /* Restarts done for each fault */
+} MCAPP_FAULT_RECOVERY_T;
+
 typedef struct
 {
     float
         PhaseA_OC_Threshold,
         PhaseB_OC_Threshold,
         PhaseC_OC_Threshold,
-        PhaseD_OC_Threshold; 
+        PhaseD_OC_Threshold,
+        derateFactor,       /* Current limit scale while derating */
+        dcUndervoltage,     /* Filtered DC bus voltage of under voltage fault (V) */
+        dcOvervoltage;      /* Filtered DC bus voltage of over voltage fault (V) */
     
     uint32_t
-        faultStatus;        /* Fault Status */  
+        dcFaultCount,       /* Executions beyond DC bus limit to detect fault */
+        dcUndervoltageCounter, /* Executions below under voltage limit */
+        dcOvervoltageCounter,  /* Executions above over voltage limit */
+        faultStatus,        /* Latched faults, bits of MC1_FAULT_DETECT_FLAG */
+        activeStatus,       /* Faults present at the last detection */
+        firstFault,         /* First fault latched since faults were cleared */
+        tripStatus,         /* Latched faults with trip reaction */
+        reaction,           /* Present reaction MC1_FAULT_REACTION_T */
+        derateHoldCount,    /* Control loop executions derating is held */
+        derateCounter,      /* Remaining executions of derating */
+        reactionClass[MC1_FAULT_COUNT], /* Reaction class of each fault */
+        faultCounter[MC1_FAULT_COUNT];  /* Occurrences of each fault */
+    
+    /* Faults detected in PWM fault interrupt, reported in control loop as 
+       the interrupt may preempt a report of the control loop */
+    volatile uint32_t hardwarePending;
+    
+    MCAPP_FAULT_RECOVERY_T
+        recovery;           /* Restart policy after trip faults */
+    
+    MCAPP_OC_THRESHOLD_T
+        ocThreshold;        /* Phase overcurrent thresholds from reference */
+    
+    MCAPP_WINDING_DIAG_T
+        windingDiag;        /* Open phase, shorted winding and switch faults */
+    
+    MCAPP_SPEED_CHECK_T
+        speedCheck;         /* Overspeed and position sensor plausibility */
 }MCAPP_FAULT_DETECT_T;
 
 #ifdef __cplusplus
@@ -0,0 +1,391 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file fault_recorder.c
+ *
+ * @brief This module captures control loop samples around a fault and logs
+ * fault events in flash.
+ *
+ * Component: FAULT RECORDER
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "fault_recorder.h"
+#include "flash.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLES ">
+
+/* Flash pages reserved for fault log, not loaded when the device is
+   programmed, erased entries read as FAULT_LOG_ENTRY_ERASED. The pages are 
+   written through NVM controller, volatile keeps the compiler from folding
+   reads of the uninitialized constant to zero */
+static volatile const MCAPP_FAULT_LOG_ENTRY_T
+    faultLog[FAULT_LOG_PAGES][FAULT_LOG_ENTRIES] __attribute__((space(prog),
+                                    aligned(FLASH_PAGE_SIZE_BYTES), noload));
+
+// </editor-fold>
+
+/**
+* <B> Function: MCAPP_FaultRecorderInit(MCAPP_FAULT_RECORDER_T *) </B>
+*
+* @brief Function to initialize the fault recorder. Flash log pages are 
+*        scanned for the first erased entry, the log is continued in the page
+*        with the latest sequence number.
+*
+* @param Pointer to fault recorder data structure.
+* @return none.
+*
+* @example
+* <CODE> MCAPP_FaultRecorderInit(&faultRecorder); </CODE>
+*
+*/
+void MCAPP_FaultRecorderInit(MCAPP_FAULT_RECORDER_T *pRecorder)
+{
+    uint32_t page, index;
+    uint32_t count[FAULT_LOG_PAGES], last[FAULT_LOG_PAGES];
+
+    pRecorder->faultPrev = 0;
+    pRecorder->controlFaultPrev = 0;
+    pRecorder->tickCounter = 0;
+    pRecorder->timestamp = 0;
+    pRecorder->logDropped = 0;
+    pRecorder->queueHead = 0;
+    pRecorder->queueTail = 0;
+    pRecorder->sequence = 0;
+
+    for(page = 0; page < FAULT_LOG_PAGES; page++)
+    {
+        last[page] = 0;
+        for(index = 0; index < FAULT_LOG_ENTRIES; index++)
+        {
+            if(faultLog[page][index].sequence == FAULT_LOG_ENTRY_ERASED)
+            {
+                break;
+            }
+            last[page] = faultLog[page][index].sequence;
+        }
+        count[page] = index;
+    }
+
+    /* Page with the latest entry is written, the other page is older */
+    pRecorder->logPage = 0;
+    if((count[1] != 0) && ((count[0] == 0) || (last[1] > last[0])))
+    {
+        pRecorder->logPage = 1;
+    }
+    pRecorder->logNext = count[pRecorder->logPage];
+    pRecorder->logPrevious = count[pRecorder->logPage ^ 1];
+    if(pRecorder->logNext != 0)
+    {
+        pRecorder->sequence = last[pRecorder->logPage] + 1;
+    }
+
+    MCAPP_FaultRecorderArm(pRecorder);
+}
+
+/**
+* <B> Function: MCAPP_FaultRecorderArm(MCAPP_FAULT_RECORDER_T *) </B>
+*
+* @brief Function to discard the captured samples and restart the capture.
+*
+* @param Pointer to fault recorder data structure.
+* @return none.
+*
+* @example
+* <CODE> MCAPP_FaultRecorderArm(&faultRecorder); </CODE>
+*
+*/
+void MCAPP_FaultRecorderArm(MCAPP_FAULT_RECORDER_T *pRecorder)
+{
+    pRecorder->index = 0;
+    pRecorder->postCounter = FAULT_RECORDER_POST_SAMPLES;
+    pRecorder->state = FAULT_RECORDER_ARMED;
+}
+
+/**
+* <B> Function: MCAPP_FaultRecorderUpdate(MCAPP_FAULT_RECORDER_T *,
+*                   const MCAPP_FAULT_SAMPLE_T *, uint32_t, uint32_t, uint32_t)
+* </B>
+*
+* @brief Function to capture a control loop sample and detect fault events.
+*        A new fault status or a new control fault triggers the capture and
+*        queues a log entry. To be called every control loop execution.
+*
+* @param Pointer to fault recorder data structure.
+* @param Pointer to the present sample.
+* @param Fault status from fault detection.
+* @param Fault status from control scheme.
+* @param Application state.
+* @return none.
+*
+* @example
+* <CODE> MCAPP_FaultRecorderUpdate(&faultRecorder, &sample, faultStatus,
+*                                       controlFaultStatus, appState); </CODE>
+*
+*/
+void MCAPP_FaultRecorderUpdate(MCAPP_FAULT_RECORDER_T *pRecorder,
+                    const MCAPP_FAULT_SAMPLE_T *pSample, uint32_t faultStatus,
+                    uint32_t controlFaultStatus, uint32_t appState)
+{
+    MCAPP_FAULT_LOG_ENTRY_T *pEntry;
+    uint32_t head;
+
+    if(++pRecorder->tickCounter >= FAULT_RECORDER_TICKS_PER_MS)
+    {
+        pRecorder->tickCounter = 0;
+        pRecorder->timestamp++;
+    }
+
+    if(pRecorder->state != FAULT_RECORDER_FROZEN)
+    {
+        pRecorder->buffer[pRecorder->index] = *pSample;
+        if(++pRecorder->index >= FAULT_RECORDER_SAMPLES)
+        {
+            pRecorder->index = 0;
+        }
+        if(pRecorder->state == FAULT_RECORDER_TRIGGERED)
+        {
+            if(pRecorder->postCounter > 0)
+            {
+                pRecorder->postCounter--;
+            }
+            if(pRecorder->postCounter == 0)
+            {
+                pRecorder->state = FAULT_RECORDER_FROZEN;
+            }
+        }
+    }
+
+    if(((faultStatus != 0) && (faultStatus != pRecorder->faultPrev)) ||
+        ((controlFaultStatus != 0) && (pRecorder->controlFaultPrev == 0)))
+    {
+        if(pRecorder->state == FAULT_RECORDER_ARMED)
+        {
+            if(pRecorder->postCounter == 0)
+            {
+                pRecorder->state = FAULT_RECORDER_FROZEN;
+            }
+            else
+            {
+                pRecorder->state = FAULT_RECORDER_TRIGGERED;
+            }
+        }
+
+        head = pRecorder->queueHead + 1;
+        if(head >= FAULT_LOG_QUEUE_SIZE)
+        {
+            head = 0;
+        }
+        if(head == pRecorder->queueTail)
+        {
+            pRecorder->logDropped++;
+        }
+        else
+        {
+            pEntry = &pRecorder->queue[pRecorder->queueHead];
+            pEntry->timestamp = pRecorder->timestamp;
+            pEntry->faultStatus = faultStatus;
+            pEntry->speed = pSample->speed;
+            pEntry->appState = (uint8_t)appState;
+            pEntry->controlFaultStatus = (uint8_t)controlFaultStatus;
+            pRecorder->queueHead = head;
+        }
+    }
+    pRecorder->faultPrev = faultStatus;
+    pRecorder->controlFaultPrev = controlFaultStatus;
+}
+
+/**
+* <B> Function: MCAPP_FaultRecorderLogWrite(MCAPP_FAULT_RECORDER_T *) </B>
+*
+* @brief Function to write the queued fault events to the flash log. When 
+*        the page is full, the older page is erased and written next. An 
+*        event is dropped if the erase or the write fails. CPU is stalled 
+*        during flash operations, to be called from main loop only when the
+*        motor is not running.
+*
+* @param Pointer to fault recorder data structure.
+* @return none.
+*
+* @example
+* <CODE> MCAPP_FaultRecorderLogWrite(&faultRecorder); </CODE>
+*
+*/
+void MCAPP_FaultRecorderLogWrite(MCAPP_FAULT_RECORDER_T *pRecorder)
+{
+    MCAPP_FAULT_LOG_ENTRY_T *pEntry;
+    uint32_t tail, page;
+    bool written;
+
+    while(pRecorder->queueTail != pRecorder->queueHead)
+    {
+        tail = pRecorder->queueTail;
+        written = false;
+        if(pRecorder->logNext >= FAULT_LOG_ENTRIES)
+        {
+            /* Full page becomes the older page */
+            page = pRecorder->logPage ^ 1;
+            if(FLASH_PageErase((uint32_t)(uintptr_t)&faultLog[page][0]))
+            {
+                pRecorder->logPrevious = pRecorder->logNext;
+                pRecorder->logPage = page;
+                pRecorder->logNext = 0;
+            }
+            else
+            {
+                /* Entries of the older page are no longer valid */
+                pRecorder->logPrevious = 0;
+            }
+        }
+
+        pEntry = &pRecorder->queue[tail];
+        if(pRecorder->logNext < FAULT_LOG_ENTRIES)
+        {
+            pEntry->sequence = pRecorder->sequence;
+            written = FLASH_QuadWordWrite((uint32_t)(uintptr_t)
+                        &faultLog[pRecorder->logPage][pRecorder->logNext],
+                                                    (const uint32_t *)pEntry);
+        }
+        if(written)
+        {
+            pRecorder->logNext++;
+            pRecorder->sequence++;
+        }
+        else
+        {
+            pRecorder->logDropped++;
+        }
+
+        if(++tail >= FAULT_LOG_QUEUE_SIZE)
+        {
+            tail = 0;
+        }
+        pRecorder->queueTail = tail;
+    }
+}
+
+/**
+* <B> Function: MCAPP_FaultRecorderLogCount(MCAPP_FAULT_RECORDER_T *) </B>
+*
+* @brief Function to read the number of entries in the flash log.
+*
+* @param Pointer to fault recorder data structure.
+* @return Number of log entries.
+*
+* @example
+* <CODE> count = MCAPP_FaultRecorderLogCount(&faultRecorder); </CODE>
+*
+*/
+uint32_t MCAPP_FaultRecorderLogCount(MCAPP_FAULT_RECORDER_T *pRecorder)
+{
+    return pRecorder->logNext + pRecorder->logPrevious;
+}
+
+/**
+* <B> Function: MCAPP_FaultRecorderLogGet(MCAPP_FAULT_RECORDER_T *, uint32_t,
+*                                               MCAPP_FAULT_LOG_ENTRY_T *) </B>
+*
+* @brief Function to read an entry of the flash log.
+*
+* @param Pointer to fault recorder data structure.
+* @param Entry index, 0 = latest fault event.
+* @param Pointer to the entry to be updated.
+* @return true if the entry exists.
+*
+* @example
+* <CODE> MCAPP_FaultRecorderLogGet(&faultRecorder, 0, &entry); </CODE>
+*
+*/
+bool MCAPP_FaultRecorderLogGet(MCAPP_FAULT_RECORDER_T *pRecorder,
+                            uint32_t index, MCAPP_FAULT_LOG_ENTRY_T *pEntry)
+{
+    if(index < pRecorder->logNext)
+    {
+        *pEntry = faultLog[pRecorder->logPage][pRecorder->logNext - 1 - index];
+        return true;
+    }
+    index -= pRecorder->logNext;
+    if(index < pRecorder->logPrevious)
+    {
+        *pEntry = faultLog[pRecorder->logPage ^ 1]
+                                        [pRecorder->logPrevious - 1 - index];
+        return true;
+    }
+    return false;
+}
+
+/**
+* <B> Function: MCAPP_FaultRecorderSampleGet(MCAPP_FAULT_RECORDER_T *,
+*                                       uint32_t, MCAPP_FAULT_SAMPLE_T *) </B>
+*
+* @brief Function to read a sample of the frozen capture buffer. Fault is
+*        detected at sample FAULT_RECORDER_SAMPLES -
+*        FAULT_RECORDER_POST_SAMPLES - 1.
+*
+* @param Pointer to fault recorder data structure.
+* @param Sample index, 0 = oldest sample.
+* @param Pointer to the sample to be updated.
+* @return true if the capture is frozen and the index is valid.
+*
+* @example
+* <CODE> MCAPP_FaultRecorderSampleGet(&faultRecorder, 0, &sample); </CODE>
+*
+*/
+bool MCAPP_FaultRecorderSampleGet(MCAPP_FAULT_RECORDER_T *pRecorder,
+                                uint32_t index, MCAPP_FAULT_SAMPLE_T *pSample)
+{
+    if((pRecorder->state != FAULT_RECORDER_FROZEN) ||
+                                            (index >= FAULT_RECORDER_SAMPLES))
+    {
+        return false;
+    }
+    index += pRecorder->index;
+    if(index >= FAULT_RECORDER_SAMPLES)
+    {
+        index -= FAULT_RECORDER_SAMPLES;
+    }
+    *pSample = pRecorder->buffer[index];
+    return true;
+}
@@ -0,0 +1,197 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file fault_recorder.h
+ *
+ * @brief This header file lists data type definitions and interface functions
+ * of the fault recorder. Control loop samples are captured continuously in a
+ * circular buffer, which is frozen a number of samples after a fault is
+ * detected. Each fault event is logged with a time stamp in a flash page,
+ * so that the fault history is retained over power cycles.
+ *
+ * Component: FAULT RECORDER
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+#ifndef __FAULT_RECORDER_H
+#define __FAULT_RECORDER_H
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "flash.h"
+
+// </editor-fold>
+
+#ifdef __cplusplus  // Provide C++ Compatability
+    extern "C" {
+#endif
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/CONSTANTS ">
+
+/* Control loop samples in capture buffer, 128 x 50us = 6.4ms */
+#define FAULT_RECORDER_SAMPLES          128
+/* Samples captured after the fault, remaining samples are before the fault */
+#define FAULT_RECORDER_POST_SAMPLES     32
+/* Control loop executions per millisecond, for the time stamp */
+#define FAULT_RECORDER_TICKS_PER_MS     20
+
+/* Fault events waiting to be written to flash */
+#define FAULT_LOG_QUEUE_SIZE            4
+/* Flash pages of fault log, written alternately. The older page is erased 
+   when the newer one is full, so that a full page of history is retained */
+#define FAULT_LOG_PAGES                 2
+/* Fault log entries in a flash page */
+#define FAULT_LOG_ENTRIES   (FLASH_PAGE_SIZE_BYTES / sizeof(MCAPP_FAULT_LOG_ENTRY_T))
+/* Sequence number of erased log entry */
+#define FAULT_LOG_ENTRY_ERASED          0xFFFFFFFFUL
+
+#if (FAULT_LOG_PAGES != 2)
+#error "FAULT_LOG_PAGES must be 2, the pages are written alternately"
+#endif
+
+#if (FAULT_RECORDER_POST_SAMPLES >= FAULT_RECORDER_SAMPLES)
+#error "FAULT_RECORDER_POST_SAMPLES must be less than FAULT_RECORDER_SAMPLES"
+#endif
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="ENUMERATED CONSTANTS ">
+
+typedef enum
+{
+    FAULT_RECORDER_ARMED = 0,       /* Capturing, waiting for a fault */
+    FAULT_RECORDER_TRIGGERED = 1,   /* Capturing samples after the fault */
+    FAULT_RECORDER_FROZEN = 2,      /* Capture complete, buffer can be read */
+}MCAPP_FAULT_RECORDER_STATE_T;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="TYPE DEFINITIONS ">
+
+/**
+ * Control loop sample, scaled to integers to limit the buffer size
+*/
+typedef struct
+{
+    int16_t
+        ia,                 /* Phase currents (mA) */
+        ib,
+        ic,
+        id,
+        va,                 /* Phase voltages (0.1V) */
+        vb,
+        vc,
+        vd;
+    uint16_t
+        theta;              /* Rotor angle, 0 - 65535 for 0 - 2pi */
+    int16_t
+        speed;              /* Signed speed (RPM) */
+    uint8_t
+        phaseOn,            /* Commutated phase */
+        switchState;        /* Switch state of hysteresis current control */
+} MCAPP_FAULT_SAMPLE_T;
+
+/**
+ * Fault log entry, size of a flash quad word
+*/
+typedef struct
+{
+    uint32_t
+        sequence,           /* Event number, continued over power cycles */
+        timestamp,          /* Time since power up (ms) */
+        faultStatus;        /* Fault status from fault detection */
+    int16_t
+        speed;              /* Signed speed at the fault (RPM) */
+    uint8_t
+        appState,           /* Application state at the fault */
+        controlFaultStatus; /* Fault status from control scheme */
+} MCAPP_FAULT_LOG_ENTRY_T;
+
+/**
+ * Fault recorder data type
+*/
+typedef struct
+{
+    uint32_t
+        state,              /* Capture state MCAPP_FAULT_RECORDER_STATE_T */
+        index,              /* Buffer index of the next sample */
+        postCounter,        /* Samples to be captured after the fault */
+        faultPrev,          /* Fault status of previous execution */
+        controlFaultPrev,   /* Control fault status of previous execution */
+        tickCounter,        /* Executions in the present millisecond */
+        timestamp,          /* Time since power up (ms) */
+        sequence,           /* Sequence number of the next log entry */
+        logPage,            /* Flash log page being written */
+        logNext,            /* Index of the next free entry in logPage */
+        logPrevious,        /* Entries in the older flash log page */
+        logDropped;         /* Fault events lost, queue full or flash failed */
+    volatile uint32_t
+        queueHead,          /* Written in control loop */
+        queueTail;          /* Read in main loop */
+
+    MCAPP_FAULT_LOG_ENTRY_T
+        queue[FAULT_LOG_QUEUE_SIZE];
+
+    MCAPP_FAULT_SAMPLE_T
+        buffer[FAULT_RECORDER_SAMPLES];
+} MCAPP_FAULT_RECORDER_T;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+
+void MCAPP_FaultRecorderInit(MCAPP_FAULT_RECORDER_T *);
+void MCAPP_FaultRecorderArm(MCAPP_FAULT_RECORDER_T *);
+void MCAPP_FaultRecorderUpdate(MCAPP_FAULT_RECORDER_T *,
+                        const MCAPP_FAULT_SAMPLE_T *, uint32_t, uint32_t, uint32_t);
+void MCAPP_FaultRecorderLogWrite(MCAPP_FAULT_RECORDER_T *);
+uint32_t MCAPP_FaultRecorderLogCount(MCAPP_FAULT_RECORDER_T *);
+bool MCAPP_FaultRecorderLogGet(MCAPP_FAULT_RECORDER_T *, uint32_t,
+                                                    MCAPP_FAULT_LOG_ENTRY_T *);
+bool MCAPP_FaultRecorderSampleGet(MCAPP_FAULT_RECORDER_T *, uint32_t,
+                                                    MCAPP_FAULT_SAMPLE_T *);
+
+// </editor-fold>
+
+#ifdef __cplusplus  // Provide C++ Compatibility
+    }
+#endif
+#endif      // end of __FAULT_RECORDER_H
@@ -68,12 +68,16 @@
 #define ADCBUF_IB     (int16_t)(2048 - AD2CH0DATA)<<4
 #define ADCBUF_IC     (int16_t)(2048 - AD2CH1DATA)<<4
 #define ADCBUF_ID     (int16_t)(2048 - AD1CH1DATA)<<4
+/* ADC count of a phase current sample in ADCBUF_Ix scaling */
+#define ADCBUF_CURRENT_TO_COUNT(x)    (int32_t)(2048 - ((x)>>4))
         
 #else     
 #define ADCBUF_IA     (int16_t)(AD1CH0DATA - 2048)<<4
 #define ADCBUF_IB     (int16_t)(AD2CH0DATA - 2048)<<4
 #define ADCBUF_IC     (int16_t)(AD2CH1DATA - 2048)<<4
 #define ADCBUF_ID     (int16_t)(AD1CH1DATA - 2048)<<4
+/* ADC count of a phase current sample in ADCBUF_Ix scaling */
+#define ADCBUF_CURRENT_TO_COUNT(x)    (int32_t)(2048 + ((x)>>4))
 #endif 
 
 #define ADCBUF_VDC    (int16_t)AD1CH2DATA         
@@ -56,6 +56,7 @@
 #include "mc1_user_params.h"
 
 #include "spi1.h"
+#include "cmp.h"
 
 #include "delay.h"
 
@@ -68,13 +69,24 @@ BUTTON_T buttonChangeDirection;
 uint16_t boardServiceISRCounter = 0;
 
 /* PWM Switching Array */
-const uint32_t pwmCtrlState[4] = { PWM_DISABLE, PWM_FULL_ON,  PWM_HALF_ON,  CHG_BOOT_CAP };
+const uint32_t pwmCtrlState[5] = { PWM_DISABLE, PWM_FULL_ON,  PWM_HALF_ON,  CHG_BOOT_CAP,
+                                    PWM_HW_CHOPPING };
+
+#ifdef HARDWARE_HCC
+/* Phase current offsets in ADCBUF_Ix scaling for computing DAC thresholds */
+int32_t hccOffsetIa = 0;
+int32_t hccOffsetIb = 0;
+int32_t hccOffsetId = 0;
+#endif
 // </editor-fold>
 
 // <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
 
 static void ButtonGroupInitialize(void);
 static void ButtonScan(BUTTON_T * ,bool);
+#ifdef HARDWARE_HCC
+static uint32_t HCC_CurrentToDACCount(float, int32_t);
+#endif
 
 // </editor-fold>
 
@@ -287,6 +299,10 @@ void HAL_InitPeripherals(void)
     TIMER1_ModuleStart();
     
     SPI1_Initialize();
+    
+#ifdef HARDWARE_HCC
+    CMP_Initialize();
+#endif
     /* Make sure ADC does not generate interrupt while initializing parameters*/
     MC1_DisableADCInterrupt();  
 }
@@ -361,6 +377,14 @@ void HAL_MC1PWMDisableOutputs(void)
     MC1_PWM_PDC3 = 0;
     MC1_PWM_PDC2 = 0;
     MC1_PWM_PDC1 = 0;
+#ifdef HARDWARE_HCC
+    /* Outputs are held by override, PWM Generators of phases chopped by 
+       comparators are kept at 100% duty so that releasing the override hands
+       over the phase to feed-forward PCI chopping */
+    MC1_PWM_PDC4 = PWM_HCC_CHOP_DUTY;
+    MC1_PWM_PDC2 = PWM_HCC_CHOP_DUTY;
+    MC1_PWM_PDC1 = PWM_HCC_CHOP_DUTY;
+#endif
     
     /** Set Override Data on all PWM outputs */
     /* 0b00 = State for PWM4H,L, if Override is Enabled */
@@ -491,6 +515,101 @@ void ClearPWMPCIFault(void)
     
 }
 
+#ifdef HARDWARE_HCC
+/**
+* <B> Function: HAL_MC1HCCOffsetSet(MCAPP_MEASURE_T *) </B>
+*
+* @brief Function to store the measured phase current offsets used to compute
+*        the comparator DAC thresholds.
+*        
+* @param Pointer to the data structure containing measured parameters.
+* @return none.
+* 
+* @example
+* <CODE> HAL_MC1HCCOffsetSet(&motorInputs); </CODE>
+*
+*/
+void HAL_MC1HCCOffsetSet(MCAPP_MEASURE_T *pMotorInputs)
+{
+    hccOffsetIa = pMotorInputs->measureCurrent.offsetIa;
+    hccOffsetIb = pMotorInputs->measureCurrent.offsetIb;
+    hccOffsetId = pMotorInputs->measureCurrent.offsetId;
+}
+
+/**
+* <B> Function: HAL_MC1HCCThresholdSet(uint32_t, float, float) </B>
+*
+* @brief Function to load the upper and lower current limits of the active 
+*        phase as comparator DAC thresholds.
+*        
+* @param Active phase.
+* @param Upper current limit in amperes.
+* @param Lower current limit in amperes.
+* @return true if the phase current is chopped by comparator, false if the
+*         phase has to be chopped by software HCC.
+* 
+* @example
+* <CODE> HAL_MC1HCCThresholdSet(PHASEA_COMMUTATION, 0.81, 0.79); </CODE>
+*
+*/
+bool HAL_MC1HCCThresholdSet(uint32_t phase, float upperLimit, float lowerLimit)
+{
+    bool status = true;
+    
+    switch (phase)
+    {
+        case PHASEA_COMMUTATION:
+            CMP1_DACThresholdSet(HCC_CurrentToDACCount(upperLimit, hccOffsetIa),
+                    HCC_CurrentToDACCount(lowerLimit, hccOffsetIa));
+            break;
+        case PHASEB_COMMUTATION:
+            CMP2_DACThresholdSet(HCC_CurrentToDACCount(upperLimit, hccOffsetIb),
+                    HCC_CurrentToDACCount(lowerLimit, hccOffsetIb));
+            break;
+        case PHASED_COMMUTATION:
+            CMP3_DACThresholdSet(HCC_CurrentToDACCount(upperLimit, hccOffsetId),
+                    HCC_CurrentToDACCount(lowerLimit, hccOffsetId));
+            break;
+        default:
+            /* Phase C current is not connected to a comparator */
+            status = false;
+            break;
+    }
+    return status;
+}
+
+/**
+* <B> Function: HCC_CurrentToDACCount(float, int32_t) </B>
+*
+* @brief Function to convert phase current to 12-bit DAC count.
+*        
+* @param Phase current in amperes.
+* @param Phase current offset in ADCBUF_Ix scaling.
+* @return DAC count.
+* 
+* @example
+* <CODE> HCC_CurrentToDACCount(0.8, hccOffsetIa); </CODE>
+*
+*/
+static uint32_t HCC_CurrentToDACCount(float current, int32_t offset)
+{
+    int32_t count;
+    
+    count = (int32_t)(current * ADC_CURRENT_SCALE_INVERSE) + offset;
+    count = ADCBUF_CURRENT_TO_COUNT(count);
+    
+    if(count > CMP_DAC_MAX_COUNT)
+    {
+        count = CMP_DAC_MAX_COUNT;
+    }
+    else if(count < 0)
+    {
+        count = 0;
+    }
+    return (uint32_t)count;
+}
+#endif
+
 /* Functions for PWMs ON and OFF  using override */
 /**
 * <B> Function: PWM1_OverrideEnableDataSet(uint32_t) </B>
@@ -136,6 +136,10 @@ void HAL_MC1PWMDisableOutputs(void);
 void HAL_MC1PWMSetDutyCycles(MC_DUTYCYCLEOUT_T *);
 void HAL_MC1MotorInputsRead(MCAPP_MEASURE_T *);
 void ClearPWMPCIFault(void);
+#ifdef HARDWARE_HCC
+void HAL_MC1HCCOffsetSet(MCAPP_MEASURE_T *);
+bool HAL_MC1HCCThresholdSet(uint32_t, float, float);
+#endif
 
 void PWM1_OverrideEnableDataSet(uint32_t);
 void PWM2_OverrideEnableDataSet(uint32_t);
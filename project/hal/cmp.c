@@ -0,0 +1,169 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file cmp.c
+ *
+ * @brief This module configures the high speed analog comparators with DACs
+ * in hysteretic mode for hardware hysteresis current control.
+ *
+ * Definitions in this file are for dsPIC33AK128MC106
+ * Component: CMP
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <xc.h>
+#include <stdint.h>
+
+#include "cmp.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+
+/**
+* <B> Function: CMP_Initialize() </B>
+*
+* @brief Function to configure the comparators CMP1, CMP2 and CMP3 in
+*        hysteretic mode with the positive inputs connected to CMPxA pins.
+*        The DAC thresholds are loaded for zero current, so that the phase
+*        is not chopped until thresholds are loaded by the control.
+*
+* @param none.
+* @return none.
+*
+* @example
+* <CODE> CMP_Initialize(); </CODE>
+*
+*/
+void CMP_Initialize(void)
+{
+    /* DAC Control Register 1 */
+    DACCTRL1 = 0;
+    /* DAC Clock Source Select bits
+       01 = AFPLLO (Auxiliary PLL output) */
+    DACCTRL1bits.CLKSEL = 1;
+    /* DAC Clock Divider bits
+       00 = Divide-by-1 */
+    DACCTRL1bits.CLKDIV = 0;
+    /* Comparator Filter Clock Divider bits
+       000 = Divide-by-1 */
+    DACCTRL1bits.FCLKDIV = 0;
+    
+    /* DAC1 Control Register */
+    DAC1CON = 0;
+    /* Comparator Input Source Select bits
+       000 = CMP1A pin */
+    DAC1CONbits.INSEL = 0;
+    /* Comparator Output Polarity Control bit */
+    DAC1CONbits.CMPPOL = CMP_HCC_OUTPUT_POLARITY;
+    /* Comparator Hysteresis Select bits
+       01 = 15 mV hysteresis */
+    DAC1CONbits.HYSSEL = 1;
+    /* Comparator Digital Filter Enable bit */
+    DAC1CONbits.FLTREN = 1;
+    /* DAC1 output is not connected to DACOUT pin */
+    DAC1CONbits.DACOEN = 0;
+    /* Slope Generator Enable bit - required for hysteretic mode */
+    SLP1CONbits.SLOPEN = 1;
+    /* Hysteretic Mode Enable bit
+       1 = DAC output toggles between DACDATH and DACDATL based on 
+           comparator output */
+    SLP1CONbits.HME = 1;
+    SLP1CONbits.TWME = 0;
+    SLP1CONbits.PSE = 0;
+    CMP1_DACThresholdSet(CMP_DAC_MID_COUNT, CMP_DAC_MID_COUNT);
+    
+    /* DAC2 Control Register */
+    DAC2CON = 0;
+    /* Comparator Input Source Select bits
+       000 = CMP2A pin */
+    DAC2CONbits.INSEL = 0;
+    /* Comparator Output Polarity Control bit */
+    DAC2CONbits.CMPPOL = CMP_HCC_OUTPUT_POLARITY;
+    /* Comparator Hysteresis Select bits
+       01 = 15 mV hysteresis */
+    DAC2CONbits.HYSSEL = 1;
+    /* Comparator Digital Filter Enable bit */
+    DAC2CONbits.FLTREN = 1;
+    /* DAC2 output is not connected to DACOUT pin */
+    DAC2CONbits.DACOEN = 0;
+    /* Slope Generator Enable bit - required for hysteretic mode */
+    SLP2CONbits.SLOPEN = 1;
+    /* Hysteretic Mode Enable bit
+       1 = DAC output toggles between DACDATH and DACDATL based on 
+           comparator output */
+    SLP2CONbits.HME = 1;
+    SLP2CONbits.TWME = 0;
+    SLP2CONbits.PSE = 0;
+    CMP2_DACThresholdSet(CMP_DAC_MID_COUNT, CMP_DAC_MID_COUNT);
+    
+    /* DAC3 Control Register */
+    DAC3CON = 0;
+    /* Comparator Input Source Select bits
+       000 = CMP3A pin */
+    DAC3CONbits.INSEL = 0;
+    /* Comparator Output Polarity Control bit */
+    DAC3CONbits.CMPPOL = CMP_HCC_OUTPUT_POLARITY;
+    /* Comparator Hysteresis Select bits
+       01 = 15 mV hysteresis */
+    DAC3CONbits.HYSSEL = 1;
+    /* Comparator Digital Filter Enable bit */
+    DAC3CONbits.FLTREN = 1;
+    /* DAC3 output is not connected to DACOUT pin */
+    DAC3CONbits.DACOEN = 0;
+    /* Slope Generator Enable bit - required for hysteretic mode */
+    SLP3CONbits.SLOPEN = 1;
+    /* Hysteretic Mode Enable bit
+       1 = DAC output toggles between DACDATH and DACDATL based on 
+           comparator output */
+    SLP3CONbits.HME = 1;
+    SLP3CONbits.TWME = 0;
+    SLP3CONbits.PSE = 0;
+    CMP3_DACThresholdSet(CMP_DAC_MID_COUNT, CMP_DAC_MID_COUNT);
+    
+    /* Common DAC module Enable bit */
+    DACCTRL1bits.ON = 1;
+
+    DAC1CONbits.DACEN = 1;
+    DAC2CONbits.DACEN = 1;
+    DAC3CONbits.DACEN = 1;
+}
+
+// </editor-fold>
@@ -0,0 +1,134 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file cmp.h
+ *
+ * @brief This header file lists the functions and definitions to configure the
+ * high speed analog comparators with DACs used for hardware hysteresis
+ * current control.
+ *
+ * Definitions in this file are for dsPIC33AK128MC106
+ * Component: CMP
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+#ifndef __CMP_H
+#define __CMP_H
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <xc.h>
+#include <stdint.h>
+
+#include "mc1_user_params.h"
+
+// </editor-fold>
+
+#ifdef __cplusplus  // Provide C++ Compatability
+    extern "C" {
+#endif
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/CONSTANTS ">
+
+/* Comparator used for each phase current
+   CMP1 - CMP1A(RA2) - Phase A current
+   CMP2 - CMP2A(RB0) - Phase B current
+   CMP3 - CMP3A(RA5) - Phase D current
+   Phase C current (RA8) is not routed to a comparator input */
+/* PCI source number of the comparator outputs used as feed-forward PCI */
+#define CMP1_PCI_SOURCE             27
+#define CMP2_PCI_SOURCE             28
+#define CMP3_PCI_SOURCE             29
+
+/* Maximum count of the 12-bit DAC */
+#define CMP_DAC_MAX_COUNT           4095
+/* Mid scale DAC count corresponding to zero current */
+#define CMP_DAC_MID_COUNT           2048
+
+/* Comparator output polarity - current sensor output decreases with current
+   for Allegro CT110, hence the comparator output is inverted */
+#ifdef ALLEGRO_CT110_CS
+#define CMP_HCC_OUTPUT_POLARITY     1
+#else
+#define CMP_HCC_OUTPUT_POLARITY     0
+#endif
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+
+void CMP_Initialize(void);
+
+/**
+* <B> Function: CMPx_DACThresholdSet(uint32_t, uint32_t) </B>
+*
+* @brief Functions to load the hysteretic DAC thresholds of a comparator.
+*        DACDATH is the threshold at which the comparator output trips and
+*        DACDATL is the threshold at which the comparator output releases.
+*
+* @param DAC count at which the comparator trips.
+* @param DAC count at which the comparator releases.
+* @return none.
+*
+* @example
+* <CODE> CMP1_DACThresholdSet(2400, 2300); </CODE>
+*
+*/
+inline static void CMP1_DACThresholdSet(uint32_t tripCount, uint32_t releaseCount)
+{
+    DAC1DATbits.DACDATH = tripCount;
+    DAC1DATbits.DACDATL = releaseCount;
+}
+inline static void CMP2_DACThresholdSet(uint32_t tripCount, uint32_t releaseCount)
+{
+    DAC2DATbits.DACDATH = tripCount;
+    DAC2DATbits.DACDATL = releaseCount;
+}
+inline static void CMP3_DACThresholdSet(uint32_t tripCount, uint32_t releaseCount)
+{
+    DAC3DATbits.DACDATH = tripCount;
+    DAC3DATbits.DACDATL = releaseCount;
+}
+
+// </editor-fold>
+
+#ifdef __cplusplus  // Provide C++ Compatability
+    }
+#endif
+
+#endif      // end of __CMP_H
@@ -68,13 +68,13 @@
 #pragma config FDEVOPT_SPI2PIN = OFF    // SPI2 peripheral pin selection disable bit (SPI2 pins are selected by peripheral pin selection feature)
 
 // FWDT
-#pragma config FWDT_WINDIS = OFF        // Watchdog Timer Window Disable bit (Watchdog Timer operates in Window mode)
+#pragma config FWDT_WINDIS = ON         // Watchdog Timer Window Disable bit (Watchdog Timer operates in Non-Window mode)
 #pragma config FWDT_SWDTMPS = PS2147483648// Sleep Mode Watchdog Timer Post Scaler select bits (1:2147483648)
 #pragma config FWDT_RCLKSEL = BFRC256   // Watchdog Timer Clock select bits (WDT Run Mode uses BFRC:256)
-#pragma config FWDT_RWDTPS = PS2147483648// Run Mode Watchdog Timer Post Scaler select bits (1:2147483648)
+#pragma config FWDT_RWDTPS = PS4096     // Run Mode Watchdog Timer Post Scaler select bits (1:4096, 131ms with BFRC:256)
 #pragma config FWDT_WDTWIN = WIN25      // Watchdog Timer Window Size Select bits (WDT Window is 25% of WDT period)
 #pragma config FWDT_WDTEN = SW          // Watchdog Timer Enable bit (WDT is controlled by software, use WDTCON.ON bit)
-#pragma config FWDT_WDTRSTEN = OFF      // Watchdog Timer Reset Enable bit (WDT event generates a trap)
+#pragma config FWDT_WDTRSTEN = ON       // Watchdog Timer Reset Enable bit (WDT event generates a reset)
 
 // FPR0CTRL
 #pragma config FPR0CTRL_RDIS = ON       // Region protection disable bit (Protection is disabled)
@@ -0,0 +1,166 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * flash.c
+ *
+ * This file includes subroutines to erase and program the program flash
+ * memory. CPU execution from flash is stalled while an operation is in
+ * progress, hence these functions are to be called only when the motor is
+ * not running.
+ *
+ * Definitions in this file are for dsPIC33AK128MC106.
+ *
+ * Component: FLASH
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <xc.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "flash.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
+
+static bool FLASH_OperationExecute(uint32_t);
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+
+/**
+* <B> Function: FLASH_PageErase(uint32_t) </B>
+*
+* @brief Function to erase a page of program flash memory.
+*
+* @param Address of the page, aligned to FLASH_PAGE_SIZE_BYTES.
+* @return true if the operation is completed without error.
+*
+* @example
+* <CODE> FLASH_PageErase(address); </CODE>
+*
+*/
+bool FLASH_PageErase(uint32_t address)
+{
+    if((address & (FLASH_PAGE_SIZE_BYTES - 1)) != 0)
+    {
+        return false;
+    }
+
+    NVMADR = address;
+
+    return FLASH_OperationExecute(FLASH_OPERATION_PAGE_ERASE);
+}
+
+/**
+* <B> Function: FLASH_QuadWordWrite(uint32_t, const uint32_t *) </B>
+*
+* @brief Function to program a quad word (four 32 bit words) of erased
+*        program flash memory.
+*
+* @param Address of the quad word, aligned to FLASH_QUAD_WORD_BYTES.
+* @param Pointer to four words of data.
+* @return true if the operation is completed without error.
+*
+* @example
+* <CODE> FLASH_QuadWordWrite(address, data); </CODE>
+*
+*/
+bool FLASH_QuadWordWrite(uint32_t address, const uint32_t *pData)
+{
+    if((address & (FLASH_QUAD_WORD_BYTES - 1)) != 0)
+    {
+        return false;
+    }
+
+    NVMADR = address;
+    NVMDATA0 = pData[0];
+    NVMDATA1 = pData[1];
+    NVMDATA2 = pData[2];
+    NVMDATA3 = pData[3];
+
+    return FLASH_OperationExecute(FLASH_OPERATION_QUAD_WORD_PROGRAM);
+}
+
+// </editor-fold>
+
+/**
+* <B> Function: FLASH_OperationExecute(uint32_t) </B>
+*
+* @brief Function to start an NVM operation with the unlock sequence and wait
+*        for its completion. Interrupts are disabled during unlock sequence.
+*
+* @param NVM operation FLASH_OPERATION_TYPE.
+* @return true if the operation is completed without error.
+*
+* @example
+* <CODE> FLASH_OperationExecute(FLASH_OPERATION_PAGE_ERASE); </CODE>
+*
+*/
+static bool FLASH_OperationExecute(uint32_t operation)
+{
+    uint32_t isrState;
+
+    /** NVMOP<3:0>: NVM Operation Select bits */
+    NVMCONbits.NVMOP = operation;
+    /** WREN: Write Enable bit, 1 = Enables program/erase operations */
+    NVMCONbits.WREN = 1;
+
+    isrState = __builtin_get_isr_state();
+    __builtin_disable_interrupts();
+    NVMKEY = 0;
+    NVMKEY = FLASH_UNLOCK_KEY1;
+    NVMKEY = FLASH_UNLOCK_KEY2;
+    /** WR: Write Control bit, set to start the operation, cleared by hardware
+        when the operation is complete */
+    NVMCONbits.WR = 1;
+    __builtin_set_isr_state(isrState);
+
+    while(NVMCONbits.WR == 1)
+    {
+    }
+
+    NVMCONbits.WREN = 0;
+
+    /** WRERR: Write Sequence Error Flag bit */
+    return (NVMCONbits.WRERR == 0);
+}
@@ -0,0 +1,100 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file flash.h
+ *
+ * @brief This header file lists interface functions - to erase and program
+ * the program flash memory through the NVM controller
+ *
+ * Definitions in this file are for dsPIC33AK128MC106
+ *
+ * Component: FLASH
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+#ifndef __FLASH_H
+#define __FLASH_H
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <xc.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// </editor-fold>
+
+#ifdef __cplusplus  // Provide C++ Compatability
+    extern "C" {
+#endif
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/CONSTANTS ">
+
+/* Size of flash page, the smallest erasable block */
+#define FLASH_PAGE_SIZE_BYTES       4096UL
+/* Size of quad word, the smallest programmable block */
+#define FLASH_QUAD_WORD_BYTES       16UL
+
+/* NVMKEY unlock sequence */
+#define FLASH_UNLOCK_KEY1           0xAA996655UL
+#define FLASH_UNLOCK_KEY2           0x556699AAUL
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="TYPE DEFINITIONS ">
+
+/** NVMOP<3:0>: NVM Operation Select bits */
+typedef enum tagFLASH_OPERATION
+{
+    FLASH_OPERATION_QUAD_WORD_PROGRAM   = 2,
+    FLASH_OPERATION_PAGE_ERASE          = 3,
+}FLASH_OPERATION_TYPE;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+
+bool FLASH_PageErase(uint32_t);
+bool FLASH_QuadWordWrite(uint32_t, const uint32_t *);
+
+// </editor-fold>
+
+#ifdef __cplusplus  // Provide C++ Compatibility
+    }
+#endif
+#endif      // end of __FLASH_H
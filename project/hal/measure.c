@@ -49,6 +49,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stdlib.h>
 
 #include "measure.h"
 #include "mc1_user_params.h"
@@ -84,6 +85,7 @@ void MCAPP_MeasureCurrentInit(MCAPP_MEASURE_T *pMotorInputs)
     pCurrent->sumIc = 0;
     pCurrent->sumId = 0;
     pCurrent->sumIbus = 0;
+    pCurrent->countBits = OFFSET_COUNT_BITS;
     pCurrent->status = 0;  
 }
 
@@ -113,14 +115,14 @@ void MCAPP_MeasureCurrentOffset(MCAPP_MEASURE_T *pMotorInputs)
     pCurrent->sumIbus += pCurrent->Ibus;
     pCurrent->counter++;
 
-    if (pCurrent->counter >= OFFSET_COUNT_MAX)
+    if (pCurrent->counter >= (1UL << pCurrent->countBits))
     {
-        pCurrent->offsetIa   = (int32_t)(pCurrent->sumIa >> OFFSET_COUNT_BITS);
-        pCurrent->offsetIb   = (int32_t)(pCurrent->sumIb >> OFFSET_COUNT_BITS);
-        pCurrent->offsetIc   = (int32_t)(pCurrent->sumIc >> OFFSET_COUNT_BITS);
-        pCurrent->offsetId   = (int32_t)(pCurrent->sumId >> OFFSET_COUNT_BITS);
+        pCurrent->offsetIa   = (int32_t)(pCurrent->sumIa >> pCurrent->countBits);
+        pCurrent->offsetIb   = (int32_t)(pCurrent->sumIb >> pCurrent->countBits);
+        pCurrent->offsetIc   = (int32_t)(pCurrent->sumIc >> pCurrent->countBits);
+        pCurrent->offsetId   = (int32_t)(pCurrent->sumId >> pCurrent->countBits);
         pCurrent->offsetIbus =
-            (int32_t)(pCurrent->sumIbus >> OFFSET_COUNT_BITS);
+            (int32_t)(pCurrent->sumIbus >> pCurrent->countBits);
 
         pCurrent->counter = 0;
         pCurrent->sumIa   = 0;
@@ -212,3 +214,53 @@ uint32_t MCAPP_MeasureCurrentOffsetStatus (MCAPP_MEASURE_T *pMotorInputs)
 {
     return pMotorInputs->measureCurrent.status;
 }
+
+/**
+* <B> Function: MCAPP_MeasureCurrentOffsetValid(MCAPP_MEASURE_T *)  </B>
+*
+* @brief Function to check the measured phase current offsets are within the
+*        limit, an offset out of limit indicates a faulty current sensing 
+*        circuit or phase current flowing during offset measurement.
+*        
+* @param Pointer to the data structure containing measured current.
+* @return 1 if all phase current offsets are valid.
+* 
+* @example
+* <CODE> MCAPP_MeasureCurrentOffsetValid(&current); </CODE>
+*
+*/
+uint32_t MCAPP_MeasureCurrentOffsetValid (MCAPP_MEASURE_T *pMotorInputs)
+{
+    MCAPP_MEASURE_CURRENT_T *pCurrent = &pMotorInputs->measureCurrent;
+    
+    if( (labs(pCurrent->offsetIa) > pCurrent->offsetLimit) ||
+        (labs(pCurrent->offsetIb) > pCurrent->offsetLimit) ||
+        (labs(pCurrent->offsetIc) > pCurrent->offsetLimit) ||
+        (labs(pCurrent->offsetId) > pCurrent->offsetLimit) )
+    {
+        return 0;
+    }
+    return 1;
+}
+
+/**
+* <B> Function: MCAPP_MeasureVdcFilter(MCAPP_MEASURE_T *)  </B>
+*
+* @brief Function to low pass filter the measured DC bus voltage, filtered
+*        value is used for supervision and compensation so that ripple and 
+*        noise of the DC bus do not cause false faults.
+*        
+* @param Pointer to the data structure containing measured DC bus voltage.
+* @return none.
+* 
+* @example
+* <CODE> MCAPP_MeasureVdcFilter(&motorInputs); </CODE>
+*
+*/
+void MCAPP_MeasureVdcFilter(MCAPP_MEASURE_T *pMotorInputs)
+{
+    MCAPP_MEASURE_VDC_T *pVdc = &pMotorInputs->measureVdc;
+    
+    pVdc->filtered = pVdc->filtered + 
+                        (pVdc->value - pVdc->filtered) * pVdc->filterGain;
+}
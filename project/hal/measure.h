@@ -82,6 +82,7 @@ typedef struct
         offsetIc,       /* C phase current offset */
         offsetId,       /* D phase current offset */
         offsetIbus,     /* BUS current offset */
+        offsetLimit,    /* Maximum magnitude of a valid phase current offset */
         sumIa,          /* Accumulation of Ia */
         sumIb,          /* Accumulation of Ib */
         sumIc,          /* Accumulation of Ic */
@@ -91,6 +92,7 @@ typedef struct
         
     uint32_t
         counter,        /* counter */
+        countBits,      /* Number of samples averaged for offset, as power of 2 */
         status;         /* flag to indicate offset measurement completion */ 
 } MCAPP_MEASURE_CURRENT_T;
 
@@ -98,6 +100,8 @@ typedef struct
 {
     float
         value,          /* Measured value of DC Bus Voltage. */
+        filtered,       /* Low pass filtered DC Bus Voltage */
+        filterGain,     /* Gain of low pass filter, sample time / time constant */
         dcMinRun,       /* Minimum voltage for the motor to run */
         dcMaxStop;      /* Maximum voltage at which the motor would stop */
 } MCAPP_MEASURE_VDC_T;
@@ -183,6 +187,8 @@ void MCAPP_MeasureCurrentCalibrate (MCAPP_MEASURE_T *);
 void MCAPP_MeasureCurrentInit (MCAPP_MEASURE_T *);
 void MCAPP_MeasureMotorInputs(MCAPP_MEASURE_T *);
 uint32_t MCAPP_MeasureCurrentOffsetStatus (MCAPP_MEASURE_T *);
+uint32_t MCAPP_MeasureCurrentOffsetValid (MCAPP_MEASURE_T *);
+void MCAPP_MeasureVdcFilter(MCAPP_MEASURE_T *);
 
 // </editor-fold>
 
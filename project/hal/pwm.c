@@ -52,6 +52,7 @@
 #include <stdint.h>
 
 #include "pwm.h"
+#include "cmp.h"
 
 // </editor-fold>
 
@@ -291,7 +292,12 @@ void InitPWMGenerator1 (void)
     /* Data for PWM1H/PWM1L Pins if Feed-Forward Event is Active bits
        If feed-forward is active, then FFDAT<1> provides data for PWM1H.
        If feed-forward is active, then FFDAT<0> provides data for PWM1L.*/
+#ifdef HARDWARE_HCC
+    /* 01 = PWM1L is ON (freewheeling) while comparator output is tripped */
+    PG1IOCONbits.FFDAT = 1;
+#else
     PG1IOCONbits.FFDAT = 0;
+#endif
     /* Data for PWM1H/PWM1L Pins if Debug Mode is Active and PTFRZ = 1 bits
        If Debug mode is active and PTFRZ=1,then DBDAT<1> provides PWM1H data.
        If Debug mode is active and PTFRZ=1,then DBDAT<0> provides PWM1L data. */
@@ -528,6 +534,23 @@ void InitPWMGenerator1 (void)
 
     /* PWM GENERATOR 1 Feed Forward PCI REGISTER LOW */
     PG1FFPCI    = 0x0000;
+#ifdef HARDWARE_HCC
+    /* Feed-forward PCI is driven by comparator CMP1(Phase A current) 
+       for hardware hysteresis current control */
+    /* PCI Source Selection bits */
+    PG1FFPCIbits.PSS = CMP1_PCI_SOURCE;
+    /* PCI Polarity Select bit 0 = Not inverted */
+    PG1FFPCIbits.PPS = 0;
+    /* PCI Synchronization Control bit
+       0 = PCI source is not synchronized to PWM EOC */
+    PG1FFPCIbits.PSYNC = 0;
+    /* PCI Acceptance Criteria Selection bits
+       000 = Level-sensitive */
+    PG1FFPCIbits.ACP = 0;
+    /* Acceptance Qualifier Source Selection bits
+       000 = No acceptance qualifier is used */
+    PG1FFPCIbits.AQSS = 0;
+#endif
     /* PWM GENERATOR 1 Sync PCI REGISTER LOW */
     PG1SPCI     = 0x0000;
     
@@ -653,7 +676,12 @@ void InitPWMGenerator2 (void)
     /* Data for PWM2H/PWM2L Pins if Feed-Forward Event is Active bits
        If feed-forward is active, then FFDAT<1> provides data for PWM2H.
        If feed-forward is active, then FFDAT<0> provides data for PWM2L.*/
+#ifdef HARDWARE_HCC
+    /* 01 = PWM2L is ON (freewheeling) while comparator output is tripped */
+    PG2IOCONbits.FFDAT = 1;
+#else
     PG2IOCONbits.FFDAT = 0;
+#endif
     /* Data for PWM2H/PWM2L Pins if Debug Mode is Active and PTFRZ = 1 bits
        If Debug mode is active and PTFRZ=1,then DBDAT<1> provides PWM2H data.
        If Debug mode is active and PTFRZ=1,then DBDAT<0> provides PWM2L data. */
@@ -892,6 +920,23 @@ void InitPWMGenerator2 (void)
     
     /* PWM GENERATOR 2 Feed Forward PCI REGISTER LOW */
     PG2FFPCI    = 0x0000;
+#ifdef HARDWARE_HCC
+    /* Feed-forward PCI is driven by comparator CMP2(Phase B current) 
+       for hardware hysteresis current control */
+    /* PCI Source Selection bits */
+    PG2FFPCIbits.PSS = CMP2_PCI_SOURCE;
+    /* PCI Polarity Select bit 0 = Not inverted */
+    PG2FFPCIbits.PPS = 0;
+    /* PCI Synchronization Control bit
+       0 = PCI source is not synchronized to PWM EOC */
+    PG2FFPCIbits.PSYNC = 0;
+    /* PCI Acceptance Criteria Selection bits
+       000 = Level-sensitive */
+    PG2FFPCIbits.ACP = 0;
+    /* Acceptance Qualifier Source Selection bits
+       000 = No acceptance qualifier is used */
+    PG2FFPCIbits.AQSS = 0;
+#endif
     /* PWM GENERATOR 2 Sync PCI REGISTER LOW */
     PG2SPCI     = 0x0000;
     
@@ -1379,7 +1424,12 @@ void InitPWMGenerator4 (void)
     /* Data for PWM4H/PWM4L Pins if Feed-Forward Event is Active bits
        If feed-forward is active, then FFDAT<1> provides data for PWM4H.
        If feed-forward is active, then FFDAT<0> provides data for PWM4L.*/
+#ifdef HARDWARE_HCC
+    /* 01 = PWM4L is ON (freewheeling) while comparator output is tripped */
+    PG4IOCONbits.FFDAT = 1;
+#else
     PG4IOCONbits.FFDAT = 0;
+#endif
     /* Data for PWM4H/PWM4L Pins if Debug Mode is Active and PTFRZ = 1 bits
        If Debug mode is active and PTFRZ=1,then DBDAT<1> provides PWM4H data.
        If Debug mode is active and PTFRZ=1,then DBDAT<0> provides PWM4L data. */
@@ -1615,6 +1665,23 @@ void InitPWMGenerator4 (void)
     
     /* PWM GENERATOR 4 Feed Forward PCI REGISTER LOW */
     PG4FFPCI    = 0x0000;
+#ifdef HARDWARE_HCC
+    /* Feed-forward PCI is driven by comparator CMP3(Phase D current) 
+       for hardware hysteresis current control */
+    /* PCI Source Selection bits */
+    PG4FFPCIbits.PSS = CMP3_PCI_SOURCE;
+    /* PCI Polarity Select bit 0 = Not inverted */
+    PG4FFPCIbits.PPS = 0;
+    /* PCI Synchronization Control bit
+       0 = PCI source is not synchronized to PWM EOC */
+    PG4FFPCIbits.PSYNC = 0;
+    /* PCI Acceptance Criteria Selection bits
+       000 = Level-sensitive */
+    PG4FFPCIbits.ACP = 0;
+    /* Acceptance Qualifier Source Selection bits
+       000 = No acceptance qualifier is used */
+    PG4FFPCIbits.AQSS = 0;
+#endif
     /* PWM GENERATOR 4 Sync PCI REGISTER LOW */
     PG4SPCI     = 0x0000;
     
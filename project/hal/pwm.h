@@ -115,6 +115,11 @@
 #define PWM_HALF_ON     0x00003400
 /* PWM_CHG_BOOT_CAP - Override both PWMxH & L with data 01b */
 #define CHG_BOOT_CAP    0x00003400
+/* PWM_HW_CHOPPING - Release override, PWM Generator and feed-forward PCI
+   provide data for PWMxH & L */
+#define PWM_HW_CHOPPING 0x00000000
+/* Duty cycle of PWM Generators chopped by feed-forward PCI - 100% duty */
+#define PWM_HCC_CHOP_DUTY   LOOPTIME_TCY
 // </editor-fold>      
 
 // <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
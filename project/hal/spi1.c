@@ -83,9 +83,9 @@ void SPI1_Initialize (void)
     SPI1CON1bits.ENHBUF = 1;
     
     SPI1CON2 = 0;
-    SPI1CON2bits.WLENGTH = 25;
+    SPI1CON2bits.WLENGTH = SPI1_WORD_BITS;
     SPI1STAT = 0;
-    SPI1BRG = 12;       // 50 / 13 = 3.84MHz
+    SPI1BRG = SPI1_BRG;     // 50 / 13 = 3.84MHz
     SPI1IMSK = 0;
     SPI1URDT = 0;
    
@@ -93,24 +93,34 @@ void SPI1_Initialize (void)
 }
 
 /**
-* <B> Function: SPI1_WordExchange() </B>
+* <B> Function: SPI1_WordExchange(uint32_t, uint32_t *) </B>
 *
-* @brief Function for SPI word exchange.
+* @brief Function for SPI word exchange. Wait for the received word is 
+*        bounded by SPI1_EXCHANGE_TIMEOUT, so that a missing slave does not
+*        hang the control loop.
 *        
-* @param none.
-* @return none.
+* @param Word to be transmitted.
+* @param Pointer to the received word, not updated on time-out.
+* @return true if the word is received, false on time-out.
 * 
 * @example
-* <CODE> SPI1_WordExchange(); </CODE>
+* <CODE> SPI1_WordExchange(SPI_DUMMY_DATA, &data); </CODE>
 *
 */
-uint32_t SPI1_WordExchange(uint32_t wordData)
+bool SPI1_WordExchange(uint32_t wordData, uint32_t *pData)
 {
-    uint32_t ret;
+    uint32_t timeout = SPI1_EXCHANGE_TIMEOUT;
+    
     SPI1BUF = wordData;
-    while(SPI1STATbits.SPIRBF == 0);
-    ret = SPI1BUF; /* Read SPIRBF */
-    return(ret);
+    while(SPI1STATbits.SPIRBF == 0)
+    {
+        if(--timeout == 0)
+        {
+            return false;
+        }
+    }
+    *pData = SPI1BUF; /* Read SPIRBF */
+    return true;
 }
 
 // </editor-fold> 
@@ -47,12 +47,33 @@
 // </editor-fold>
 #ifndef SPI1_H
 #define SPI1_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "delay.h"
         
 #define SPI_DUMMY_DATA  0x0000u
 
+/* SPI clock = 50MHz / (SPI1_BRG + 1) = 3.84MHz, word of 25 bits */
+#define SPI1_BRG                12u
+#define SPI1_WORD_BITS          25u
+#define SPI1_CLOCK_HZ           (50000000UL / (SPI1_BRG + 1))
+/* Word exchange time (ns), 6.5us */
+#define SPI1_WORD_NS            (uint32_t)((SPI1_WORD_BITS * 1000000000ULL) / \
+                                                                SPI1_CLOCK_HZ)
+/* Instruction cycles of a receive buffer poll, read of status register, test,
+   decrement of the limit and branch take at least 4 cycles */
+#define SPI1_POLL_CYCLES        4u
+/* Receive buffer polls before word exchange is abandoned, word exchange time
+   with 25% margin at the shortest poll. The exchange runs in the control loop
+   interrupt, a longer poll extends the wait on a missing slave in proportion */
+#define SPI1_EXCHANGE_TIMEOUT   (uint32_t)(((SPI1_WORD_NS * 5ULL / 4u) * \
+                                (FCY / 1000000UL)) / (1000u * SPI1_POLL_CYCLES))
+
 void SPI1_Initialize (void);
 
-uint32_t SPI1_WordExchange(uint32_t wordData);
+bool SPI1_WordExchange(uint32_t wordData, uint32_t *pData);
 
 #endif /*_SPI1_H */
     
@@ -302,6 +302,18 @@ inline static void UART1_RxInterruptPrioritySet(uint16_t priorityValue)
 {
     _U1RXIP = 0x7&priorityValue;
 }
+/**
+ * Sets the priority level for UART1 Tx interrupt.
+ * @param priorityValue desired priority level between 0 and 7
+ * @example
+ * <code>
+ * UART1_TxInterruptPrioritySet(5);
+ * </code>
+ */
+inline static void UART1_TxInterruptPrioritySet(uint16_t priorityValue)
+{
+    _U1TXIP = 0x7&priorityValue;
+}
 // </editor-fold>
 
 #ifdef __cplusplus  // Provide C++ Compatibility
@@ -0,0 +1,119 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file wdt.h
+ *
+ * @brief This header file lists interface functions - to enable and clear 
+ * the watchdog timer and to read the watchdog reset flag. Watchdog period and
+ * its reset action are set by FWDT configuration bits.
+ *
+ * Definitions in this file are for dsPIC33AK128MC106
+ *
+ * Component: WDT
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+#ifndef __WDT_H
+#define __WDT_H
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <xc.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// </editor-fold>
+
+#ifdef __cplusplus  // Provide C++ Compatability
+    extern "C" {
+#endif
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/CONSTANTS ">
+
+/* WDTCLRKEY value to clear the watchdog timer */
+#define WDT_CLEAR_KEY               0x5743
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+
+/**
+ * Enables the watchdog timer, when FWDT_WDTEN allows software control.
+ * @example
+ * <code>
+ * WDT_Enable();
+ * </code>
+ */
+inline static void WDT_Enable(void)
+{
+    WDTCONbits.ON = 1;
+}
+/**
+ * Clears the watchdog timer.
+ * @example
+ * <code>
+ * WDT_Clear();
+ * </code>
+ */
+inline static void WDT_Clear(void)
+{
+    WDTCONbits.WDTCLRKEY = WDT_CLEAR_KEY;
+}
+/**
+ * Reads and clears the watchdog time-out reset flag.
+ * @return true if the last reset was caused by watchdog time-out.
+ * @example
+ * <code>
+ * watchdogReset = WDT_ResetFlagGet();
+ * </code>
+ */
+inline static bool WDT_ResetFlagGet(void)
+{
+    bool flag = (RCONbits.WDTO == 1);
+    
+    RCONbits.WDTO = 0;
+    return flag;
+}
+
+// </editor-fold>
+
+#ifdef __cplusplus  // Provide C++ Compatibility
+    }
+#endif
+#endif      // end of __WDT_H
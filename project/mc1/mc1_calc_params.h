@@ -60,6 +60,7 @@ extern "C" {
 #include "board_service.h"
 
 #include "mc1_user_params.h"
+#include "efficiency_sweep.h"
 #include "math.h"
 
 // </editor-fold>
@@ -71,12 +72,140 @@ extern "C" {
 #define MC1_LOOPTIME_SEC              LOOPTIME_SEC
 
 #define LOOPTIME_MICROSEC             (LOOPTIME_SEC * 1000000.0f)    
+
+/* Execution period of speed loop in seconds */
+#define SPEED_LOOP_SEC                (float)((SPEED_CRTL_RATE + 2) * LOOPTIME_SEC)
+    
+/* Load observer filter co-efficient for execution at speed loop rate */
+#define LOAD_OBSERVER_FILTER_COEFF    (float)((2.0f * M_PI * LOAD_OBSERVER_FILTER_HZ * \
+                                        SPEED_LOOP_SEC) / (1.0f + 2.0f * M_PI * \
+                                        LOAD_OBSERVER_FILTER_HZ * SPEED_LOOP_SEC))
+    
+/* Autotune target bandwidth in rad/s and timeout in speed loop executions */
+#define AUTOTUNE_BANDWIDTH_RAD        (float)(2.0f * M_PI * AUTOTUNE_BANDWIDTH_HZ)
+#define AUTOTUNE_TIMEOUT_COUNT        (uint32_t)(AUTOTUNE_TIMEOUT_SEC / SPEED_LOOP_SEC)
+    
+/* Efficiency sweep times in control loop executions */
+#define SWEEP_SETTLE_COUNT            (uint32_t)(SWEEP_SETTLE_SEC / LOOPTIME_SEC)
+#define SWEEP_POINT_TIMEOUT_COUNT     (uint32_t)(SWEEP_POINT_TIMEOUT_SEC / LOOPTIME_SEC)
+#define SWEEP_AVERAGE_COUNT           (uint32_t)(SWEEP_AVERAGE_SEC / LOOPTIME_SEC)
+    
+#if (SWEEP_SPEED_TABLE_SIZE * SWEEP_LOAD_TABLE_SIZE) > EFFICIENCY_SWEEP_POINTS_MAX
+#error "SWEEP_SPEED_TABLE_SIZE x SWEEP_LOAD_TABLE_SIZE exceeds EFFICIENCY_SWEEP_POINTS_MAX"
+#endif
+    
+/* Position control parameters in radians */
+#define POSITION_RANGE_RAD            (float)(2.0f * M_PI * POSITION_RANGE_TURNS)
+#define POSITION_SPEED_MAX_RAD        (float)(POSITION_SPEED_MAX_RPM * 2.0f * M_PI / 60.0f)
+#define POSITION_ACCEL_RAD            (float)(POSITION_ACCEL_RPM_PER_SEC * 2.0f * M_PI / 60.0f)
+#define POSITION_KP                   (float)(POSITION_KP_RPM_PER_DEG * 180.0f / M_PI)
+#define POSITION_HOLD_WINDOW_RAD      (float)(POSITION_HOLD_WINDOW_DEG * M_PI / 180.0f)
+#define POSITION_HOLD_GAIN            (float)(180.0f / (M_PI * POSITION_HOLD_STIFFNESS_DEG))
+    
+/* Flying start settle time in speed loop executions */
+#define FLYING_START_SETTLE_COUNT     (uint32_t)(FLYING_START_SETTLE_SEC / SPEED_LOOP_SEC)
+    
+/* Stall detection time in speed loop executions, unjamming pulse in control
+   loop executions */
+#define STALL_DETECT_COUNT            (uint32_t)(STALL_DETECT_SEC / SPEED_LOOP_SEC)
+#define STALL_UNJAM_PULSE_COUNT       (uint32_t)(STALL_UNJAM_PULSE_SEC / LOOPTIME_SEC)
+    
+/* Freewheel stage of two-stage turn-off in control loop executions */
+#define TWO_STAGE_FREEWHEEL_COUNT     (uint32_t)(TWO_STAGE_FREEWHEEL_SEC / LOOPTIME_SEC)
+#if (CHOP_MODE_DEFAULT > 2)
+#error "CHOP_MODE_DEFAULT must be 0, 1 or 2"
+#endif
+    
+/* Bootstrap capacitor charging times in control loop executions */
+#define BOOTSTRAP_PRECHARGE_COUNT     (uint32_t)(BOOTSTRAP_PRECHARGE_SEC / LOOPTIME_SEC)
+#define BOOTSTRAP_REFRESH_COUNT       (uint32_t)(BOOTSTRAP_REFRESH_SEC / LOOPTIME_SEC)
+#define BOOTSTRAP_CHARGE_COUNT        (uint32_t)(BOOTSTRAP_CHARGE_SEC / LOOPTIME_SEC)
+    
+/* Speed supervision times in control loop executions, plausible change of
+   rotor angle step and conduction strokes in a window per RPM, a stroke is
+   a phase of the four in a control angle */
+#define SPEED_FAULT_COUNT             (uint32_t)(SPEED_FAULT_SEC / LOOPTIME_SEC)
+#define SPEED_CHECK_WINDOW_COUNT      (uint32_t)(SPEED_CHECK_WINDOW_SEC / LOOPTIME_SEC)
+#define POSITION_STEP_CHANGE_MAX_RAD  (float)(POSITION_STEP_CHANGE_MAX_DEG * M_PI / 180.0f)
+#define SPEED_CHECK_STROKE_GAIN       (float)(4.0f * 360.0f / CRTL_THETA * SPEED_CHECK_WINDOW_SEC / 60.0f)
+#if (SPEED_MISMATCH_WINDOWS < 1)
+#error "SPEED_MISMATCH_WINDOWS must be at least 1"
+#endif
+    
+/* Supervisor deadlines in executions of the checking context */
+#define SUPERVISOR_ADC_MISS_COUNT     (uint32_t)(SUPERVISOR_ADC_DEADLINE_SEC * 1000000.0f / TIMER1_PERIOD_uSec)
+#define SUPERVISOR_TIMER1_MISS_COUNT  (uint32_t)(SUPERVISOR_TIMER1_DEADLINE_SEC / LOOPTIME_SEC)
+#define SUPERVISOR_MAIN_MISS_COUNT    (uint32_t)(SUPERVISOR_MAIN_DEADLINE_SEC * 1000000.0f / TIMER1_PERIOD_uSec)
+    
+/* Phase overcurrent blanking after commutation in control loop executions */
+#define PHASE_OC_BLANKING_COUNT       (uint32_t)(PHASE_OC_BLANKING_SEC / LOOPTIME_SEC)
+#define PHASE_OC_DECAY_GAIN           (float)(LOOPTIME_SEC / PHASE_OC_DECAY_TIME_SEC)
+    
+/* Fault derating hold time in control loop executions */
+#define FAULT_DERATE_HOLD_COUNT       (uint32_t)(FAULT_DERATE_HOLD_SEC / LOOPTIME_SEC)
+    
+/* Fault recovery times in control loop executions */
+#define FAULT_RESTART_DELAY_COUNT     (uint32_t)(FAULT_RESTART_DELAY_SEC / LOOPTIME_SEC)
+#define FAULT_RESTART_DELAY_MAX_COUNT (uint32_t)(FAULT_RESTART_DELAY_MAX_SEC / LOOPTIME_SEC)
+#define FAULT_HEALTHY_RUN_COUNT       (uint32_t)(FAULT_HEALTHY_RUN_SEC / LOOPTIME_SEC)
+    
+/* Current offset limit in ADC counts */
+#define CURRENT_OFFSET_LIMIT_COUNT    (int32_t)(CURRENT_OFFSET_LIMIT * ADC_CURRENT_SCALE_INVERSE)
+    
+/* DC link voltage filter gain and fault detection time in control loop 
+   executions */
+#define DC_BUS_FILTER_GAIN            (float)(LOOPTIME_SEC / (DC_BUS_FILTER_SEC + LOOPTIME_SEC))
+#define DC_BUS_FAULT_COUNT            (uint32_t)(DC_BUS_FAULT_SEC / LOOPTIME_SEC)
+/* Current rise in a control loop execution per volt at aligned position */
+#define DC_BUS_CHOP_DELAY_GAIN        (float)(LOOPTIME_SEC / MOTOR_INDUCTANCE_ALIGNED)
+#define DC_BUS_ANGLE_COMP_MAX_RAD     (float)(DC_BUS_ANGLE_COMP_MAX_DEG * M_PI / 180.0f)
+    
+/* Winding diagnostics current rise limits and times in control loop 
+   executions */
+#define WINDING_DIAG_RISE_GAIN_MIN    (float)(LOOPTIME_SEC / (MOTOR_INDUCTANCE_ALIGNED * WINDING_DIAG_RISE_MARGIN))
+#define WINDING_DIAG_RISE_GAIN_MAX    (float)(WINDING_DIAG_RISE_MARGIN * LOOPTIME_SEC / MOTOR_INDUCTANCE_UNALIGNED)
+#define WINDING_DIAG_DEMAG_COUNT      (uint32_t)(WINDING_DIAG_DEMAG_SEC / LOOPTIME_SEC)
+#define WINDING_DIAG_SWITCH_FAULT_COUNT (uint32_t)(WINDING_DIAG_SWITCH_FAULT_SEC / LOOPTIME_SEC)
+#ifdef WINDING_DEGRADED_MODE
+#define PHASE_FAILURE_REACTION        MC1_FAULT_REACTION_DERATE
+#else
+#define PHASE_FAILURE_REACTION        MC1_FAULT_REACTION_TRIP
+#endif
+    
+/* Thermal model update in control loop executions, and filter gains */
+#define THERMAL_MODEL_DECIMATION      (uint32_t)(THERMAL_MODEL_PERIOD_SEC / LOOPTIME_SEC)
+#define MOTOR_WINDING_THERMAL_GAIN    (float)(THERMAL_MODEL_PERIOD_SEC / MOTOR_WINDING_TIME_CONSTANT_SEC)
+#define INVERTER_THERMAL_GAIN         (float)(THERMAL_MODEL_PERIOD_SEC / INVERTER_TIME_CONSTANT_SEC)
+    
+/* Braking stop timeout in control loop executions */
+#define REGEN_STOP_TIMEOUT_COUNT      (uint32_t)(REGEN_STOP_TIMEOUT_SEC / LOOPTIME_SEC)
+    
+#if defined(REGEN_BRAKING) && (REGEN_VDC_LIMIT >= MOTOR_MAX_DC_VOLT)
+#error "REGEN_VDC_LIMIT must be less than MOTOR_MAX_DC_VOLT"
+#endif
+    
+#if (MOTOR_WINDING_DERATE_DEGC >= MOTOR_WINDING_LIMIT_DEGC) || \
+    (INVERTER_DERATE_DEGC >= INVERTER_LIMIT_DEGC)
+#error "Thermal derate start temperatures must be less than the limits"
+#endif
+    
+#if (DC_UNDERVOLTAGE_VOLT >= DC_DERATE_START_VOLT)
+#error "DC_UNDERVOLTAGE_VOLT must be less than DC_DERATE_START_VOLT"
+#endif
+    
+#if (DC_OVERVOLTAGE_VOLT <= MOTOR_MAX_DC_VOLT)
+#error "DC_OVERVOLTAGE_VOLT must be greater than MOTOR_MAX_DC_VOLT"
+#endif
+    
+#if defined(POSITION_CONTROL) && !defined(SPEED_CONTROL)
+#error "POSITION_CONTROL requires SPEED_CONTROL"
+#endif
     
 #define ADC_VOLTAGE_SCALE             (float)(MC1_PEAK_VOLTAGE/4095.0f)
 #define ADC_VDC_VOLTAGE_SCALE         (float)(MC1_MAX_DC_BUS_VOLTAGE/4095.0f)
     
 #define ADC_CURRENT_SCALE             (float)(MC1_PEAK_CURRENT/32768.0f)
-#define ADC_CURRENT_SCALE_INVERSE     (float)((32768.0f/ MC1_PEAK_CURRENT) 
+#define ADC_CURRENT_SCALE_INVERSE     (float)(32768.0f/ MC1_PEAK_CURRENT) 
     
 /* Convert degrees to radians */    
 #define M_PI_RAD                      (float) M_PI / 180
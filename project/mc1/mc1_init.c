@@ -59,6 +59,22 @@
 
 // </editor-fold>
 
+// <editor-fold defaultstate="collapsed" desc="VARIABLES ">
+#ifdef SPEEDCNTR_EXTENDED_PI
+/* Speed scheduled gains of speed controller */
+static const MC_PIGAINPOINT_T speedGainTable[SPEEDCNTR_GAIN_TABLE_SIZE] = 
+                                                        SPEEDCNTR_GAIN_TABLE;
+#endif
+#ifdef CHOP_REGIONS
+/* Chopping strategy of operating regions */
+static const MCAPP_CHOP_REGION_T chopRegionTable[CHOP_REGION_TABLE_SIZE] = 
+                                                        CHOP_REGION_TABLE;
+#endif
+/* Speed and load points of efficiency sweep */
+static const float sweepSpeedTable[SWEEP_SPEED_TABLE_SIZE] = SWEEP_SPEED_TABLE;
+static const float sweepLoadTable[SWEEP_LOAD_TABLE_SIZE] = SWEEP_LOAD_TABLE;
+// </editor-fold>
+
 // <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
 static void MCAPP_MC1ControlSchemeConfig(MC1APP_DATA_T *);
 static void MCAPP_MC1FeedbackConfig(MC1APP_DATA_T *);
@@ -87,6 +103,13 @@ void MCAPP_MC1ParamsInit(MC1APP_DATA_T *pMCData)
     pMCData->pMotor = &pMCData->motor;
     pMCData->pPWMDuty = &pMCData->PWMDuty;
 	pMCData->pfaultDetect = &pMCData->fault_detect;
+    pMCData->pFaultRecorder = &pMCData->faultRecorder;
+    pMCData->pThermalModel = &pMCData->thermalModel;
+    pMCData->pSupervisor = &pMCData->supervisor;
+    pMCData->pEfficiencySweep = &pMCData->efficiencySweep;
+    
+    /* Continue fault log from flash */
+    MCAPP_FaultRecorderInit(pMCData->pFaultRecorder);
     
     /* Configure Feedbacks */
     MCAPP_MC1FeedbackConfig(pMCData);
@@ -110,6 +133,10 @@ void MCAPP_MC1FeedbackConfig(MC1APP_DATA_T *pMCData)
     
     pMCData->motorInputs.measureVdc.dcMaxStop = MOTOR_MAX_DC_VOLT;
     
+    pMCData->motorInputs.measureVdc.filterGain = DC_BUS_FILTER_GAIN;
+    
+    pMCData->motorInputs.measureCurrent.offsetLimit = CURRENT_OFFSET_LIMIT_COUNT;
+    
 }
 
 void MCAPP_MC1ControlSchemeConfig(MC1APP_DATA_T *pMCData)
@@ -118,11 +145,18 @@ void MCAPP_MC1ControlSchemeConfig(MC1APP_DATA_T *pMCData)
     MCAPP_MEASURE_T *pMotorInputs;
     MCAPP_MOTOR_T *pMotor;
     MCAPP_FAULT_DETECT_T *pfault_detect;
+    MCAPP_THERMAL_MODEL_T *pThermal;
+    MCAPP_SUPERVISOR_T *pSupervisor;
+    MCAPP_EFFICIENCY_SWEEP_T *pSweep;
+    uint32_t index;
     
     pControlScheme = pMCData->pControlScheme;
     pMotorInputs = pMCData->pMotorInputs;
     pMotor = pMCData->pMotor;
     pfault_detect = pMCData->pfaultDetect;
+    pThermal = pMCData->pThermalModel;
+    pSupervisor = pMCData->pSupervisor;
+    pSweep = pMCData->pEfficiencySweep;
 
     
     /* Configure Inputs */  
@@ -132,6 +166,9 @@ void MCAPP_MC1ControlSchemeConfig(MC1APP_DATA_T *pMCData)
     pControlScheme->pId = &pMotorInputs->iabcd.d; 
     pControlScheme->pTheta = &pMotorInputs->detectRotorPosition.theta;
     pControlScheme->pSpeed = &pMotorInputs->detectRotorPosition.speed;
+    pControlScheme->pVelocity = &pMotorInputs->detectRotorPosition.velocity;
+    pControlScheme->pPosition = &pMotorInputs->detectRotorPosition.position;
+    pControlScheme->pVdc = &pMotorInputs->measureVdc.filtered;
     pMotorInputs->adcCurrentScale = (float) (ADC_CURRENT_SCALE);
     pMotorInputs->adcVoltageScale = (float) (ADC_VOLTAGE_SCALE);
     /* Initialize motor parameters */    
@@ -157,12 +194,19 @@ void MCAPP_MC1ControlSchemeConfig(MC1APP_DATA_T *pMCData)
     pMotor->nominalSpeed       =   (float) (NOMINAL_SPEED_RPM);
     pMotor->maxSpeed           =   (float) (MAXIMUM_SPEED_RPM);
     pMotor->ratedCurrent       =   (float) (RATED_CURRENT);   
+    pMotor->torqueConstant     =   (float) (MOTOR_KT);
+    pMotor->inertia            =   (float) (MOTOR_INERTIA);
     
     /* Initialize SRM control parameters */
 #ifdef  SPEED_CONTROL
     pControlScheme->ctrlParam.speedLoop = 1; /* Speed control mode */
 #else
     pControlScheme->ctrlParam.speedLoop = 0; /* Current control mode */
+#endif
+#ifdef  POSITION_CONTROL
+    pControlScheme->ctrlParam.positionLoop = 1; /* Position control mode */
+#else
+    pControlScheme->ctrlParam.positionLoop = 0;
 #endif
     pControlScheme->ctrlParam.speedRate    = SPEED_CRTL_RATE;
     pControlScheme->ctrlParam.crtlTheta    = RAD_CRTL_THETA;
@@ -204,28 +248,348 @@ void MCAPP_MC1ControlSchemeConfig(MC1APP_DATA_T *pMCData)
     pControlScheme->piSpeedInput.piState.outMax      =   SPEEDCNTR_OUTMAX;
     pControlScheme->piSpeedInput.piState.outMin      =   SPEEDCNTR_OUTMIN;
     pControlScheme->piSpeedInput.piState.integrator  =   0;
+    pControlScheme->speedLoopOutMax                  =   SPEEDCNTR_OUTMAX;
+    pControlScheme->speedLoopOutMin                  =   SPEEDCNTR_OUTMIN;
+    
+    /* Initialize speed reference ramp */
+    pControlScheme->speedRamp.accelMax  =   SPEED_RAMP_ACCEL_RPM_PER_SEC;
+    pControlScheme->speedRamp.jerkMax   =   SPEED_RAMP_JERK_RPM_PER_SEC2;
+    pControlScheme->speedRamp.sampleTime =  SPEED_LOOP_SEC;
+#ifdef SPEED_REFERENCE_RAMP
+    pControlScheme->speedRamp.enable    =   1;
+#else
+    pControlScheme->speedRamp.enable    =   0;
+#endif
+    
+    /* Initialize load torque observer */
+    pControlScheme->loadObserver.torqueConstant     =   pMotor->torqueConstant;
+    pControlScheme->loadObserver.inertia            =   pMotor->inertia;
+    pControlScheme->loadObserver.filterCoefficient  =   LOAD_OBSERVER_FILTER_COEFF;
+    pControlScheme->loadObserver.sampleTime         =   SPEED_LOOP_SEC;
+#ifdef LOAD_TORQUE_FEEDFORWARD
+    pControlScheme->loadObserver.feedForwardEnable  =   1;
+#else
+    pControlScheme->loadObserver.feedForwardEnable  =   0;
+#endif
+    /* Initialize speed loop autotune */
+    pControlScheme->autotune.setpoint       =   AUTOTUNE_SPEED_RPM;
+    pControlScheme->autotune.hysteresis     =   AUTOTUNE_HYSTERESIS_RPM;
+    pControlScheme->autotune.currentHigh    =   AUTOTUNE_CURRENT_HIGH;
+    pControlScheme->autotune.currentLow     =   AUTOTUNE_CURRENT_LOW;
+    pControlScheme->autotune.bandwidth      =   AUTOTUNE_BANDWIDTH_RAD;
+    pControlScheme->autotune.sampleTime     =   SPEED_LOOP_SEC;
+    pControlScheme->autotune.skipCycles     =   AUTOTUNE_SKIP_CYCLES;
+    pControlScheme->autotune.measureCycles  =   AUTOTUNE_MEASURE_CYCLES;
+    pControlScheme->autotune.timeoutCount   =   AUTOTUNE_TIMEOUT_COUNT;
+    
+    /* Initialize position control */
+    pControlScheme->positionControl.kp          =   POSITION_KP;
+    pControlScheme->positionControl.range       =   POSITION_RANGE_RAD;
+    pControlScheme->positionControl.holdWindow  =   POSITION_HOLD_WINDOW_RAD;
+    pControlScheme->positionControl.holdCurrent =   POSITION_HOLD_CURRENT;
+    pControlScheme->positionControl.holdGain    =   POSITION_HOLD_GAIN;
+    pControlScheme->positionControl.hccInput.hccState.beta = HCC_BETA;
+    pControlScheme->positionControl.profile.velocityMax = POSITION_SPEED_MAX_RAD;
+    pControlScheme->positionControl.profile.accelMax    = POSITION_ACCEL_RAD;
+    pControlScheme->positionControl.profile.sampleTime  = SPEED_LOOP_SEC;
+    
+    /* Initialize flying start */
+    pControlScheme->flyingStart.minSpeed    =   FLYING_START_MIN_SPEED_RPM;
+    pControlScheme->flyingStart.settleCount =   FLYING_START_SETTLE_COUNT;
+#ifdef FLYING_START
+    pControlScheme->flyingStart.enable      =   1;
+#else
+    pControlScheme->flyingStart.enable      =   0;
+#endif
+    
+    /* Initialize regenerative braking */
+    pControlScheme->regen.currentMax        =   REGEN_CURRENT_MAX;
+    pControlScheme->regen.vdcDerateStart    =   REGEN_VDC_DERATE_START;
+    pControlScheme->regen.vdcLimit          =   REGEN_VDC_LIMIT;
+#ifdef REGEN_BRAKING
+    pControlScheme->regen.enable            =   1;
+#else
+    pControlScheme->regen.enable            =   0;
+#endif
+    
+    /* Initialize direction reversal */
+    pControlScheme->reversal.switchSpeed    =   REVERSAL_SWITCH_SPEED_RPM;
+#ifdef RUNNING_REVERSAL
+    pControlScheme->reversal.enable         =   1;
+#else
+    pControlScheme->reversal.enable         =   0;
+#endif
+    
+    /* Initialize stall detection and unjamming */
+    pControlScheme->stall.speedMax          =   STALL_SPEED_RPM;
+    pControlScheme->stall.detectCount       =   STALL_DETECT_COUNT;
+    pControlScheme->stall.unjamAttempts     =   STALL_UNJAM_ATTEMPTS;
+    pControlScheme->stall.unjamPulses       =   STALL_UNJAM_PULSES;
+    pControlScheme->stall.unjamPulseCount   =   STALL_UNJAM_PULSE_COUNT;
+    pControlScheme->stall.unjamCurrent      =   STALL_UNJAM_CURRENT;
+#ifdef STALL_DETECTION
+    pControlScheme->stall.enable            =   1;
+#else
+    pControlScheme->stall.enable            =   0;
+#endif
+#ifdef STALL_UNJAM
+    pControlScheme->stall.unjamEnable       =   1;
+#else
+    pControlScheme->stall.unjamEnable       =   0;
+#endif
+    
+    /* Initialize operation with a failed phase */
+    pControlScheme->limpHome.overlap        =   LIMP_HOME_OVERLAP;
+    pControlScheme->limpHome.speedMax       =   LIMP_HOME_SPEED_RPM;
+    
+    /* Initialize acoustic noise reduction */
+    pControlScheme->noise.rampStart         =   SOFT_TURN_OFF_START;
+    pControlScheme->noise.rampEndScale      =   SOFT_TURN_OFF_END_SCALE;
+    pControlScheme->noise.freewheelCount    =   TWO_STAGE_FREEWHEEL_COUNT;
+    pControlScheme->noise.betaNominal       =   HCC_BETA;
+    pControlScheme->noise.betaSpread        =   RANDOM_HCC_BETA_SPREAD;
+    pControlScheme->noise.forceFilter       =   NOISE_METRIC_FILTER;
+    pControlScheme->noise.decayCurrent      =   NOISE_METRIC_DECAY_CURRENT;
+    pControlScheme->noise.randomState       =   0x2545F491UL;
+#ifdef SOFT_TURN_OFF
+    pControlScheme->noise.softTurnOff       =   1;
+#else
+    pControlScheme->noise.softTurnOff       =   0;
+#endif
+#ifdef TWO_STAGE_TURN_OFF
+    pControlScheme->noise.twoStageTurnOff   =   1;
+#else
+    pControlScheme->noise.twoStageTurnOff   =   0;
+#endif
+#ifdef RANDOM_HCC_BAND
+    pControlScheme->noise.randomBand        =   1;
+#else
+    pControlScheme->noise.randomBand        =   0;
+#endif
+    
+    /* Initialize chopping strategy */
+    pControlScheme->chopping.modeDefault    =   CHOP_MODE_DEFAULT;
+    pControlScheme->chopping.hardStart      =   CHOP_MIXED_HARD_START;
+#ifdef CHOP_REGIONS
+    pControlScheme->chopping.pTable         =   chopRegionTable;
+    pControlScheme->chopping.tableSize      =   CHOP_REGION_TABLE_SIZE;
+#else
+    pControlScheme->chopping.pTable         =   NULL;
+    pControlScheme->chopping.tableSize      =   0;
+#endif
+    
+    /* Initialize bootstrap capacitor charging */
+    pControlScheme->bootstrap.prechargeCount =  BOOTSTRAP_PRECHARGE_COUNT;
+    pControlScheme->bootstrap.refreshCount  =   BOOTSTRAP_REFRESH_COUNT;
+    pControlScheme->bootstrap.chargeCount   =   BOOTSTRAP_CHARGE_COUNT;
+    pControlScheme->bootstrap.idleCurrent   =   BOOTSTRAP_IDLE_CURRENT;
+#ifdef BOOTSTRAP_SCHEDULER
+    pControlScheme->bootstrap.enable        =   1;
+#else
+    pControlScheme->bootstrap.enable        =   0;
+#endif
+    
+    /* Initialize DC bus voltage derating and compensation */
+    pControlScheme->vdcComp.derateStart     =   DC_DERATE_START_VOLT;
+    pControlScheme->vdcComp.derateEnd       =   DC_UNDERVOLTAGE_VOLT;
+    pControlScheme->vdcComp.derateMin       =   DC_DERATE_MIN_FACTOR;
+    pControlScheme->vdcComp.vdcNominal      =   DC_BUS_NOMINAL_VOLT;
+    pControlScheme->vdcComp.inductanceUnaligned = MOTOR_INDUCTANCE_UNALIGNED;
+    pControlScheme->vdcComp.chopDelayGain   =   DC_BUS_CHOP_DELAY_GAIN;
+    pControlScheme->vdcComp.advanceMax      =   DC_BUS_ANGLE_COMP_MAX_RAD;
+#ifdef DC_BUS_COMPENSATION
+    pControlScheme->vdcComp.enable          =   1;
+#else
+    pControlScheme->vdcComp.enable          =   0;
+#endif
+    
+#ifdef SPEEDCNTR_EXTENDED_PI
+    pControlScheme->piSpeedInput.piState.kd          =   SPEEDCNTR_DTERM;
+    pControlScheme->piSpeedInput.piState.kdFilter    =   SPEEDCNTR_DFILTER;
+    pControlScheme->piSpeedInput.piState.kff         =   SPEEDCNTR_FFTERM;
+    pControlScheme->piSpeedInput.piState.antiWindup  =   SPEEDCNTR_ANTIWINDUP;
+    pControlScheme->piSpeedInput.piState.pGainTable  =   speedGainTable;
+    pControlScheme->piSpeedInput.piState.gainTableSize = SPEEDCNTR_GAIN_TABLE_SIZE;
+    pControlScheme->SpeedController = MC_ControllerPIExtendedUpdate;
+#else
+    pControlScheme->SpeedController = MC_ControllerPIUpdate;
+#endif
     
     /* Output Initializations */  
     pControlScheme->PhaseA_Control  =   PWM1_OverrideEnableDataSet;
     pControlScheme->PhaseB_Control  =   PWM2_OverrideEnableDataSet;
     pControlScheme->PhaseC_Control  =   PWM3_OverrideEnableDataSet;
     pControlScheme->PhaseD_Control  =   PWM4_OverrideEnableDataSet;
+#ifdef HARDWARE_HCC
+    pControlScheme->HCC_ThresholdSet =  HAL_MC1HCCThresholdSet;
+#endif
     
     /* Initialize fault detection parameters*/
-    pfault_detect->PhaseA_OC_Threshold = PHASE_OC_THRESHOLD;
-    pfault_detect->PhaseB_OC_Threshold = PHASE_OC_THRESHOLD;
-    pfault_detect->PhaseC_OC_Threshold = PHASE_OC_THRESHOLD;
-    pfault_detect->PhaseD_OC_Threshold = PHASE_OC_THRESHOLD;
+    pfault_detect->PhaseA_OC_Threshold = PHASEA_OC_THRESHOLD;
+    pfault_detect->PhaseB_OC_Threshold = PHASEB_OC_THRESHOLD;
+    pfault_detect->PhaseC_OC_Threshold = PHASEC_OC_THRESHOLD;
+    pfault_detect->PhaseD_OC_Threshold = PHASED_OC_THRESHOLD;
+    pfault_detect->ocThreshold.ceiling[0] = PHASEA_OC_THRESHOLD;
+    pfault_detect->ocThreshold.ceiling[1] = PHASEB_OC_THRESHOLD;
+    pfault_detect->ocThreshold.ceiling[2] = PHASEC_OC_THRESHOLD;
+    pfault_detect->ocThreshold.ceiling[3] = PHASED_OC_THRESHOLD;
+    pfault_detect->ocThreshold.refGain    = PHASE_OC_REF_GAIN;
+    pfault_detect->ocThreshold.margin     = PHASE_OC_MARGIN;
+    pfault_detect->ocThreshold.blankCount = PHASE_OC_BLANKING_COUNT;
+    pfault_detect->ocThreshold.decayGain  = PHASE_OC_DECAY_GAIN;
+#ifdef DYNAMIC_OC_THRESHOLD
+    pfault_detect->ocThreshold.enable     = 1;
+#else
+    pfault_detect->ocThreshold.enable     = 0;
+#endif
+    pfault_detect->derateFactor = FAULT_DERATE_FACTOR;
+    pfault_detect->derateHoldCount = FAULT_DERATE_HOLD_COUNT;
+    pfault_detect->dcUndervoltage = DC_UNDERVOLTAGE_VOLT;
+    pfault_detect->dcOvervoltage = DC_OVERVOLTAGE_VOLT;
+    pfault_detect->dcFaultCount = DC_BUS_FAULT_COUNT;
+    
+    /* Initialize thermal model */
+    pThermal->decimation        = THERMAL_MODEL_DECIMATION;
+    pThermal->ambient           = THERMAL_AMBIENT_DEGC;
+    pThermal->phaseResistance   = MOTOR_PHASE_RESISTANCE;
+    pThermal->inverterLossGain  = INVERTER_LOSS_GAIN;
+    for(index = 0; index < THERMAL_MODEL_PHASES; index++)
+    {
+        pThermal->winding[index].thermalResistance = MOTOR_WINDING_THERMAL_RES;
+        pThermal->winding[index].filterGain  = MOTOR_WINDING_THERMAL_GAIN;
+        pThermal->winding[index].derateStart = MOTOR_WINDING_DERATE_DEGC;
+        pThermal->winding[index].limit       = MOTOR_WINDING_LIMIT_DEGC;
+    }
+    pThermal->inverter.thermalResistance = INVERTER_THERMAL_RES;
+    pThermal->inverter.filterGain   = INVERTER_THERMAL_GAIN;
+    pThermal->inverter.derateStart  = INVERTER_DERATE_DEGC;
+    pThermal->inverter.limit        = INVERTER_LIMIT_DEGC;
+#ifdef THERMAL_PROTECTION
+    pThermal->enable            = 1;
+#else
+    pThermal->enable            = 0;
+#endif
+    MCAPP_ThermalModelInit(pThermal);
+    
+    /* Reaction class of each fault, in the order of MC1_FAULT_DETECT_FLAG */
+    pfault_detect->reactionClass[0] = MC1_FAULT_REACTION_TRIP;  /* OV_OC */
+    pfault_detect->reactionClass[1] = MC1_FAULT_REACTION_TRIP;  /* OVERCURRENT */
+    pfault_detect->reactionClass[2] = PHASE_OC_REACTION;        /* PHASEA */
+    pfault_detect->reactionClass[3] = PHASE_OC_REACTION;        /* PHASEB */
+    pfault_detect->reactionClass[4] = PHASE_OC_REACTION;        /* PHASEC */
+    pfault_detect->reactionClass[5] = PHASE_OC_REACTION;        /* PHASED */
+    pfault_detect->reactionClass[6] = MC1_FAULT_REACTION_TRIP;  /* CONTROL */
+    pfault_detect->reactionClass[7] = MC1_FAULT_REACTION_TRIP;  /* CURRENT_OFFSET */
+    pfault_detect->reactionClass[8] = DC_UNDERVOLTAGE_REACTION; /* DC_UNDERVOLTAGE */
+    pfault_detect->reactionClass[9] = DC_OVERVOLTAGE_REACTION;  /* DC_OVERVOLTAGE */
+    pfault_detect->reactionClass[10] = PHASE_FAILURE_REACTION;  /* OPEN_PHASE */
+    pfault_detect->reactionClass[11] = PHASE_FAILURE_REACTION;  /* SHORTED_WINDING */
+    pfault_detect->reactionClass[12] = MC1_FAULT_REACTION_TRIP; /* SWITCH */
+    pfault_detect->reactionClass[13] = MC1_FAULT_REACTION_TRIP; /* STALL */
+    pfault_detect->reactionClass[14] = OVERSPEED_REACTION;      /* OVERSPEED */
+    pfault_detect->reactionClass[15] = POSITION_JUMP_REACTION;  /* POSITION_JUMP */
+    pfault_detect->reactionClass[16] = SPEED_MISMATCH_REACTION; /* SPEED_MISMATCH */
+    pfault_detect->reactionClass[17] = MC1_FAULT_REACTION_TRIP; /* SUPERVISOR */
+    
+    /* Initialize fault recovery parameters */
+#ifdef FAULT_AUTO_RESTART
+    pfault_detect->recovery.enable = 1;
+#else
+    pfault_detect->recovery.enable = 0;
+#endif
+    pfault_detect->recovery.delayMinCount = FAULT_RESTART_DELAY_COUNT;
+    pfault_detect->recovery.delayMaxCount = FAULT_RESTART_DELAY_MAX_COUNT;
+    pfault_detect->recovery.healthyCount = FAULT_HEALTHY_RUN_COUNT;
+    pfault_detect->recovery.retryMax[0] = FAULT_RETRY_HARDWARE;
+    pfault_detect->recovery.retryMax[1] = FAULT_RETRY_HARDWARE;
+    pfault_detect->recovery.retryMax[2] = FAULT_RETRY_PHASE_OC;
+    pfault_detect->recovery.retryMax[3] = FAULT_RETRY_PHASE_OC;
+    pfault_detect->recovery.retryMax[4] = FAULT_RETRY_PHASE_OC;
+    pfault_detect->recovery.retryMax[5] = FAULT_RETRY_PHASE_OC;
+    pfault_detect->recovery.retryMax[6] = FAULT_RETRY_CONTROL;
+    pfault_detect->recovery.retryMax[7] = FAULT_RETRY_CURRENT_OFFSET;
+    pfault_detect->recovery.retryMax[8] = FAULT_RETRY_DC_BUS;
+    pfault_detect->recovery.retryMax[9] = FAULT_RETRY_DC_BUS;
+    pfault_detect->recovery.retryMax[10] = FAULT_RETRY_WINDING;
+    pfault_detect->recovery.retryMax[11] = FAULT_RETRY_WINDING;
+    pfault_detect->recovery.retryMax[12] = FAULT_RETRY_WINDING;
+    pfault_detect->recovery.retryMax[13] = FAULT_RETRY_STALL;
+    pfault_detect->recovery.retryMax[14] = FAULT_RETRY_SPEED;
+    pfault_detect->recovery.retryMax[15] = FAULT_RETRY_SPEED;
+    pfault_detect->recovery.retryMax[16] = FAULT_RETRY_SPEED;
+    pfault_detect->recovery.retryMax[17] = FAULT_RETRY_SUPERVISOR;
+    
+    /* Initialize winding diagnostics */
+    pfault_detect->windingDiag.openCurrent      = WINDING_DIAG_OPEN_CURRENT;
+    pfault_detect->windingDiag.riseGainMin      = WINDING_DIAG_RISE_GAIN_MIN;
+    pfault_detect->windingDiag.riseGainMax      = WINDING_DIAG_RISE_GAIN_MAX;
+    pfault_detect->windingDiag.residualCurrent  = WINDING_DIAG_RESIDUAL_CURRENT;
+    pfault_detect->windingDiag.eventCount       = WINDING_DIAG_EVENT_COUNT;
+    pfault_detect->windingDiag.demagCount       = WINDING_DIAG_DEMAG_COUNT;
+    pfault_detect->windingDiag.switchFaultCount = WINDING_DIAG_SWITCH_FAULT_COUNT;
+#ifdef WINDING_DIAGNOSTICS
+    pfault_detect->windingDiag.enable           = 1;
+#else
+    pfault_detect->windingDiag.enable           = 0;
+#endif
+#ifdef WINDING_DEGRADED_MODE
+    pfault_detect->windingDiag.degradedMode     = 1;
+#else
+    pfault_detect->windingDiag.degradedMode     = 0;
+#endif
+    
+    /* Initialize speed and position sensor supervision */
+    pfault_detect->speedCheck.overspeed         = OVERSPEED_RPM;
+    pfault_detect->speedCheck.faultCount        = SPEED_FAULT_COUNT;
+    pfault_detect->speedCheck.stepChangeMax     = POSITION_STEP_CHANGE_MAX_RAD;
+    pfault_detect->speedCheck.jumpCount         = POSITION_JUMP_COUNT;
+    pfault_detect->speedCheck.strokeCurrent     = SPEED_CHECK_STROKE_CURRENT;
+    pfault_detect->speedCheck.strokeGain        = SPEED_CHECK_STROKE_GAIN;
+    pfault_detect->speedCheck.windowCount       = SPEED_CHECK_WINDOW_COUNT;
+    pfault_detect->speedCheck.tolerance         = SPEED_CHECK_TOLERANCE;
+    pfault_detect->speedCheck.mismatchCount     = SPEED_MISMATCH_WINDOWS;
+    pfault_detect->speedCheck.minSpeed          = SPEED_CHECK_MIN_RPM;
+#ifdef POSITION_SENSOR_CHECK
+    pfault_detect->speedCheck.enable            = 1;
+#else
+    pfault_detect->speedCheck.enable            = 0;
+#endif
+    
+    /* Initialize execution supervisor deadlines */
+    pSupervisor->adcMissCount       = SUPERVISOR_ADC_MISS_COUNT;
+    pSupervisor->timer1MissCount    = SUPERVISOR_TIMER1_MISS_COUNT;
+    pSupervisor->mainMissCount      = SUPERVISOR_MAIN_MISS_COUNT;
+    pSupervisor->spiErrorCount      = SUPERVISOR_SPI_ERROR_COUNT;
+#ifdef SUPERVISOR
+    pSupervisor->enable             = 1;
+#else
+    pSupervisor->enable             = 0;
+#endif
+    
+    /* Initialize efficiency sweep */
+    pSweep->pSpeedTable     = sweepSpeedTable;
+    pSweep->speedTableSize  = SWEEP_SPEED_TABLE_SIZE;
+    pSweep->pLoadTable      = sweepLoadTable;
+    pSweep->loadTableSize   = SWEEP_LOAD_TABLE_SIZE;
+    pSweep->speedBand       = SWEEP_SPEED_BAND_RPM;
+    pSweep->settleCount     = SWEEP_SETTLE_COUNT;
+    pSweep->timeoutCount    = SWEEP_POINT_TIMEOUT_COUNT;
+    pSweep->averageCount    = SWEEP_AVERAGE_COUNT;
+    MCAPP_EfficiencySweepInit(pSweep);
     
     /* Initialize application structure */
     pMCData->MCAPP_ControlSchemeInit = MCAPP_SRMControlInit;
     pMCData->MCAPP_ControlStateMachine = MCAPP_SRMStateMachine;
+    pMCData->MCAPP_ControlSchemeObserve = MCAPP_SRMCoastObserve;
+    pMCData->MCAPP_ControlSchemeFlyingStartReady = MCAPP_SRMFlyingStartReady;
+    pMCData->MCAPP_ControlSchemeFlyingStart = MCAPP_SRMFlyingStart;
     
     pMCData->MCAPP_InputsInit = MCAPP_MeasureCurrentInit;
     pMCData->MCAPP_MeasureOffset = MCAPP_MeasureCurrentOffset;
     pMCData->MCAPP_GetProcessedInputs = MCAPP_MeasureMotorInputs;
 
     pMCData->MCAPP_IsOffsetMeasurementComplete = MCAPP_MeasureCurrentOffsetStatus;
+    pMCData->MCAPP_IsOffsetValid = MCAPP_MeasureCurrentOffsetValid;
     pMCData->MCAPP_PositionSensorInit = MCAPP_AM4096magInit;
     pMCData->MCAPP_PositionSensorRead = MCAPP_AM4096magRead;   
     
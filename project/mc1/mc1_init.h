@@ -62,6 +62,10 @@ extern "C" {
 #include "motor_params.h"  
 #include "srm_control.h"
 #include "fault_detect_types.h"
+#include "fault_recorder.h"
+#include "thermal_model.h"
+#include "supervisor.h"
+#include "efficiency_sweep.h"
 
     
 // </editor-fold>
@@ -75,7 +79,10 @@ typedef struct
         runCmd,             /* Run command for motor */
         runCmdBuffer,       /* Run command buffer for validation */
         dirCmd,             /* Change direction command for motor */
-        dirCmdBuffer;       /* Change direction command buffer for validation */
+        dirCmdBuffer,       /* Change direction command buffer for validation */
+        brakeCounter,       /* Control loop executions in braking to stop */
+        faultLogBusy,       /* 1 = fault log is written, start is blocked */
+        runCmdInhibit;      /* 1 = run command is ignored until it is removed */
         
     float
         targetVelocity,     /* Target motor Velocity */
@@ -97,17 +104,34 @@ typedef struct
     MCAPP_FAULT_DETECT_T    /* Motor faults */
         fault_detect;
     
+    MCAPP_FAULT_RECORDER_T  /* Fault capture and log */
+        faultRecorder;
+    
+    MCAPP_THERMAL_MODEL_T   /* Winding and power stage temperatures */
+        thermalModel;
+    
+    MCAPP_SUPERVISOR_T      /* Interrupt and main loop deadlines */
+        supervisor;
+    
+    MCAPP_EFFICIENCY_SWEEP_T /* Efficiency map measurement */
+        efficiencySweep;
+    
     MCAPP_MEASURE_T *pMotorInputs;
     MCAPP_MOTOR_T *pMotor;
     MCAPP_CONTROL_SCHEME_T *pControlScheme;
     MC_DUTYCYCLEOUT_T *pPWMDuty;
     MCAPP_FAULT_DETECT_T *pfaultDetect;
+    MCAPP_FAULT_RECORDER_T *pFaultRecorder;
+    MCAPP_THERMAL_MODEL_T *pThermalModel;
+    MCAPP_SUPERVISOR_T *pSupervisor;
+    MCAPP_EFFICIENCY_SWEEP_T *pEfficiencySweep;
     
     /* Function pointers for motor inputs */ 
     void (*MCAPP_InputsInit) (MCAPP_MEASURE_T *);
     void (*MCAPP_MeasureOffset) (MCAPP_MEASURE_T *);
     void (*MCAPP_GetProcessedInputs) (MCAPP_MEASURE_T *);
     uint32_t (*MCAPP_IsOffsetMeasurementComplete) (MCAPP_MEASURE_T *);
+    uint32_t (*MCAPP_IsOffsetValid) (MCAPP_MEASURE_T *);
     void (*HAL_MotorInputsRead) (MCAPP_MEASURE_T *);
     void (*MCAPP_PositionSensorInit) (MCAPP_AM4096_T *);
     void (*MCAPP_PositionSensorRead) (MCAPP_AM4096_T *);
@@ -115,6 +139,9 @@ typedef struct
     /* Function pointers for control scheme */
     void (*MCAPP_ControlSchemeInit) (MCAPP_CONTROL_SCHEME_T *);
     void (*MCAPP_ControlStateMachine) (MCAPP_CONTROL_SCHEME_T *);
+    void (*MCAPP_ControlSchemeObserve) (MCAPP_CONTROL_SCHEME_T *);
+    bool (*MCAPP_ControlSchemeFlyingStartReady) (MCAPP_CONTROL_SCHEME_T *);
+    void (*MCAPP_ControlSchemeFlyingStart) (MCAPP_CONTROL_SCHEME_T *);
        
     /* Function pointers for motor outputs */
     void (*HAL_PWMSetDutyCycles)(MC_DUTYCYCLEOUT_T *);
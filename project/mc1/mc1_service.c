@@ -55,6 +55,8 @@
 #include "mc1_init.h"
 #include "mc_app_types.h"
 #include "mc1_service.h"
+#include "fault_detect.h"
+#include "wdt.h"
 
 // </editor-fold>
 
@@ -66,9 +68,10 @@ MC1APP_DATA_T *pMC1Data = &mc1;
 // </editor-fold>
 
 // <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
-extern void MCAPP_FaultDetect(MCAPP_FAULT_DETECT_T *, MCAPP_MEASURE_T *);
 static void MC1APP_StateMachine(MC1APP_DATA_T *);
 static void MCAPP_MC1ReceivedDataProcess(MC1APP_DATA_T *);
+static void MC1APP_FaultRecorderUpdate(MC1APP_DATA_T *);
+static void MC1APP_EfficiencySweepStep(MC1APP_DATA_T *);
 // </editor-fold>
 
 /**
@@ -85,17 +88,20 @@ static void MCAPP_MC1ReceivedDataProcess(MC1APP_DATA_T *);
 */
 void __attribute__((__interrupt__,no_auto_psv)) _PWMInterrupt()
 {
+    uint32_t detected = 0;
+    
     LED2 = 0;
     pMC1Data->HAL_PWMDisableOutputs();
     HAL_ResetPeripherals();
     if( MC1_OV_OC_FAULT == 1)
     {
-        pMC1Data->pfaultDetect->faultStatus = MC1_OV_OC_FAULT_DETECT;
+        detected |= MC1_OV_OC_FAULT_DETECT;
     }
     if( MC1_CS_OC_FAULT == 1)
     {
-        pMC1Data->pfaultDetect->faultStatus = MC1_OVERCURRENT_FAULT_DETECT;
+        detected |= MC1_OVERCURRENT_FAULT_DETECT;
     }
+    pMC1Data->pfaultDetect->hardwarePending |= detected;
     ClearPWMPCIFault();
     ClearPWMIF(); 
 }
@@ -115,7 +121,12 @@ static void MC1APP_StateMachine(MC1APP_DATA_T *pMCData)
 {
     MCAPP_MEASURE_T *pMotorInputs = pMCData->pMotorInputs;
     MCAPP_CONTROL_SCHEME_T *pControlScheme = pMCData->pControlScheme;
-    MCAPP_FAULT_DETECT_T *pfaultDetect = pMCData->pfaultDetect;;
+    MCAPP_FAULT_DETECT_T *pfaultDetect = pMCData->pfaultDetect;
+    uint32_t reaction;
+    uint32_t hardwareFaults;
+    float thermalDerate = 1.0f;
+    
+    MCAPP_MeasureVdcFilter(pMotorInputs);
     
     switch(pMCData->appState)
     {
@@ -125,57 +136,154 @@ static void MC1APP_StateMachine(MC1APP_DATA_T *pMCData)
 
         /* Stop the motor */
         pMCData->runCmd = 0;
+        pMCData->brakeCounter = 0;
         
         pMCData->MCAPP_ControlSchemeInit(pControlScheme);
         pMCData->MCAPP_InputsInit(pMotorInputs);
         pMCData->MCAPP_PositionSensorInit(&pMotorInputs->detectRotorPosition);
         
+        MCAPP_FaultDetectWindingReset(pfaultDetect);
+        MCAPP_FaultDetectSpeedReset(pfaultDetect);
+        
         pMCData->appState = MCAPP_CMD_WAIT;
 
         break;
         
     case MCAPP_CMD_WAIT:
-        if(pMCData->runCmd == 1)
+        if(pControlScheme->flyingStart.enable == 1)
+        {
+            /* Track speed of coasting rotor for flying start */
+            pMCData->MCAPP_PositionSensorRead(&pMotorInputs->detectRotorPosition);
+            pMCData->MCAPP_ControlSchemeObserve(pControlScheme);
+        }
+        /* Start waits for the fault log write, CPU is stalled during flash
+           operations */
+        if((pMCData->runCmd == 1) && (pMCData->faultLogBusy == 0))
         {
+            if(pMCData->MCAPP_ControlSchemeFlyingStartReady(pControlScheme))
+            {
+                /* Phase currents are zero while coasting, a shorter offset
+                   measurement is sufficient */
+                pMotorInputs->measureCurrent.countBits = 
+                                                FLYING_START_OFFSET_COUNT_BITS;
+            }
+            /* Capture of previous fault is discarded on restart */
+            MCAPP_FaultRecorderArm(pMCData->pFaultRecorder);
             pMCData->appState = MCAPP_OFFSET;
         }
        break;
        
     case MCAPP_OFFSET:
 
+        if(pControlScheme->flyingStart.enable == 1)
+        {
+            pMCData->MCAPP_PositionSensorRead(&pMotorInputs->detectRotorPosition);
+            pMCData->MCAPP_ControlSchemeObserve(pControlScheme);
+        }
+        
         /* Measure Initial Offsets */
         pMCData->MCAPP_MeasureOffset(pMotorInputs);
 
         if(pMCData->MCAPP_IsOffsetMeasurementComplete(pMotorInputs))
         {
+            /* Faulty current sensing circuit trips the drive */
+            MCAPP_FaultReport(pfaultDetect, 
+                    (pMCData->MCAPP_IsOffsetValid(pMotorInputs) == 0) ? 
+                            MC1_CURRENT_OFFSET_FAULT_DETECT : 0,
+                                            MC1_CURRENT_OFFSET_FAULT_DETECT);
+#ifdef HARDWARE_HCC
+            /* Current offsets for comparator DAC thresholds */
+            HAL_MC1HCCOffsetSet(pMotorInputs);
+#endif
+            if(pMCData->MCAPP_ControlSchemeFlyingStartReady(pControlScheme))
+            {
+                pMCData->MCAPP_ControlSchemeFlyingStart(pControlScheme);
+            }
             pMCData->appState = MCAPP_RUN;
         }
 
         break;
             
     case MCAPP_RUN:
+    case MCAPP_BRAKE:
         
         /* Compensate motor current offsets */
         pMCData->MCAPP_GetProcessedInputs(pMotorInputs);
         
         pMCData->MCAPP_PositionSensorRead(&pMotorInputs->detectRotorPosition);
         
+        /* Efficiency sweep sets the speed target while active */
+        MC1APP_EfficiencySweepStep(pMCData);
+        
         pMCData->MCAPP_ControlStateMachine(pControlScheme);
         
-        /* Check for Phase currents faults */
+        /* Check for Phase currents faults, thresholds follow the reference 
+           of the active phase */
+        MCAPP_FaultDetectOcThresholdUpdate(pfaultDetect, 
+            pControlScheme->referenceCurrent,
+            (pControlScheme->positionControl.holdActive == 0) ? 
+                                        pControlScheme->ctrlParam.phaseOn : 0);
         MCAPP_FaultDetect(pfaultDetect,pMotorInputs);
         
+        /* Check for DC bus under voltage and over voltage */
+        MCAPP_FaultDetectDcBus(pfaultDetect, pMotorInputs);
+        
+        /* Check for overspeed and position sensor plausibility */
+        MCAPP_FaultDetectSpeed(pfaultDetect, pMotorInputs);
+        
+        /* Check for open phase, shorted winding and switch faults, current
+           rise is known only for a single phase chopped by software HCC */
+        MCAPP_FaultDetectWinding(pfaultDetect, pMotorInputs,
+            (pControlScheme->positionControl.holdActive == 0) ? 
+                                        pControlScheme->ctrlParam.phaseOn : 0,
+            (pControlScheme->switchState == true) && 
+                                        (pControlScheme->hwHccActive == false));
+        pControlScheme->disabledPhases = pfaultDetect->windingDiag.disabledPhases;
+        
         /* Check for control scheme faults */
-        if(pControlScheme->faultStatus == 1) 
-        {
-            pMCData->appState = MCAPP_FAULT;
-            break;
-        }
+        MCAPP_FaultReport(pfaultDetect, 
+                (pControlScheme->faultStatus == 1) ? MC1_CONTROL_FAULT_DETECT : 0,
+                                                    MC1_CONTROL_FAULT_DETECT);
+        
+        /* Check for locked rotor in speed control */
+        MCAPP_FaultReport(pfaultDetect, 
+                (pControlScheme->stall.detected == 1) ? MC1_STALL_FAULT_DETECT : 0,
+                                                    MC1_STALL_FAULT_DETECT);
+        
+        /* Retries of fault recovery are reset after healthy run */
+        MCAPP_FaultRecoveryHealthy(pfaultDetect);
         
         if (pMCData->runCmd == 0)
         {
-            /* Exit loop if motor not run */
-            pMCData->appState = MCAPP_STOP;
+            if((pControlScheme->regen.enable == 1) && 
+                (pControlScheme->ctrlParam.speedLoop == 1) &&
+                (pControlScheme->ctrlParam.positionLoop == 0) &&
+                (pControlScheme->speed > REGEN_STOP_SPEED_RPM) &&
+                (pMotorInputs->measureVdc.value <= 
+                                    pMotorInputs->measureVdc.dcMaxStop) &&
+                (pMCData->brakeCounter < REGEN_STOP_TIMEOUT_COUNT))
+            {
+                /* Brake the motor to stop */
+                if(pMCData->appState == MCAPP_RUN)
+                {
+                    pMCData->brakeCounter = 0;
+                    pMCData->appState = MCAPP_BRAKE;
+                }
+                pMCData->brakeCounter++;
+                pControlScheme->regen.brakeStop = 1;
+            }
+            else
+            {
+                /* Exit loop if motor not run */
+                pMCData->appState = MCAPP_STOP;
+            }
+        }
+        else if(pMCData->appState == MCAPP_BRAKE)
+        {
+            /* Run command received while braking */
+            pControlScheme->regen.brakeStop = 0;
+            pMCData->brakeCounter = 0;
+            pMCData->appState = MCAPP_RUN;
         }
         break;
 
@@ -187,6 +295,26 @@ static void MC1APP_StateMachine(MC1APP_DATA_T *pMCData)
         
     case MCAPP_FAULT:
         pMCData->HAL_PWMDisableOutputs();
+        
+        /* Motor restarts with the present run command only by automatic 
+           recovery, after a reset request a new run command is required */
+        if(pfaultDetect->recovery.resetRequest == 1)
+        {
+            pMCData->runCmdInhibit = 1;
+        }
+        
+        /* Faults are cleared once hardware fault inputs are inactive and
+           DC bus voltage is in the run range, current offsets are checked 
+           again on restart */
+        if(MCAPP_FaultRecoveryStep(pfaultDetect, 
+            (MC1_OV_OC_FAULT == 0) && (MC1_CS_OC_FAULT == 0) &&
+            (pMotorInputs->measureVdc.filtered >= pMotorInputs->measureVdc.dcMinRun) &&
+            (pMotorInputs->measureVdc.filtered <= pMotorInputs->measureVdc.dcMaxStop)))
+        {
+            pControlScheme->faultStatus = 0;
+            MCAPP_SupervisorClear(pMCData->pSupervisor);
+            pMCData->appState = MCAPP_INIT;
+        }
         break;
         
     default:
@@ -194,12 +322,64 @@ static void MC1APP_StateMachine(MC1APP_DATA_T *pMCData)
         break;     
 
     } /* end of switch-case */
+    
+    /* Efficiency sweep is aborted once the motor leaves run state */
+    if(pMCData->appState != MCAPP_RUN)
+    {
+        MCAPP_EfficiencySweepAbort(pMCData->pEfficiencySweep);
+    }
 
+    /* Phase currents are measured only while the outputs are enabled */
+    if((pMCData->appState == MCAPP_RUN) || (pMCData->appState == MCAPP_BRAKE))
+    {
+        MCAPP_ThermalModelUpdate(pMCData->pThermalModel, 
+                        pMotorInputs->iabcd.a, pMotorInputs->iabcd.b,
+                        pMotorInputs->iabcd.c, pMotorInputs->iabcd.d);
+    }
+    else
+    {
+        MCAPP_ThermalModelUpdate(pMCData->pThermalModel, 0, 0, 0, 0);
+    }
+    if(pMCData->pThermalModel->enable == 1)
+    {
+        thermalDerate = pMCData->pThermalModel->derate;
+    }
+    
+    /* Report faults of PWM fault interrupt, the interrupt is disabled while
+       the pending faults are taken */
+    DisablePWMIF();
+    hardwareFaults = pfaultDetect->hardwarePending;
+    pfaultDetect->hardwarePending = 0;
+    EnablePWMIF();
+    if(hardwareFaults != 0)
+    {
+        MCAPP_FaultReport(pfaultDetect, hardwareFaults, MC1_HARDWARE_FAULTS);
+    }
+    
+    /* Check for missed deadlines of interrupts, main loop and SPI */
+    MCAPP_FaultReport(pfaultDetect, 
+            (pMCData->pSupervisor->missed != 0) ? MC1_SUPERVISOR_FAULT_DETECT : 0,
+                                                MC1_SUPERVISOR_FAULT_DETECT);
+    
     /* Fault Handler */
-    if(pfaultDetect->faultStatus > 0)
+    reaction = MCAPP_FaultReactionUpdate(pfaultDetect);
+    if(reaction == MC1_FAULT_REACTION_TRIP)
     {
         pMCData->HAL_PWMDisableOutputs();
-        pMCData->appState = MCAPP_FAULT;
+        if(pMCData->appState != MCAPP_FAULT)
+        {
+            MCAPP_FaultRecoveryStart(pfaultDetect);
+            pMCData->appState = MCAPP_FAULT;
+        }
+    }
+    else if(reaction == MC1_FAULT_REACTION_DERATE)
+    {
+        pControlScheme->currentDerate = pfaultDetect->derateFactor * 
+                                                                thermalDerate;
+    }
+    else
+    {
+        pControlScheme->currentDerate = thermalDerate;
     }
 }
 
@@ -215,10 +395,15 @@ static void MC1APP_StateMachine(MC1APP_DATA_T *pMCData)
 */
 void __attribute__((__interrupt__, no_auto_psv))MC1_ADC_INTERRUPT(void)
 {   
+    MCAPP_SupervisorAdcStep(pMC1Data->pSupervisor, 
+                pMC1Data->motorInputs.detectRotorPosition.readErrors);
+    
     pMC1Data->HAL_MotorInputsRead(pMC1Data->pMotorInputs);
     
     MC1APP_StateMachine(pMC1Data);
     
+    MC1APP_FaultRecorderUpdate(pMC1Data);
+    
     #ifdef ENABLE_DIAGNOSTICS
         DiagnosticsStepIsr();
     #endif
@@ -230,6 +415,54 @@ void __attribute__((__interrupt__, no_auto_psv))MC1_ADC_INTERRUPT(void)
 void MCAPP_MC1ServiceInit(void)
 {
     MCAPP_MC1ParamsInit(pMC1Data);
+    
+    MCAPP_SupervisorInit(pMC1Data->pSupervisor, WDT_ResetFlagGet());
+    if(pMC1Data->pSupervisor->enable == 1)
+    {
+        WDT_Enable();
+    }
+}
+
+/**
+* <B> Function: MCAPP_MC1SupervisorTimer1Step()  </B>
+*
+* @brief Function to check the control loop and main loop deadlines, to be 
+*        called from Timer1 interrupt. PWM outputs are disabled once the 
+*        control loop is no longer triggered. A control loop hung inside the
+*        ADC interrupt blocks Timer1 and is covered by the watchdog reset.
+*
+* @param none.
+* @return none.
+* @example
+* <CODE> MCAPP_MC1SupervisorTimer1Step(); </CODE>
+*
+*/
+void MCAPP_MC1SupervisorTimer1Step(void)
+{
+    if(MCAPP_SupervisorTimer1Step(pMC1Data->pSupervisor))
+    {
+        pMC1Data->HAL_PWMDisableOutputs();
+    }
+}
+
+/**
+* <B> Function: MCAPP_MC1SupervisorMainStep()  </B>
+*
+* @brief Function to update the main loop heartbeat and clear the watchdog 
+*        while the interrupts are alive, to be called from main loop.
+*
+* @param none.
+* @return none.
+* @example
+* <CODE> MCAPP_MC1SupervisorMainStep(); </CODE>
+*
+*/
+void MCAPP_MC1SupervisorMainStep(void)
+{
+    if(MCAPP_SupervisorMainStep(pMC1Data->pSupervisor))
+    {
+        WDT_Clear();
+    }
 }
 
 void MCAPP_MC1InputBufferSet(uint32_t runCmd,uint32_t chgDirCmd, float potentiometerInput)
@@ -259,6 +492,433 @@ float MCAPP_MC1GetTargetVelocity(void)
     return potValueNormalized;
 }
 
+/**
+* <B> Function: MCAPP_MC1StatusGet(MC1APP_STATUS_T *)  </B>
+*
+* @brief Function to read the drive status for communication interfaces.
+*
+* @param Pointer to the status data structure to be updated.
+* @return none.
+* @example
+* <CODE> MCAPP_MC1StatusGet(&status); </CODE>
+*
+*/
+void MCAPP_MC1StatusGet(MC1APP_STATUS_T *pStatus)
+{
+    MCAPP_CONTROL_SCHEME_T *pControlScheme = pMC1Data->pControlScheme;
+    
+    pStatus->appState           = pMC1Data->appState;
+    pStatus->runCmd             = pMC1Data->runCmd;
+    pStatus->runDirection       = pControlScheme->runDirection;
+    pStatus->speedLoop          = pControlScheme->ctrlParam.speedLoop;
+    pStatus->positionLoop       = pControlScheme->ctrlParam.positionLoop;
+    pStatus->faultStatus        = pMC1Data->pfaultDetect->faultStatus;
+    pStatus->faultFirst         = pMC1Data->pfaultDetect->firstFault;
+    pStatus->faultReaction      = pMC1Data->pfaultDetect->reaction;
+    pStatus->faultLockout       = pMC1Data->pfaultDetect->recovery.lockout;
+    pStatus->faultRestarts      = pMC1Data->pfaultDetect->recovery.attempt;
+    pStatus->faultPhases        = pMC1Data->pfaultDetect->windingDiag.openPhases |
+                    (pMC1Data->pfaultDetect->windingDiag.shortedPhases << 4) |
+                    (pMC1Data->pfaultDetect->windingDiag.switchFaultPhases << 8);
+    pStatus->controlFaultStatus = pControlScheme->faultStatus;
+    pStatus->supervisorMissed   = pMC1Data->pSupervisor->missed;
+    pStatus->watchdogReset      = pMC1Data->pSupervisor->watchdogReset;
+    pStatus->faultCaptureState  = pMC1Data->pFaultRecorder->state;
+    pStatus->faultLogCount      = 
+                    MCAPP_FaultRecorderLogCount(pMC1Data->pFaultRecorder);
+    pStatus->speed              = pControlScheme->speed;
+    pStatus->speedTarget        = pControlScheme->ctrlParam.speedTarget;
+    pStatus->referenceCurrent   = pControlScheme->referenceCurrent;
+    pStatus->dcBusVoltage       = pMC1Data->pMotorInputs->measureVdc.value;
+    pStatus->windingTemperature = pMC1Data->pThermalModel->winding[
+                    pMC1Data->pThermalModel->hottestPhase].temperature;
+    pStatus->inverterTemperature = 
+                    pMC1Data->pThermalModel->inverter.temperature;
+    pStatus->thermalDerate      = pMC1Data->pThermalModel->derate;
+    pStatus->position           = pControlScheme->position * (180.0f / M_PI);
+    pStatus->sweepState         = pMC1Data->pEfficiencySweep->state;
+    pStatus->sweepPoint         = pMC1Data->pEfficiencySweep->point;
+    pStatus->sweepPointCount    = pMC1Data->pEfficiencySweep->pointCount;
+    pStatus->sweepSpeedTarget   = pMC1Data->pEfficiencySweep->speedTarget;
+    pStatus->sweepLoadSetpoint  = pMC1Data->pEfficiencySweep->loadSetpoint;
+}
+
+/**
+* <B> Function: MCAPP_MC1SpeedToControlInput(float)  </B>
+*
+* @brief Function to convert target speed to control input scale (0 - 4095).
+*
+* @param Target speed (RPM).
+* @return Control input, outside 0 - 4095 if speed is out of range.
+* @example
+* <CODE> controlInput = MCAPP_MC1SpeedToControlInput(speed); </CODE>
+*
+*/
+float MCAPP_MC1SpeedToControlInput(float speed)
+{
+    MCAPP_CONTROL_SCHEME_T *pControlScheme = pMC1Data->pControlScheme;
+    
+    return ((speed - pControlScheme->motor.minSpeed) * 4095.0f) /
+            (pControlScheme->motor.maxSpeed - pControlScheme->motor.minSpeed);
+}
+
+/**
+* <B> Function: MCAPP_MC1CurrentToControlInput(float)  </B>
+*
+* @brief Function to convert reference current to control input scale 
+*        (0 - 4095).
+*
+* @param Reference current (A).
+* @return Control input, outside 0 - 4095 if current is out of range.
+* @example
+* <CODE> controlInput = MCAPP_MC1CurrentToControlInput(current); </CODE>
+*
+*/
+float MCAPP_MC1CurrentToControlInput(float current)
+{
+    return (current * 4095.0f) / pMC1Data->pControlScheme->maxCurrentRef;
+}
+
+/**
+* <B> Function: MCAPP_MC1PositionToControlInput(float)  </B>
+*
+* @brief Function to convert target position to control input scale 
+*        (0 - 4095).
+*
+* @param Target position (degree).
+* @return Control input, outside 0 - 4095 if position is out of range.
+* @example
+* <CODE> controlInput = MCAPP_MC1PositionToControlInput(position); </CODE>
+*
+*/
+float MCAPP_MC1PositionToControlInput(float position)
+{
+    return (position * (M_PI / 180.0f) * 4095.0f) / 
+                                    pMC1Data->pControlScheme->positionControl.range;
+}
+
+/**
+* <B> Function: MCAPP_MC1AutotuneRequest()  </B>
+*
+* @brief Function to request speed loop autotune. Request is accepted only 
+*        when the motor is running in speed control.
+*
+* @param none.
+* @return true if request is accepted.
+* @example
+* <CODE> accepted = MCAPP_MC1AutotuneRequest(); </CODE>
+*
+*/
+bool MCAPP_MC1AutotuneRequest(void)
+{
+    MCAPP_CONTROL_SCHEME_T *pControlScheme = pMC1Data->pControlScheme;
+    
+    if((pMC1Data->appState != MCAPP_RUN) || 
+                                    (pControlScheme->ctrlParam.speedLoop != 1) ||
+                                    (pControlScheme->ctrlParam.positionLoop != 0))
+    {
+        return false;
+    }
+    pControlScheme->autotune.request = 1;
+    return true;
+}
+
+/**
+* <B> Function: MCAPP_MC1EfficiencySweepRequest()  </B>
+*
+* @brief Function to request the efficiency sweep. Request is accepted only 
+*        when the motor is running in speed control.
+*
+* @param none.
+* @return true if request is accepted.
+* @example
+* <CODE> accepted = MCAPP_MC1EfficiencySweepRequest(); </CODE>
+*
+*/
+bool MCAPP_MC1EfficiencySweepRequest(void)
+{
+    MCAPP_CONTROL_SCHEME_T *pControlScheme = pMC1Data->pControlScheme;
+    
+    if((pMC1Data->appState != MCAPP_RUN) || 
+                                    (pControlScheme->ctrlParam.speedLoop != 1) ||
+                                    (pControlScheme->ctrlParam.positionLoop != 0))
+    {
+        return false;
+    }
+    pMC1Data->pEfficiencySweep->request = 1;
+    return true;
+}
+
+/**
+* <B> Function: MCAPP_MC1EfficiencySweepAbort()  </B>
+*
+* @brief Function to request abort of the efficiency sweep, the speed target
+*        returns to the control input.
+*
+* @param none.
+* @return none.
+* @example
+* <CODE> MCAPP_MC1EfficiencySweepAbort(); </CODE>
+*
+*/
+void MCAPP_MC1EfficiencySweepAbort(void)
+{
+    pMC1Data->pEfficiencySweep->abortRequest = 1;
+}
+
+/**
+* <B> Function: MCAPP_MC1EfficiencySweepPointGet(uint32_t, 
+*                                           MCAPP_EFFICIENCY_POINT_T *)  </B>
+*
+* @brief Function to read the result of a point of the efficiency sweep.
+*
+* @param Point index, in the order of measurement.
+* @param Pointer to the result to be updated.
+* @return true if the point is measured.
+* @example
+* <CODE> MCAPP_MC1EfficiencySweepPointGet(0, &result); </CODE>
+*
+*/
+bool MCAPP_MC1EfficiencySweepPointGet(uint32_t index, 
+                                        MCAPP_EFFICIENCY_POINT_T *pResult)
+{
+    return MCAPP_EfficiencySweepPointGet(pMC1Data->pEfficiencySweep, index,
+                                                                    pResult);
+}
+
+/**
+* <B> Function: MCAPP_MC1FaultCounterGet(uint32_t)  </B>
+*
+* @brief Function to read the number of occurrences of a fault.
+*
+* @param Fault index, bit position in MC1_FAULT_DETECT_FLAG.
+* @return Number of occurrences, 0 for invalid index.
+* @example
+* <CODE> count = MCAPP_MC1FaultCounterGet(0); </CODE>
+*
+*/
+uint32_t MCAPP_MC1FaultCounterGet(uint32_t index)
+{
+    if(index >= MC1_FAULT_COUNT)
+    {
+        return 0;
+    }
+    return pMC1Data->pfaultDetect->faultCounter[index];
+}
+
+/**
+* <B> Function: MCAPP_MC1FaultReset()  </B>
+*
+* @brief Function to request reset of the faults and the recovery lockout. 
+*        Faults are cleared in the control loop if the fault conditions are
+*        removed, then the drive is initialized. The motor is not restarted
+*        until the run command is removed and given again.
+*
+* @param none.
+* @return true if request is accepted, drive is in fault state.
+* @example
+* <CODE> accepted = MCAPP_MC1FaultReset(); </CODE>
+*
+*/
+bool MCAPP_MC1FaultReset(void)
+{
+    if(pMC1Data->appState != MCAPP_FAULT)
+    {
+        return false;
+    }
+    pMC1Data->pfaultDetect->recovery.resetRequest = 1;
+    return true;
+}
+
+/**
+* <B> Function: MCAPP_MC1FaultLogService()  </B>
+*
+* @brief Function to write fault events to the flash log, to be called from 
+*        main loop. Flash is written only when the motor is not running, as 
+*        the CPU is stalled during flash operations. Start of the motor is 
+*        blocked until the write is complete.
+*
+* @param none.
+* @return none.
+* @example
+* <CODE> MCAPP_MC1FaultLogService(); </CODE>
+*
+*/
+void MCAPP_MC1FaultLogService(void)
+{
+    uint32_t isrState;
+    
+    /* State is checked and start is blocked without the control loop 
+       interrupt in between */
+    isrState = __builtin_get_isr_state();
+    __builtin_disable_interrupts();
+    if((pMC1Data->appState == MCAPP_CMD_WAIT) || 
+                                        (pMC1Data->appState == MCAPP_FAULT))
+    {
+        pMC1Data->faultLogBusy = 1;
+    }
+    __builtin_set_isr_state(isrState);
+    
+    if(pMC1Data->faultLogBusy == 1)
+    {
+        MCAPP_FaultRecorderLogWrite(pMC1Data->pFaultRecorder);
+        pMC1Data->faultLogBusy = 0;
+    }
+}
+
+/**
+* <B> Function: MCAPP_MC1FaultLogGet(uint32_t, MCAPP_FAULT_LOG_ENTRY_T *)  </B>
+*
+* @brief Function to read an entry of the fault log.
+*
+* @param Entry index, 0 = latest fault event.
+* @param Pointer to the entry to be updated.
+* @return true if the entry exists.
+* @example
+* <CODE> MCAPP_MC1FaultLogGet(0, &entry); </CODE>
+*
+*/
+bool MCAPP_MC1FaultLogGet(uint32_t index, MCAPP_FAULT_LOG_ENTRY_T *pEntry)
+{
+    return MCAPP_FaultRecorderLogGet(pMC1Data->pFaultRecorder, index, pEntry);
+}
+
+/**
+* <B> Function: MCAPP_MC1FaultCaptureGet(uint32_t, MCAPP_FAULT_SAMPLE_T *)  </B>
+*
+* @brief Function to read a sample of the captured fault.
+*
+* @param Sample index, 0 = oldest sample.
+* @param Pointer to the sample to be updated.
+* @return true if capture is complete and the index is valid.
+* @example
+* <CODE> MCAPP_MC1FaultCaptureGet(0, &sample); </CODE>
+*
+*/
+bool MCAPP_MC1FaultCaptureGet(uint32_t index, MCAPP_FAULT_SAMPLE_T *pSample)
+{
+    return MCAPP_FaultRecorderSampleGet(pMC1Data->pFaultRecorder, index, 
+                                                                    pSample);
+}
+
+/**
+* <B> Function: MCAPP_MC1FaultCaptureArm()  </B>
+*
+* @brief Function to discard the captured fault and restart the capture.
+*
+* @param none.
+* @return none.
+* @example
+* <CODE> MCAPP_MC1FaultCaptureArm(); </CODE>
+*
+*/
+void MCAPP_MC1FaultCaptureArm(void)
+{
+    MCAPP_FaultRecorderArm(pMC1Data->pFaultRecorder);
+}
+
+/**
+* <B> Function: MC1APP_EfficiencySweepStep (MC1APP_DATA_T *)  </B>
+*
+* @brief Function to start, step and abort the efficiency sweep and to set
+*        the control input to the speed target of the present point. Sweep 
+*        is aborted if speed control is left or autotune is started.
+*
+* @param Pointer to the data structure containing Application parameters.
+* @return none.
+* @example
+* <CODE> MC1APP_EfficiencySweepStep(&pMCData); </CODE>
+*
+*/
+static void MC1APP_EfficiencySweepStep(MC1APP_DATA_T *pMCData)
+{
+    MCAPP_CONTROL_SCHEME_T *pControlScheme = pMCData->pControlScheme;
+    MCAPP_MEASURE_T *pMotorInputs = pMCData->pMotorInputs;
+    MCAPP_EFFICIENCY_SWEEP_T *pSweep = pMCData->pEfficiencySweep;
+    MCAPP_EFFICIENCY_SAMPLE_T sample;
+    float controlInput;
+    
+    if((pSweep->abortRequest == 1) || (pMCData->appState != MCAPP_RUN) ||
+                            (pControlScheme->ctrlParam.speedLoop != 1) ||
+                            (pControlScheme->ctrlParam.positionLoop != 0) ||
+                            (pControlScheme->autotune.state == AUTOTUNE_RELAY))
+    {
+        MCAPP_EfficiencySweepAbort(pSweep);
+        return;
+    }
+    if(pSweep->request == 1)
+    {
+        MCAPP_EfficiencySweepStart(pSweep);
+    }
+    if(!MCAPP_EfficiencySweepActive(pSweep))
+    {
+        return;
+    }
+    
+    sample.speed            = pControlScheme->speed;
+    sample.dcBusVoltage     = pMotorInputs->measureVdc.value;
+    sample.motorCurrent     = pMotorInputs->motorCurrent;
+    sample.referenceCurrent = pControlScheme->referenceCurrent;
+    sample.current[0]       = pMotorInputs->iabcd.a;
+    sample.current[1]       = pMotorInputs->iabcd.b;
+    sample.current[2]       = pMotorInputs->iabcd.c;
+    sample.current[3]       = pMotorInputs->iabcd.d;
+    MCAPP_EfficiencySweepUpdate(pSweep, &sample);
+    
+    if(MCAPP_EfficiencySweepActive(pSweep))
+    {
+        /* Speed target of the point replaces control input of potentiometer
+           or communication interface */
+        controlInput = MCAPP_MC1SpeedToControlInput(pSweep->speedTarget);
+        if(controlInput < 0)
+        {
+            controlInput = 0;
+        }
+        else if(controlInput > 4095.0f)
+        {
+            controlInput = 4095.0f;
+        }
+        pControlScheme->ctrlParam.controlInput = controlInput;
+    }
+}
+
+/**
+* <B> Function: MC1APP_FaultRecorderUpdate (MC1APP_DATA_T *)  </B>
+*
+* @brief Function to pass the present control loop sample and fault status 
+*        to fault recorder.
+*
+* @param Pointer to the data structure containing Application parameters.
+* @return none.
+* @example
+* <CODE> MC1APP_FaultRecorderUpdate(&pMCData); </CODE>
+*
+*/
+static void MC1APP_FaultRecorderUpdate(MC1APP_DATA_T *pMCData)
+{
+    MCAPP_CONTROL_SCHEME_T *pControlScheme = pMCData->pControlScheme;
+    MCAPP_MEASURE_T *pMotorInputs = pMCData->pMotorInputs;
+    MCAPP_FAULT_SAMPLE_T sample;
+    
+    sample.ia = (int16_t)(pMotorInputs->iabcd.a * 1000.0f);
+    sample.ib = (int16_t)(pMotorInputs->iabcd.b * 1000.0f);
+    sample.ic = (int16_t)(pMotorInputs->iabcd.c * 1000.0f);
+    sample.id = (int16_t)(pMotorInputs->iabcd.d * 1000.0f);
+    sample.va = (int16_t)(pMotorInputs->vabcd.a * 10.0f);
+    sample.vb = (int16_t)(pMotorInputs->vabcd.b * 10.0f);
+    sample.vc = (int16_t)(pMotorInputs->vabcd.c * 10.0f);
+    sample.vd = (int16_t)(pMotorInputs->vabcd.d * 10.0f);
+    sample.theta = (uint16_t)(pControlScheme->theta * 
+                                                (65535.0f / (2.0f * M_PI)));
+    sample.speed = (int16_t)pControlScheme->velocity;
+    sample.phaseOn = (uint8_t)pControlScheme->ctrlParam.phaseOn;
+    sample.switchState = (uint8_t)pControlScheme->switchState;
+    
+    MCAPP_FaultRecorderUpdate(pMCData->pFaultRecorder, &sample,
+                            pMCData->pfaultDetect->faultStatus,
+                            pControlScheme->faultStatus, pMCData->appState);
+}
+
 static void MCAPP_MC1ReceivedDataProcess(MC1APP_DATA_T *pMCData)
 {
 
@@ -268,14 +928,26 @@ static void MCAPP_MC1ReceivedDataProcess(MC1APP_DATA_T *pMCData)
     if(pMCData->runCmd == 1)
     {
         pControlScheme->ctrlParam.controlInput = pMCData->potInput;
+        if(pControlScheme->reversal.enable == 1)
+        {
+            /* Direction is reversed by the control scheme while running */
+            pMCData->dirCmd  = pMCData->dirCmdBuffer; 
+        }
     }
-    else
+    else if(pMCData->appState != MCAPP_BRAKE)
     {
+        /* Direction is retained while braking to stop */
         pMCData->dirCmd  = pMCData->dirCmdBuffer; 
     }
     
+    /* Run command latched before a fault reset is ignored until removed */
+    if(pMCData->runCmdBuffer == 0)
+    {
+        pMCData->runCmdInhibit = 0;
+    }
+    
     if( (pMotorInputs->measureVdc.value >= pMotorInputs->measureVdc.dcMinRun) && 
-                                            (pControlScheme->faultStatus == 0) )
+            (pControlScheme->faultStatus == 0) && (pMCData->runCmdInhibit == 0))
     {
         pMCData->runCmd = pMCData->runCmdBuffer;
     }  
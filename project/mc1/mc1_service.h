@@ -57,13 +57,71 @@ extern "C" {
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "fault_recorder.h"
+#include "efficiency_sweep.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLE TYPE DEFINITIONS ">
+
+typedef struct
+{
+    uint32_t
+        appState,           /* Application state MCAPP_STATE_T */
+        runCmd,             /* Run command accepted by application */
+        runDirection,       /* Direction of rotation */
+        speedLoop,          /* 1 = speed control, 0 = current control */
+        positionLoop,       /* 1 = position control */
+        faultStatus,        /* Latched faults, bits of MC1_FAULT_DETECT_FLAG */
+        faultFirst,         /* First latched fault */
+        faultReaction,      /* Present fault reaction MC1_FAULT_REACTION_T */
+        faultLockout,       /* 1 = restart locked out until fault reset */
+        faultRestarts,      /* Restarts since the drive was last healthy */
+        faultPhases,        /* Faulty phases, bits 0-3 open, 4-7 shorted, 8-11 switch */
+        controlFaultStatus, /* Fault status from control scheme */
+        supervisorMissed,   /* Contexts missed deadline MCAPP_SUPERVISOR_CONTEXT_T */
+        watchdogReset,      /* 1 = last reset was caused by watchdog */
+        faultCaptureState,  /* Fault capture MCAPP_FAULT_RECORDER_STATE_T */
+        faultLogCount,      /* Entries in fault log */
+        sweepState,         /* Efficiency sweep MCAPP_EFFICIENCY_SWEEP_STATE_T */
+        sweepPoint,         /* Points measured by efficiency sweep */
+        sweepPointCount;    /* Points of efficiency sweep */
+    float
+        speed,              /* Measured speed (RPM) */
+        speedTarget,        /* Target speed (RPM) */
+        referenceCurrent,   /* Reference current (A) */
+        dcBusVoltage,       /* DC bus voltage (V) */
+        windingTemperature, /* Estimated temperature of hottest winding (degree C) */
+        inverterTemperature,/* Estimated temperature of power stage (degree C) */
+        thermalDerate,      /* Current limit scale from thermal model */
+        position,           /* Multi-turn rotor position (degree) */
+        sweepSpeedTarget,   /* Speed target of present sweep point (RPM) */
+        sweepLoadSetpoint;  /* Load setpoint of present sweep point */
+} MC1APP_STATUS_T;
+
 // </editor-fold>
     
 // <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
 
 void    MCAPP_MC1ServiceInit(void);
+void    MCAPP_MC1SupervisorTimer1Step(void);
+void    MCAPP_MC1SupervisorMainStep(void);
 void    MCAPP_MC1InputBufferSet(uint32_t,uint32_t, float);
 float   MCAPP_MC1GetTargetVelocity(void);
+void    MCAPP_MC1StatusGet(MC1APP_STATUS_T *);
+float   MCAPP_MC1SpeedToControlInput(float);
+float   MCAPP_MC1CurrentToControlInput(float);
+float   MCAPP_MC1PositionToControlInput(float);
+bool    MCAPP_MC1AutotuneRequest(void);
+bool    MCAPP_MC1EfficiencySweepRequest(void);
+void    MCAPP_MC1EfficiencySweepAbort(void);
+bool    MCAPP_MC1EfficiencySweepPointGet(uint32_t, MCAPP_EFFICIENCY_POINT_T *);
+uint32_t MCAPP_MC1FaultCounterGet(uint32_t);
+bool    MCAPP_MC1FaultReset(void);
+void    MCAPP_MC1FaultLogService(void);
+bool    MCAPP_MC1FaultLogGet(uint32_t, MCAPP_FAULT_LOG_ENTRY_T *);
+bool    MCAPP_MC1FaultCaptureGet(uint32_t, MCAPP_FAULT_SAMPLE_T *);
+void    MCAPP_MC1FaultCaptureArm(void);
 // </editor-fold>
 
 
@@ -62,6 +62,7 @@ typedef enum
     MCAPP_RUN = 3,                      /* Run the motor */
     MCAPP_STOP = 4,                     /* Stop the motor */
     MCAPP_FAULT = 5,                    /* Motor is in Fault mode */
+    MCAPP_BRAKE = 6,                    /* Brake the motor to stop */
 
 }MCAPP_STATE_T;
 
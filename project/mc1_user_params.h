@@ -65,6 +65,11 @@ extern "C" {
  * undefine SPEED_CONTROL to enable only Current control */
 #define SPEED_CONTROL
 
+/* Define POSITION_CONTROL to enable point to point position control cascaded 
+ * with the speed control, the control input selects the target rotor angle.
+ * undefine POSITION_CONTROL for speed control. Requires SPEED_CONTROL */
+#undef POSITION_CONTROL
+
 /* Select sensor used for current measurement
  * Define ALLEGRO_CT110_CS for Allegro CT110 current sensor output
  * undefine ALLEGRO_CT110_CS for Shunt resistor current measurement */
@@ -95,14 +100,279 @@ extern "C" {
 #define NOMINAL_SPEED_RPM         1800 
 /* Enter the Maximum speed (RPM) for the motor to run in Phase Advance mode of speed control loop */
 #define MAXIMUM_SPEED_RPM         1800 
+/* Enter the average torque per ampere(Nm/A) of the motor at rated current */
+#define MOTOR_KT                  0.3f
+/* Enter the inertia(kg.m^2) of the motor and load */
+#define MOTOR_INERTIA             0.0002f
+/* Enter the phase inductance(H) at unaligned and aligned rotor position */
+#define MOTOR_INDUCTANCE_UNALIGNED    0.02f
+#define MOTOR_INDUCTANCE_ALIGNED      0.15f
 
 /* Maximum phase current(A) threshold for fault detection */  
 #define PHASE_OC_THRESHOLD        3.5f
+/* Absolute ceiling of the threshold for each phase */
+#define PHASEA_OC_THRESHOLD       PHASE_OC_THRESHOLD
+#define PHASEB_OC_THRESHOLD       PHASE_OC_THRESHOLD
+#define PHASEC_OC_THRESHOLD       PHASE_OC_THRESHOLD
+#define PHASED_OC_THRESHOLD       PHASE_OC_THRESHOLD
+/* Define DYNAMIC_OC_THRESHOLD to trip a phase above the present reference 
+ * current x (1 + PHASE_OC_REF_GAIN) + PHASE_OC_MARGIN, limited to the ceiling
+ * PHASEx_OC_THRESHOLD, so that faults at low load are found at lower current.
+ * Thresholds are at the ceiling for PHASE_OC_BLANKING_SEC after commutation.
+ * The reference follows an increase at once, a decrease no faster than the
+ * phase current decays in zero voltage freewheeling with the time constant
+ * PHASE_OC_DECAY_TIME_SEC, so that a drop of the reference (derating, 
+ * braking, lower target) does not trip the still decaying current.
+ * undefine DYNAMIC_OC_THRESHOLD to trip at the ceiling only */
+#define DYNAMIC_OC_THRESHOLD
+#define PHASE_OC_REF_GAIN         0.25f
+#define PHASE_OC_MARGIN           0.5f
+#define PHASE_OC_BLANKING_SEC     0.0005f
+/* Slowest decay of phase current, aligned inductance / phase resistance */
+#define PHASE_OC_DECAY_TIME_SEC   (MOTOR_INDUCTANCE_ALIGNED / MOTOR_PHASE_RESISTANCE)
+/* Reaction to phase current above PHASE_OC_THRESHOLD - MC1_FAULT_REACTION_WARN,
+ * MC1_FAULT_REACTION_DERATE or MC1_FAULT_REACTION_TRIP. Hardware overcurrent
+ * and overvoltage faults always trip */
+#define PHASE_OC_REACTION         MC1_FAULT_REACTION_TRIP
+/* Scale of the current limit while a derate fault is present */
+#define FAULT_DERATE_FACTOR       0.5f
+/* Time(s) derating is held after the derate fault is removed */
+#define FAULT_DERATE_HOLD_SEC     0.5f
+    
+/* Define FAULT_AUTO_RESTART to clear trip faults and restart the drive through
+ * initialization once the fault conditions are removed - DC bus voltage in
+ * range, hardware fault inputs inactive and current offsets re-measured. The
+ * restart delay is doubled on each restart, the drive is locked out when a
+ * fault trips more often than its retry count, until reset by the operator.
+ * Retries are reset after the drive has run without trip for 
+ * FAULT_HEALTHY_RUN_SEC. Undefine to stay in fault until the operator reset.
+ * After the operator reset the run command has to be removed and given again
+ * to start the motor */
+#undef FAULT_AUTO_RESTART
+/* Restarts allowed for each fault */
+#define FAULT_RETRY_HARDWARE      1
+#define FAULT_RETRY_PHASE_OC      3
+#define FAULT_RETRY_CONTROL       0
+#define FAULT_RETRY_CURRENT_OFFSET 2
+#define FAULT_RETRY_DC_BUS        5
+#define FAULT_RETRY_WINDING       0
+#define FAULT_RETRY_STALL         1
+#define FAULT_RETRY_SPEED         0
+#define FAULT_RETRY_SUPERVISOR    0
+/* Delay(s) before the first restart, and its limit as it is doubled */
+#define FAULT_RESTART_DELAY_SEC   0.5f
+#define FAULT_RESTART_DELAY_MAX_SEC 8.0f
+/* Time(s) of running without trip to reset the retries */
+#define FAULT_HEALTHY_RUN_SEC     10.0f
+/* Maximum phase current offset(A) accepted at offset measurement */
+#define CURRENT_OFFSET_LIMIT      0.3f
+    
+/* Define WINDING_DIAGNOSTICS to detect open phase, shorted turns and failed 
+ * switches from the phase current rise while the phase is magnetized by 
+ * software HCC. Healthy rise in a sample is between DC link voltage x sample
+ * time / (aligned inductance x WINDING_DIAG_RISE_MARGIN) and 
+ * WINDING_DIAG_RISE_MARGIN x DC link voltage x sample time / unaligned 
+ * inductance (MOTOR_INDUCTANCE_ALIGNED/UNALIGNED). Open phase and shorted turns
+ * are to be seen in WINDING_DIAG_EVENT_COUNT consecutive conductions. Current
+ * above WINDING_DIAG_RESIDUAL_CURRENT in a phase turned off for longer than 
+ * WINDING_DIAG_DEMAG_SEC is a failed switch.
+ * undefine WINDING_DIAGNOSTICS to disable the checks */
+#undef WINDING_DIAGNOSTICS
+/* Define WINDING_DEGRADED_MODE to continue on the remaining phases with an 
+ * open or shorted phase - the phase is removed from commutation and kept 
+ * demagnetized, the current limit is derated by FAULT_DERATE_FACTOR and the 
+ * speed target is limited to LIMP_HOME_SPEED_RPM. The sector of the failed 
+ * phase is shared by its neighbours, the previous phase conducts for 
+ * LIMP_HOME_OVERLAP of the sector and the next phase for the rest of it.
+ * undefine WINDING_DEGRADED_MODE to trip the drive on a failed phase */
+#undef WINDING_DEGRADED_MODE
+#define LIMP_HOME_OVERLAP             0.5f
+#define LIMP_HOME_SPEED_RPM           600.0f
+#define WINDING_DIAG_OPEN_CURRENT     0.2f
+#define WINDING_DIAG_RISE_MARGIN      2.0f
+#define WINDING_DIAG_EVENT_COUNT      4
+#define WINDING_DIAG_DEMAG_SEC        0.002f
+#define WINDING_DIAG_RESIDUAL_CURRENT 0.3f
+/* Time(s) of residual current to detect a failed switch */
+#define WINDING_DIAG_SWITCH_FAULT_SEC 0.002f
+    
+/* Define THERMAL_PROTECTION to derate the current limit from the estimated 
+ * temperatures of the motor windings and the power stage. Winding loss of each
+ * phase is R x mean squared phase current, power stage loss is 
+ * INVERTER_LOSS_GAIN x sum of mean squared phase currents. Current limit is 
+ * reduced linearly from 1 at the derate start temperature to 0 at the limit
+ * temperature of the hottest winding or the power stage. Model starts from 
+ * THERMAL_AMBIENT_DEGC on power up.
+ * undefine THERMAL_PROTECTION to only estimate the temperatures */
+#define THERMAL_PROTECTION
+/* Period(s) of temperature update. Increment of the temperature per update is
+ * (steady state - present) x period / time constant, with too short a period 
+ * it falls below the float resolution and the estimate stops short of the 
+ * steady state (2.3K low at 1ms and 600s time constant, 0.02K at 100ms) */
+#define THERMAL_MODEL_PERIOD_SEC      0.1f
+#define THERMAL_AMBIENT_DEGC          40.0f
+/* Winding resistance(ohm) of a phase */
+#define MOTOR_PHASE_RESISTANCE        2.5f
+/* Thermal resistance(K/W) and time constant(s) of a phase winding to ambient */
+#define MOTOR_WINDING_THERMAL_RES     8.0f
+#define MOTOR_WINDING_TIME_CONSTANT_SEC   600.0f
+/* Winding temperatures(degree C) to start derating and at zero current */
+#define MOTOR_WINDING_DERATE_DEGC     110
+#define MOTOR_WINDING_LIMIT_DEGC      130
+/* Power stage loss(W) per squared phase current(A^2) */
+#define INVERTER_LOSS_GAIN            0.5f
+/* Thermal resistance(K/W) and time constant(s) of power stage to ambient */
+#define INVERTER_THERMAL_RES          3.0f
+#define INVERTER_TIME_CONSTANT_SEC    60.0f
+/* Power stage temperatures(degree C) to start derating and at zero current */
+#define INVERTER_DERATE_DEGC          85
+#define INVERTER_LIMIT_DEGC           100
+    
 /* Enter the Minimum DC link voltage(V) required to run the motor*/    
 #define MOTOR_MIN_DC_VOLT         100
 /* Enter the Maximum DC link voltage(V) required to run the motor*/  
 #define MOTOR_MAX_DC_VOLT         250 
     
+/* DC link supervision in control loop - filtered DC link voltage below 
+ * DC_UNDERVOLTAGE_VOLT or above DC_OVERVOLTAGE_VOLT for DC_BUS_FAULT_SEC while
+ * the motor runs is a fault. Current limit is reduced linearly from 1 at 
+ * DC_DERATE_START_VOLT to DC_DERATE_MIN_FACTOR at DC_UNDERVOLTAGE_VOLT, so 
+ * that the load on a sagging supply is reduced before under voltage trip */
+#define DC_UNDERVOLTAGE_VOLT      90
+#define DC_OVERVOLTAGE_VOLT       270
+/* Reaction to DC link under voltage and over voltage faults */
+#define DC_UNDERVOLTAGE_REACTION  MC1_FAULT_REACTION_TRIP
+#define DC_OVERVOLTAGE_REACTION   MC1_FAULT_REACTION_TRIP
+/* Time constant(s) of DC link voltage filter */
+#define DC_BUS_FILTER_SEC         0.002f
+/* Time(s) the filtered DC link voltage is beyond the limit to detect fault */
+#define DC_BUS_FAULT_SEC          0.005f
+#define DC_DERATE_START_VOLT      MOTOR_MIN_DC_VOLT
+#define DC_DERATE_MIN_FACTOR      0.5f
+    
+/* Define DC_BUS_COMPENSATION to keep the torque constant as the DC link 
+ * voltage varies from DC_BUS_NOMINAL_VOLT, the voltage the commutation angles
+ * are set for. Phase current builds up at turn-on in (unaligned inductance x
+ * reference current / DC link voltage), the commutation angles are advanced 
+ * at lower and retarded at higher DC link voltage by the change of this time
+ * at present speed. Software HCC detects the upper current limit up to a 
+ * sample late, the reference is reduced by half of the current rise in a 
+ * sample at present DC link voltage.
+ * undefine DC_BUS_COMPENSATION for fixed commutation angles and reference */
+#undef DC_BUS_COMPENSATION
+#define DC_BUS_NOMINAL_VOLT       200
+/* Limit of commutation angle correction (degree) */
+#define DC_BUS_ANGLE_COMP_MAX_DEG     5.0f
+    
+/* Define REGEN_BRAKING for four quadrant speed control - negative speed PI 
+ * output excites the phases past the aligned position (commutation of the 
+ * opposite direction) and brakes the motor, returning energy to the DC bus. 
+ * The stop command decelerates the motor to REGEN_STOP_SPEED_RPM before the 
+ * outputs are disabled.
+ * undefine REGEN_BRAKING for motoring only, the motor coasts on stop */
+#undef REGEN_BRAKING
+/* Maximum braking phase current(A) */
+#define REGEN_CURRENT_MAX         2.0f
+/* DC link voltage(V) above which the braking current is reduced linearly */
+#define REGEN_VDC_DERATE_START    220
+/* DC link voltage(V) at which the braking current is zero, to be kept below
+ * MOTOR_MAX_DC_VOLT */
+#define REGEN_VDC_LIMIT           240
+/* Speed(RPM) below which the outputs are disabled on stop */
+#define REGEN_STOP_SPEED_RPM      100.0f
+/* Maximum duration(s) of braking on stop */
+#define REGEN_STOP_TIMEOUT_SEC    5.0f
+    
+/* Define FLYING_START to restart a coasting rotor from its measured speed -
+ * the position sensor and load torque observer run while the motor is stopped,
+ * on run command the speed ramp starts at the measured speed and the speed PI 
+ * integrator is loaded with the load current estimated from the coasting
+ * deceleration. Current offset measurement is shortened, the phase currents 
+ * are zero while coasting with the outputs disabled.
+ * undefine FLYING_START to start from zero speed */
+#undef FLYING_START
+/* Minimum speed(RPM) of the rotor in run direction for flying start */
+#define FLYING_START_MIN_SPEED_RPM    100.0f
+/* Time(s) for speed estimate to settle after stop before it is used */
+#define FLYING_START_SETTLE_SEC       0.05f
+/* Number of current samples (power of 2) for offset measurement in flying start */
+#define FLYING_START_OFFSET_COUNT_BITS    7
+    
+/* Define RUNNING_REVERSAL to change the direction while running - in speed 
+ * control the motor decelerates to REVERSAL_SWITCH_SPEED_RPM (braked when 
+ * REGEN_BRAKING is defined, else coasting), commutation is switched to the 
+ * new direction and the motor accelerates to the target speed. In current 
+ * control the commutation direction is switched immediately.
+ * undefine RUNNING_REVERSAL to change the direction only while stopped */
+#undef RUNNING_REVERSAL
+/* Speed(RPM) below which the commutation direction is switched */
+#define REVERSAL_SWITCH_SPEED_RPM     30.0f
+    
+/* Define STALL_DETECTION to detect a jammed shaft in speed control - speed PI
+ * output saturated at its limit while the speed is below STALL_SPEED_RPM for
+ * STALL_DETECT_SEC trips the drive with the stall fault.
+ * Define STALL_UNJAM to try STALL_UNJAM_ATTEMPTS unjamming routines before the
+ * fault - each routine is STALL_UNJAM_PULSES pairs of a reverse and a forward
+ * current pulse of STALL_UNJAM_CURRENT for STALL_UNJAM_PULSE_SEC each.
+ * undefine STALL_DETECTION to disable the check */
+#define STALL_DETECTION
+#undef STALL_UNJAM
+#define STALL_SPEED_RPM               20.0f
+#define STALL_DETECT_SEC              0.5f
+#define STALL_UNJAM_ATTEMPTS          3
+#define STALL_UNJAM_PULSES            2
+#define STALL_UNJAM_PULSE_SEC         0.05f
+#define STALL_UNJAM_CURRENT           RATED_CURRENT
+    
+/* Measured speed above OVERSPEED_RPM for SPEED_FAULT_SEC is overspeed fault */
+#define OVERSPEED_RPM                 (MAXIMUM_SPEED_RPM * 1.2f)
+#define SPEED_FAULT_SEC               0.002f
+/* Define POSITION_SENSOR_CHECK to check the plausibility of position sensor -
+ * (1) Position jump - change of rotor angle step between control loop 
+ *     executions above POSITION_STEP_CHANGE_MAX_DEG, seen POSITION_JUMP_COUNT
+ *     times more often than plausible steps.
+ * (2) Speed mismatch - changes of the conducting phase (highest current above
+ *     SPEED_CHECK_STROKE_CURRENT) counted in SPEED_CHECK_WINDOW_SEC differ 
+ *     from the count at sensor speed by more than SPEED_CHECK_TOLERANCE in 
+ *     SPEED_MISMATCH_WINDOWS consecutive windows above SPEED_CHECK_MIN_RPM.
+ * undefine POSITION_SENSOR_CHECK to disable the checks, overspeed is always
+ * checked */
+#undef POSITION_SENSOR_CHECK
+#define POSITION_STEP_CHANGE_MAX_DEG  2.0f
+#define POSITION_JUMP_COUNT           3
+#define SPEED_CHECK_STROKE_CURRENT    0.2f
+#define SPEED_CHECK_WINDOW_SEC        0.1f
+#define SPEED_CHECK_TOLERANCE         0.5f
+#define SPEED_MISMATCH_WINDOWS        2
+#define SPEED_CHECK_MIN_RPM           300.0f
+/* Reaction to overspeed, position jump and speed mismatch faults */
+#define OVERSPEED_REACTION            MC1_FAULT_REACTION_TRIP
+#define POSITION_JUMP_REACTION        MC1_FAULT_REACTION_TRIP
+#define SPEED_MISMATCH_REACTION       MC1_FAULT_REACTION_TRIP
+    
+/* Define SUPERVISOR to supervise the execution of the control loop (ADC 
+ * interrupt), Timer1 interrupt and main loop, the missed deadlines trip the 
+ * drive with supervisor fault -
+ * (1) Timer1 disables PWM outputs when the control loop has not started for
+ *     SUPERVISOR_ADC_DEADLINE_SEC - ADC interrupt stopped or is not 
+ *     triggered. Timer1 (IPL 5) cannot preempt the ADC interrupt (IPL 7), a
+ *     control loop hung inside the interrupt is not detected by Timer1,
+ * (2) Control loop checks Timer1 against SUPERVISOR_TIMER1_DEADLINE_SEC,
+ * (3) Timer1 checks main loop against SUPERVISOR_MAIN_DEADLINE_SEC,
+ * (4) Control loop checks for SUPERVISOR_SPI_ERROR_COUNT consecutive position
+ *     sensor reads timed out.
+ * Watchdog is enabled and cleared by main loop only while both interrupts
+ * execute, so that a hung control loop resets the device, which disables the
+ * PWM outputs. A control loop hung inside the ADC interrupt is covered only 
+ * by this reset, after the watchdog period of 131 ms set by FWDT 
+ * configuration bits.
+ * undefine SUPERVISOR to disable the checks and the watchdog */
+#define SUPERVISOR
+#define SUPERVISOR_ADC_DEADLINE_SEC       0.0003f
+#define SUPERVISOR_TIMER1_DEADLINE_SEC    0.005f
+#define SUPERVISOR_MAIN_DEADLINE_SEC      0.1f
+#define SUPERVISOR_SPI_ERROR_COUNT        3
+    
 /* Motor control parameters */   
 /* Motor control angle(degree), total commutation angle */ 
 #define CRTL_THETA         60
@@ -191,12 +461,189 @@ extern "C" {
 /* Enter the value for Tolerance band that follows the reference current with its phase */
 #define HCC_BETA             0.005f
     
+/* Define HARDWARE_HCC to chop the phase current using the analog comparators 
+ * in hysteretic mode (CMP/DAC) and PWM feed-forward PCI, the control updates 
+ * the DAC thresholds only on commutation or reference current change.
+ * Phase C current is not routed to a comparator input and is chopped by 
+ * software HCC.
+ * undefine HARDWARE_HCC for software HCC on all phases */
+#undef HARDWARE_HCC
+    
+/* Acoustic noise reduction by shaping of the phase current at turn-off.
+ * Define SOFT_TURN_OFF to ramp the reference current down from 
+ * SOFT_TURN_OFF_START share of the sector to SOFT_TURN_OFF_END_SCALE of the 
+ * reference at the end of the sector in motoring.
+ * Define TWO_STAGE_TURN_OFF to freewheel the phase turned off at zero voltage
+ * for TWO_STAGE_FREEWHEEL_SEC before it is demagnetized.
+ * Define RANDOM_HCC_BAND to set the HCC band of each stroke randomly between
+ * HCC_BETA and HCC_BETA + RANDOM_HCC_BETA_SPREAD, which spreads the chopping
+ * frequency over a band.
+ * Change of the squared current of the phase turned off, a proxy of the 
+ * radial force exciting the stator, is measured from commutation until the
+ * current has decayed below NOISE_METRIC_DECAY_CURRENT. It is filtered by 
+ * NOISE_METRIC_FILTER in noise.forceSlew and its peak is held in 
+ * noise.forceSlewPeak for comparison of settings, set noise.metricReset = 1
+ * (X2CScope) to clear both before a run with other settings */
+#undef SOFT_TURN_OFF
+#define SOFT_TURN_OFF_START       0.75f
+#define SOFT_TURN_OFF_END_SCALE   0.3f
+#undef TWO_STAGE_TURN_OFF
+#define TWO_STAGE_FREEWHEEL_SEC   0.0001f
+#undef RANDOM_HCC_BAND
+#define RANDOM_HCC_BETA_SPREAD    0.02f
+#define NOISE_METRIC_FILTER       0.01f
+#define NOISE_METRIC_DECAY_CURRENT    0.05f
+    
+/* Chopping strategy of software HCC : 0 = Soft, magnetize and freewheel
+ *                                     1 = Hard, magnetize and demagnetize
+ *                                     2 = Mixed, soft chopping up to 
+ *                                         CHOP_MIXED_HARD_START share of the 
+ *                                         sector and hard chopping after it
+ * Define CHOP_REGIONS to select the strategy from CHOP_REGION_TABLE, 
+ * {speed(RPM), reference current(A), strategy} - the first region with speed
+ * and reference current at or below its limits applies, CHOP_MODE_DEFAULT 
+ * applies outside the regions. Hard chopping gives fast current fall near 
+ * turn-off, soft chopping lower switching loss and current ripple.
+ * undefine CHOP_REGIONS to use CHOP_MODE_DEFAULT in all regions.
+ * Phases chopped by HARDWARE_HCC are not affected */
+#undef CHOP_REGIONS
+#define CHOP_MODE_DEFAULT         0
+#define CHOP_MIXED_HARD_START     0.7f
+#define CHOP_REGION_TABLE_SIZE    2
+#define CHOP_REGION_TABLE   {{ 500.0f, RATED_CURRENT, 0},  \
+                             {1500.0f, RATED_CURRENT, 2}}
+    
+/* Bootstrap capacitors of all phases are charged for BOOTSTRAP_PRECHARGE_SEC
+ * at start, before the first phase is magnetized.
+ * Define BOOTSTRAP_SCHEDULER to charge the bootstrap capacitor of a phase only
+ * when its low side switch was not on for BOOTSTRAP_REFRESH_SEC, with a pulse
+ * of BOOTSTRAP_CHARGE_SEC once the phase is idle and its current is below 
+ * BOOTSTRAP_IDLE_CURRENT. Soft chopping of a phase charges its capacitor.
+ * undefine BOOTSTRAP_SCHEDULER to charge the capacitor of the phase
+ * THETA_x_CBOOT_x during each sector */
+#undef BOOTSTRAP_SCHEDULER
+#define BOOTSTRAP_PRECHARGE_SEC   0.002f
+#define BOOTSTRAP_REFRESH_SEC     0.01f
+#define BOOTSTRAP_CHARGE_SEC      0.0002f
+#define BOOTSTRAP_IDLE_CURRENT    0.05f
+    
 /* Velocity Control Loop - PI Coefficients */
 #define SPEEDCNTR_PTERM                               0.01f
 #define SPEEDCNTR_ITERM                               0.00005f
 #define SPEEDCNTR_CTERM                               1.0
 #define SPEEDCNTR_OUTMAX                              RATED_CURRENT
 #define SPEEDCNTR_OUTMIN                              0.05f
+    
+/* Define SPEEDCNTR_EXTENDED_PI to use speed PI controller with speed scheduled
+ * gains, acceleration feed-forward, derivative on measurement and selectable 
+ * anti-windup.
+ * undefine SPEEDCNTR_EXTENDED_PI for PI controller with fixed gains 
+ * SPEEDCNTR_PTERM and SPEEDCNTR_ITERM */
+#undef SPEEDCNTR_EXTENDED_PI
+/* Derivative gain on measured speed (A per RPM change per speed loop) */
+#define SPEEDCNTR_DTERM                               0.0f
+/* Low pass filter co-efficient of derivative term (0 to 1) */
+#define SPEEDCNTR_DFILTER                             0.2f
+/* Acceleration feed-forward gain (A per RPM change of reference per speed loop) */
+#define SPEEDCNTR_FFTERM                              0.0f
+/* Anti-windup mode : 0 = Back calculation using SPEEDCNTR_CTERM,
+                      1 = Clamping */
+#define SPEEDCNTR_ANTIWINDUP                          1
+/* Speed scheduled gains - {speed(RPM), Kp, Ki}, in increasing order of speed.
+ * Gains are interpolated linearly between the points */
+#define SPEEDCNTR_GAIN_TABLE_SIZE                     4
+#define SPEEDCNTR_GAIN_TABLE    {{  50.0f, 0.015f, 0.00008f},  \
+                                 { 500.0f, 0.012f, 0.00006f},  \
+                                 {1000.0f, 0.010f, 0.00005f},  \
+                                 {1800.0f, 0.007f, 0.00003f}}
+    
+/* Speed reference ramp - jerk limited S-curve from target speed (potentiometer)
+ * to speed PI reference
+ * Define SPEED_REFERENCE_RAMP to limit acceleration and jerk of speed reference.
+ * undefine SPEED_REFERENCE_RAMP to apply target speed directly to speed PI */
+#define SPEED_REFERENCE_RAMP
+/* Acceleration limit of speed reference (RPM/s) */
+#define SPEED_RAMP_ACCEL_RPM_PER_SEC                  2000.0f
+/* Jerk limit of speed reference (RPM/s^2) */
+#define SPEED_RAMP_JERK_RPM_PER_SEC2                  20000.0f
+    
+/* Load torque observer - estimates the load torque at the speed loop rate
+ * Define LOAD_TORQUE_FEEDFORWARD to feed forward the estimated load torque to 
+ * the reference current.
+ * undefine LOAD_TORQUE_FEEDFORWARD for load correction by speed PI only */
+#undef LOAD_TORQUE_FEEDFORWARD
+/* Cut off frequency of load torque estimate low pass filter (Hz) */
+#define LOAD_OBSERVER_FILTER_HZ                       20.0f
+    
+/* Speed loop autotune by relay feedback 
+ * Set mc1.controlScheme.autotune.request = 1 (X2CScope) while the motor runs in
+ * speed control, the identified gains are written to the speed PI controller.
+ * The experiment fails (state 3) if the current is derated by a fault, 
+ * temperature or DC bus undervoltage while it runs */
+/* Speed around which the relay oscillates (RPM) */
+#define AUTOTUNE_SPEED_RPM                            900.0f
+/* Relay hysteresis band around the speed (RPM) */
+#define AUTOTUNE_HYSTERESIS_RPM                       30.0f
+/* Relay current while accelerating (A) */
+#define AUTOTUNE_CURRENT_HIGH                         1.2f
+/* Relay current while decelerating (A) */
+#define AUTOTUNE_CURRENT_LOW                          SPEEDCNTR_OUTMIN
+/* Target bandwidth of speed loop (Hz) */
+#define AUTOTUNE_BANDWIDTH_HZ                         5.0f
+/* Relay cycles ignored while the oscillation settles */
+#define AUTOTUNE_SKIP_CYCLES                          2
+/* Relay cycles averaged for identification */
+#define AUTOTUNE_MEASURE_CYCLES                       4
+/* Maximum duration of the experiment (s) */
+#define AUTOTUNE_TIMEOUT_SEC                          10.0f
+    
+/* Position control - trapezoidal profile to the target rotor angle followed by
+ * a proportional position controller that commands the speed loop. Position
+ * increases in clockwise direction (runDirection = 0). The revolution count 
+ * starts at zero at every start of the motor */
+/* Position range (turns) covered by control input 0 - 4095 */
+#define POSITION_RANGE_TURNS                          1.0f
+/* Velocity limit of position profile (RPM) */
+#define POSITION_SPEED_MAX_RPM                        300.0f
+/* Acceleration limit of position profile (RPM/s) */
+#define POSITION_ACCEL_RPM_PER_SEC                    1000.0f
+/* Proportional gain of position controller (RPM per degree of error) */
+#define POSITION_KP_RPM_PER_DEG                       5.0f
+/* Holding mode at standstill - the two phases producing clockwise and counter
+ * clockwise torque at the rotor angle are energized, their currents are 
+ * shifted by the position error to hold the target angle */
+/* Position error (degree) within which the holding mode is entered */
+#define POSITION_HOLD_WINDOW_DEG                      1.0f
+/* Current (A) of each phase of the pair at zero position error */
+#define POSITION_HOLD_CURRENT                         0.5f
+/* Position error (degree) at which the full current is shifted to one phase */
+#define POSITION_HOLD_STIFFNESS_DEG                   2.0f
+    
+/* Efficiency sweep - in speed control the speed target is stepped through
+ * the speed points for each load point. The load setpoint of the present 
+ * point is published in mc1.efficiencySweep.loadSetpoint and is applied by 
+ * the host to the load machine of the test bench. Each point is held until
+ * the speed has settled, then speed, DC bus voltage and current, reference 
+ * current and phase RMS currents are averaged into mc1.efficiencySweep.result.
+ * Set mc1.efficiencySweep.request = 1 (X2CScope) while the motor runs in 
+ * speed control, the results are read over X2CScope or binary protocol.
+ * Speed points x load points must not exceed EFFICIENCY_SWEEP_POINTS_MAX */
+/* Speed points (RPM) */
+#define SWEEP_SPEED_TABLE_SIZE                        6
+#define SWEEP_SPEED_TABLE       {300.0f, 600.0f, 900.0f, 1200.0f, 1500.0f, 1800.0f}
+/* Load points, in percent of the load machine rating */
+#define SWEEP_LOAD_TABLE_SIZE                         4
+#define SWEEP_LOAD_TABLE        {25.0f, 50.0f, 75.0f, 100.0f}
+/* Speed error band (RPM) of settled speed */
+#define SWEEP_SPEED_BAND_RPM                          20.0f
+/* Time (s) the speed must stay within the band, includes the time taken by 
+ * the host to apply the load setpoint */
+#define SWEEP_SETTLE_SEC                              2.0f
+/* Maximum time (s) to settle, the point is averaged anyway and marked as not
+ * settled */
+#define SWEEP_POINT_TIMEOUT_SEC                       10.0f
+/* Averaging time (s) at each point */
+#define SWEEP_AVERAGE_SEC                             1.0f
 
 // </editor-fold>
 
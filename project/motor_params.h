@@ -67,6 +67,8 @@ typedef struct
         maxSpeed,           /* Maximum speed */
         minSpeed,           /* Minimum speed */
         ratedCurrent,       /* Rated current of motor */
+        torqueConstant,     /* Torque per ampere model of motor (Nm/A) */
+        inertia,            /* Inertia of motor and load (kg.m^2) */
         /* Motor commutation angles for clockwise rotation */    
         cwTheta1On,
         cwTheta1Off,
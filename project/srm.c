@@ -54,12 +54,14 @@
 #include "board_service.h"
 #include "diagnostics.h"
 #include "mc1_service.h"
+#include "protocol.h"
  
 // </editor-fold>
  
 // <editor-fold defaultstate="collapsed" desc=" Global Variables ">
 
 uint32_t runCmdMC1,dirCmdMC1,targetVelocityMC1;
+uint32_t remoteMC1 = 0;
 
 uint32_t heartBeatCount = 0;
 
@@ -82,6 +84,10 @@ int main(void)
     /* Initialize Diagnostics */
     DiagnosticsInit();
 #endif
+#ifdef ENABLE_PROTOCOL
+    /* Initialize binary command protocol */
+    ProtocolInit();
+#endif
     
 	/* Initialize Board Service */
     BoardServiceInit();
@@ -100,13 +106,22 @@ int main(void)
     
     while(1)
     {
+        /* Watchdog is cleared while the interrupts are alive */
+        MCAPP_MC1SupervisorMainStep();
         
 #ifdef ENABLE_DIAGNOSTICS
         DiagnosticsStepMain();
 #endif
+#ifdef ENABLE_PROTOCOL
+        ProtocolStepMain();
+#endif
+        /* Fault events are written to flash while the motor is stopped */
+        MCAPP_MC1FaultLogService();
+        
         BoardService();
         
-        if (IsPressed_Button1())
+        /* Buttons are ignored while the drive is controlled by host */
+        if (IsPressed_Button1() && (remoteMC1 == 0))
         {
             if(runCmdMC1 == 1)
             {
@@ -117,7 +132,7 @@ int main(void)
                runCmdMC1 = 1; 
             }   
         }
-        if(IsPressed_Button2())
+        if(IsPressed_Button2() && (remoteMC1 == 0))
         {
             if(dirCmdMC1 == 0)
             {
@@ -149,6 +164,11 @@ int main(void)
 */
 void __attribute__((__interrupt__, no_auto_psv))_T1Interrupt(void)
 {
+#ifdef ENABLE_PROTOCOL
+    uint32_t remoteRunCmd, remoteDirCmd;
+    float remoteControlInput;
+    
+#endif
     if (heartBeatCount < HEART_BEAT_LED_COUNT)
     {
         heartBeatCount += 1;
@@ -165,9 +185,26 @@ void __attribute__((__interrupt__, no_auto_psv))_T1Interrupt(void)
             LED1 = 1;
         }
     }
-    targetVelocityMC1 = MCAPP_MC1GetTargetVelocity();
-    MCAPP_MC1InputBufferSet(runCmdMC1,dirCmdMC1, targetVelocityMC1);
+#ifdef ENABLE_PROTOCOL
+    ProtocolStepIsr();
+    remoteMC1 = ProtocolRemoteCommandGet(&remoteRunCmd, &remoteDirCmd, 
+                                                        &remoteControlInput);
+    if(remoteMC1 == 1)
+    {
+        /* Local run command is cleared, so that motor does not restart when 
+           control is returned to the board */
+        runCmdMC1 = 0;
+        dirCmdMC1 = remoteDirCmd;
+        MCAPP_MC1InputBufferSet(remoteRunCmd, remoteDirCmd, remoteControlInput);
+    }
+    else
+#endif
+    {
+        targetVelocityMC1 = MCAPP_MC1GetTargetVelocity();
+        MCAPP_MC1InputBufferSet(runCmdMC1,dirCmdMC1, targetVelocityMC1);
+    }
     BoardServiceStepIsr(); 
+    MCAPP_MC1SupervisorTimer1Step();
     TIMER1_InterruptFlagClear();
 }
 // </editor-fold>
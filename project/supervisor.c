@@ -0,0 +1,256 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * supervisor.c
+ *
+ * This file implements the execution supervisor. Each context checks the 
+ * heartbeat of another one - Timer1 checks the control loop and the main 
+ * loop, the control loop checks Timer1. Control loop has the highest 
+ * interrupt priority, so a control loop that stops being triggered is found
+ * by Timer1, while a control loop that hangs blocks Timer1 and the main loop
+ * and is caught by the watchdog. Main loop clears the watchdog only when both
+ * interrupts have executed since the last clear. A context is checked from
+ * its first execution, so that the start up order is not supervised.
+ *
+ * Component: SUPERVISOR
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "supervisor.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+
+/**
+* <B> Function: MCAPP_SupervisorInit(MCAPP_SUPERVISOR_T *, bool) </B>
+*
+* @brief Function to initialize the heartbeats and deadline counters, to be
+*        called on power up.
+*
+* @param Pointer to supervisor data structure.
+* @param true if the last reset was caused by watchdog.
+* @return none.
+*
+* @example
+* <CODE> MCAPP_SupervisorInit(&supervisor, WDT_ResetFlagGet()); </CODE>
+*
+*/
+void MCAPP_SupervisorInit(MCAPP_SUPERVISOR_T *pSupervisor, bool watchdogReset)
+{
+    pSupervisor->adcHeartbeat = 0;
+    pSupervisor->timer1Heartbeat = 0;
+    pSupervisor->mainHeartbeat = 0;
+    pSupervisor->adcSeen = 0;
+    pSupervisor->timer1Seen = 0;
+    pSupervisor->mainSeen = 0;
+    pSupervisor->watchdogAdcSeen = 0;
+    pSupervisor->watchdogTimer1Seen = 0;
+    pSupervisor->watchdogReset = (watchdogReset == true) ? 1 : 0;
+    MCAPP_SupervisorClear(pSupervisor);
+}
+
+/**
+* <B> Function: MCAPP_SupervisorAdcStep(MCAPP_SUPERVISOR_T *, uint32_t) </B>
+*
+* @brief Function to update the control loop heartbeat and check the Timer1
+*        deadline and the position sensor SPI exchange. To be called every 
+*        control loop execution.
+*
+* @param Pointer to supervisor data structure.
+* @param Consecutive SPI time-outs of the position sensor.
+* @return none.
+*
+* @example
+* <CODE> MCAPP_SupervisorAdcStep(&supervisor, spiErrors); </CODE>
+*
+*/
+void MCAPP_SupervisorAdcStep(MCAPP_SUPERVISOR_T *pSupervisor, 
+                                                        uint32_t spiErrors)
+{
+    pSupervisor->adcHeartbeat++;
+    
+    if(pSupervisor->enable == 0)
+    {
+        return;
+    }
+    
+    if((pSupervisor->timer1Heartbeat != pSupervisor->timer1Seen) ||
+                                        (pSupervisor->timer1Heartbeat == 0))
+    {
+        pSupervisor->timer1Seen = pSupervisor->timer1Heartbeat;
+        pSupervisor->timer1MissCounter = 0;
+    }
+    else if(pSupervisor->timer1MissCounter < pSupervisor->timer1MissCount)
+    {
+        pSupervisor->timer1MissCounter++;
+    }
+    else
+    {
+        pSupervisor->missed |= SUPERVISOR_CONTEXT_TIMER1;
+    }
+    
+    if(spiErrors >= pSupervisor->spiErrorCount)
+    {
+        pSupervisor->missed |= SUPERVISOR_CONTEXT_SPI;
+    }
+}
+
+/**
+* <B> Function: MCAPP_SupervisorTimer1Step(MCAPP_SUPERVISOR_T *) </B>
+*
+* @brief Function to update the Timer1 heartbeat and check the control loop 
+*        and main loop deadlines. To be called every Timer1 execution.
+*
+* @param Pointer to supervisor data structure.
+* @return true if the control loop missed its deadline, the PWM outputs are
+*         to be disabled as they are no longer updated.
+*
+* @example
+* <CODE> deadman = MCAPP_SupervisorTimer1Step(&supervisor); </CODE>
+*
+*/
+bool MCAPP_SupervisorTimer1Step(MCAPP_SUPERVISOR_T *pSupervisor)
+{
+    bool deadman = false;
+    
+    pSupervisor->timer1Heartbeat++;
+    
+    if(pSupervisor->enable == 0)
+    {
+        return false;
+    }
+    
+    if((pSupervisor->adcHeartbeat != pSupervisor->adcSeen) ||
+                                        (pSupervisor->adcHeartbeat == 0))
+    {
+        pSupervisor->adcSeen = pSupervisor->adcHeartbeat;
+        pSupervisor->adcMissCounter = 0;
+    }
+    else if(pSupervisor->adcMissCounter < pSupervisor->adcMissCount)
+    {
+        pSupervisor->adcMissCounter++;
+    }
+    else
+    {
+        pSupervisor->missed |= SUPERVISOR_CONTEXT_ADC;
+        deadman = true;
+    }
+    
+    if((pSupervisor->mainHeartbeat != pSupervisor->mainSeen) ||
+                                        (pSupervisor->mainHeartbeat == 0))
+    {
+        pSupervisor->mainSeen = pSupervisor->mainHeartbeat;
+        pSupervisor->mainMissCounter = 0;
+    }
+    else if(pSupervisor->mainMissCounter < pSupervisor->mainMissCount)
+    {
+        pSupervisor->mainMissCounter++;
+    }
+    else
+    {
+        pSupervisor->missed |= SUPERVISOR_CONTEXT_MAIN;
+    }
+    
+    return deadman;
+}
+
+/**
+* <B> Function: MCAPP_SupervisorMainStep(MCAPP_SUPERVISOR_T *) </B>
+*
+* @brief Function to update the main loop heartbeat. To be called every main
+*        loop execution.
+*
+* @param Pointer to supervisor data structure.
+* @return true if both interrupts have executed since the watchdog was last
+*         cleared, the watchdog is to be cleared.
+*
+* @example
+* <CODE> clear = MCAPP_SupervisorMainStep(&supervisor); </CODE>
+*
+*/
+bool MCAPP_SupervisorMainStep(MCAPP_SUPERVISOR_T *pSupervisor)
+{
+    uint32_t adcHeartbeat, timer1Heartbeat;
+    
+    pSupervisor->mainHeartbeat++;
+    
+    if(pSupervisor->enable == 0)
+    {
+        return false;
+    }
+    
+    adcHeartbeat = pSupervisor->adcHeartbeat;
+    timer1Heartbeat = pSupervisor->timer1Heartbeat;
+    if((adcHeartbeat == pSupervisor->watchdogAdcSeen) || 
+                        (timer1Heartbeat == pSupervisor->watchdogTimer1Seen))
+    {
+        return false;
+    }
+    pSupervisor->watchdogAdcSeen = adcHeartbeat;
+    pSupervisor->watchdogTimer1Seen = timer1Heartbeat;
+    
+    return true;
+}
+
+/**
+* <B> Function: MCAPP_SupervisorClear(MCAPP_SUPERVISOR_T *) </B>
+*
+* @brief Function to clear the missed deadlines and deadline counters.
+*
+* @param Pointer to supervisor data structure.
+* @return none.
+*
+* @example
+* <CODE> MCAPP_SupervisorClear(&supervisor); </CODE>
+*
+*/
+void MCAPP_SupervisorClear(MCAPP_SUPERVISOR_T *pSupervisor)
+{
+    pSupervisor->adcMissCounter = 0;
+    pSupervisor->timer1MissCounter = 0;
+    pSupervisor->mainMissCounter = 0;
+    pSupervisor->missed = 0;
+}
+
+// </editor-fold>
@@ -0,0 +1,124 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file supervisor.h
+ *
+ * @brief This header file lists data type definitions and interface functions
+ * of the execution supervisor. Control loop (ADC interrupt), Timer1 interrupt
+ * and main loop increment a heartbeat counter on each execution, and check
+ * the heartbeat of another context against its deadline. The device 
+ * watchdog is cleared only while the interrupts are alive.
+ *
+ * Component: SUPERVISOR
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+#ifndef __SUPERVISOR_H
+#define __SUPERVISOR_H
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// </editor-fold>
+
+#ifdef __cplusplus  // Provide C++ Compatability
+    extern "C" {
+#endif
+
+// <editor-fold defaultstate="expanded" desc="ENUMERATED CONSTANTS ">
+
+/**
+ * Supervised contexts, bits of missed deadline status
+ */
+typedef enum
+{
+    SUPERVISOR_CONTEXT_ADC      = 0x01,     /* Control loop, ADC interrupt */
+    SUPERVISOR_CONTEXT_TIMER1   = 0x02,     /* Timer1 interrupt */
+    SUPERVISOR_CONTEXT_MAIN     = 0x04,     /* Main loop */
+    SUPERVISOR_CONTEXT_SPI      = 0x08      /* Position sensor SPI exchange */
+} MCAPP_SUPERVISOR_CONTEXT_T;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="TYPE DEFINITIONS ">
+
+/**
+ * Execution supervisor data type
+*/
+typedef struct
+{
+    uint32_t
+        enable,             /* 1 = deadlines are checked and watchdog is used */
+        adcSeen,            /* ADC heartbeat at last Timer1 execution */
+        adcMissCounter,     /* Timer1 executions without control loop */
+        adcMissCount,       /* Timer1 executions to miss control loop deadline */
+        timer1Seen,         /* Timer1 heartbeat at last control loop execution */
+        timer1MissCounter,  /* Control loop executions without Timer1 */
+        timer1MissCount,    /* Control loop executions to miss Timer1 deadline */
+        mainSeen,           /* Main heartbeat at last Timer1 execution */
+        mainMissCounter,    /* Timer1 executions without main loop */
+        mainMissCount,      /* Timer1 executions to miss main loop deadline */
+        spiErrorCount,      /* Consecutive SPI time-outs to miss SPI deadline */
+        watchdogAdcSeen,    /* ADC heartbeat at last watchdog clear */
+        watchdogTimer1Seen, /* Timer1 heartbeat at last watchdog clear */
+        watchdogReset;      /* 1 = last reset was caused by watchdog */
+    volatile uint32_t
+        adcHeartbeat,       /* Incremented by control loop */
+        timer1Heartbeat,    /* Incremented by Timer1 interrupt */
+        mainHeartbeat,      /* Incremented by main loop */
+        missed;             /* Contexts missed deadline MCAPP_SUPERVISOR_CONTEXT_T */
+} MCAPP_SUPERVISOR_T;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+
+void MCAPP_SupervisorInit(MCAPP_SUPERVISOR_T *, bool);
+void MCAPP_SupervisorAdcStep(MCAPP_SUPERVISOR_T *, uint32_t);
+bool MCAPP_SupervisorTimer1Step(MCAPP_SUPERVISOR_T *);
+bool MCAPP_SupervisorMainStep(MCAPP_SUPERVISOR_T *);
+void MCAPP_SupervisorClear(MCAPP_SUPERVISOR_T *);
+
+// </editor-fold>
+
+#ifdef __cplusplus  // Provide C++ Compatibility
+    }
+#endif
+#endif      // end of __SUPERVISOR_H
@@ -0,0 +1,153 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * autotune_test.c
+ *
+ * Host test of the speed loop autotune. The relay feedback experiment is run
+ * against an inertia plus Coulomb friction model of the drive, the identified
+ * inertia, friction current and speed PI gains are checked against the model.
+ *
+ * Component: TEST
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <stdint.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "autotune.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/CONSTANTS ">
+
+/* Plant model, normalized inertia (A/(RPM/s)) and friction current (A) */
+#define PLANT_INERTIA               0.002f
+#define PLANT_FRICTION_CURRENT      0.4f
+/* Plant integration steps per autotune execution */
+#define PLANT_SUBSTEPS              20
+
+/* Autotune parameters, execution period as speed loop of the drive */
+#define TEST_SAMPLE_SEC             0.001f
+#define TEST_SETPOINT_RPM           900.0f
+#define TEST_HYSTERESIS_RPM         30.0f
+#define TEST_CURRENT_HIGH           1.2f
+#define TEST_CURRENT_LOW            0.05f
+#define TEST_BANDWIDTH_RAD          31.4f
+#define TEST_TIMEOUT_COUNT          10000
+
+/* Relative tolerance of identified parameters */
+#define TEST_TOLERANCE              0.05f
+
+// </editor-fold>
+
+static uint32_t failures;
+
+static void CheckRelative(const char *name, float value, float expected)
+{
+    float error = fabsf(value - expected) / fabsf(expected);
+
+    printf("%-16s %10.6f expected %10.6f error %5.2f%%\n", name, value,
+                                                    expected, error * 100.0f);
+    if(error > TEST_TOLERANCE)
+    {
+        printf("FAIL: %s\n", name);
+        failures++;
+    }
+}
+
+int main(void)
+{
+    MCAPP_AUTOTUNE_T autotune = {0};
+    float speed = TEST_SETPOINT_RPM;
+    float current = 0;
+    float kp, ki;
+    uint32_t step, substep;
+
+    autotune.setpoint       = TEST_SETPOINT_RPM;
+    autotune.hysteresis     = TEST_HYSTERESIS_RPM;
+    autotune.currentHigh    = TEST_CURRENT_HIGH;
+    autotune.currentLow     = TEST_CURRENT_LOW;
+    autotune.bandwidth      = TEST_BANDWIDTH_RAD;
+    autotune.sampleTime     = TEST_SAMPLE_SEC;
+    autotune.skipCycles     = 2;
+    autotune.measureCycles  = 4;
+    autotune.timeoutCount   = TEST_TIMEOUT_COUNT;
+
+    MCAPP_AutotuneInit(&autotune);
+    MCAPP_AutotuneStart(&autotune);
+
+    for(step = 0; (step < 2 * TEST_TIMEOUT_COUNT) && 
+                                (autotune.state == AUTOTUNE_RELAY); step++)
+    {
+        current = MCAPP_AutotuneStep(&autotune, speed);
+
+        /* Relay current is held over the execution period */
+        for(substep = 0; substep < PLANT_SUBSTEPS; substep++)
+        {
+            speed += (current - PLANT_FRICTION_CURRENT) / PLANT_INERTIA *
+                                        (TEST_SAMPLE_SEC / PLANT_SUBSTEPS);
+        }
+    }
+
+    if(autotune.state != AUTOTUNE_COMPLETE)
+    {
+        printf("FAIL: autotune state %u after %u executions\n",
+                            (unsigned)autotune.state, (unsigned)step);
+        return 1;
+    }
+    printf("converged after %u executions\n", (unsigned)step);
+
+    kp = TEST_BANDWIDTH_RAD * PLANT_INERTIA;
+    ki = kp * TEST_BANDWIDTH_RAD * 0.25f * TEST_SAMPLE_SEC;
+
+    CheckRelative("inertia", autotune.inertia, PLANT_INERTIA);
+    CheckRelative("friction", autotune.frictionCurrent, 
+                                                    PLANT_FRICTION_CURRENT);
+    CheckRelative("kp", autotune.kp, kp);
+    CheckRelative("ki", autotune.ki, ki);
+
+    if(failures != 0)
+    {
+        return 1;
+    }
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,278 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * noise_shaping_test.c
+ *
+ * Host test of the acoustic noise shaping at turn-off. Strokes of a four 
+ * phase motor are run against a phase current model with DC link voltage,
+ * resistance, inductance at turn-off and back EMF, the active phase is 
+ * chopped by the HCC in mixed mode. The peak force slew of the phase turned
+ * off is compared between hard, soft and two-stage turn-off, and the spread
+ * of the chopping frequency is compared between fixed and random HCC band.
+ *
+ * Component: TEST
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <stdint.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "hcc.h"
+#include "noise_shaping.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/CONSTANTS ">
+
+/* Phase model, DC link voltage (V), resistance (Ohm), inductance near the 
+   aligned position (H) and back EMF per phase current (V/A) */
+#define PLANT_VDC                   200.0f
+#define PLANT_RESISTANCE            2.5f
+#define PLANT_INDUCTANCE            0.15f
+#define PLANT_BACK_EMF              25.0f
+/* Plant integration steps per control loop execution */
+#define PLANT_SUBSTEPS              10
+
+/* Control loop period (s), stroke length (executions) and strokes per run */
+#define TEST_SAMPLE_SEC             0.00005f
+#define TEST_STROKE_COUNT           400
+#define TEST_STROKES                40
+#define TEST_PHASES                 4
+#define TEST_REFERENCE_CURRENT      2.0f
+
+/* Noise shaping parameters, the freewheel stage is longer than the drive 
+   default to decay the current measurably in the model */
+#define TEST_HCC_BETA               0.005f
+#define TEST_BETA_SPREAD            0.02f
+#define TEST_RAMP_START             0.75f
+#define TEST_RAMP_END_SCALE         0.3f
+#define TEST_FREEWHEEL_COUNT        20
+#define TEST_METRIC_FILTER          0.01f
+#define TEST_DECAY_CURRENT          0.05f
+
+/* Share of the sector with hard chopping in mixed mode */
+#define TEST_HARD_CHOP_START        TEST_RAMP_START
+
+/* Window of the stroke in which the chopping frequency is measured */
+#define TEST_CHOP_WINDOW_START      0.25f
+#define TEST_CHOP_WINDOW_END        0.7f
+
+/* Required reduction of peak force slew against hard turn-off */
+#define TEST_SOFT_RATIO             0.5f
+#define TEST_TWO_STAGE_RATIO        0.9f
+/* Required relative deviation of chopping frequency with random band */
+#define TEST_SPREAD_MIN             0.1f
+
+// </editor-fold>
+
+static uint32_t failures;
+
+/* Results of a run */
+typedef struct
+{
+    float forceSlewPeak, chopMean, chopSpread;
+} TEST_RESULT_T;
+
+static void Check(const char *name, int condition)
+{
+    if(!condition)
+    {
+        printf("FAIL: %s\n", name);
+        failures++;
+    }
+}
+
+static TEST_RESULT_T Run(MCAPP_NOISE_SHAPING_T *pNoise, 
+                                                MCAPP_HCCPARMIN_T *pHccInput)
+{
+    TEST_RESULT_T result = {0};
+    MCAPP_HCCPARMOUT_T hccOutput = {0};
+    float current[TEST_PHASES] = {0};
+    float voltage[TEST_PHASES];
+    float chopFrequency[TEST_STROKES];
+    float progress, window, sum = 0, sumSquare = 0;
+    uint32_t stroke, sample, step, phase, phaseOn, edges, outPrev;
+
+    /* Metric of the previous run is cleared as from X2CScope */
+    pNoise->metricReset = 1;
+    window = (TEST_CHOP_WINDOW_END - TEST_CHOP_WINDOW_START) * 
+                                    TEST_STROKE_COUNT * TEST_SAMPLE_SEC;
+
+    for(stroke = 0; stroke < TEST_STROKES; stroke++)
+    {
+        phaseOn = (stroke % TEST_PHASES) + 1;
+        edges = 0;
+        outPrev = 0;
+        for(sample = 0; sample < TEST_STROKE_COUNT; sample++)
+        {
+            progress = (float)sample / TEST_STROKE_COUNT;
+
+            /* Reference profile and commutation as SRM control */
+            MCAPP_NoiseProfileUpdate(pNoise, progress);
+            MCAPP_NoiseCommutationUpdate(pNoise, phaseOn, 
+                                                    &pHccInput->hccState);
+
+            pHccInput->currentReference = TEST_REFERENCE_CURRENT * 
+                                                        pNoise->profileScale;
+            pHccInput->currentActual = current[phaseOn - 1];
+            MCAPP_ControllerHysteresis(pHccInput, &pHccInput->hccState, 
+                                                                &hccOutput);
+
+            for(phase = 0; phase < TEST_PHASES; phase++)
+            {
+                voltage[phase] = -PLANT_VDC;
+            }
+            if(hccOutput.out == 1)
+            {
+                voltage[phaseOn - 1] = PLANT_VDC;
+            }
+            else if(progress < TEST_HARD_CHOP_START)
+            {
+                voltage[phaseOn - 1] = 0;
+            }
+            if(pNoise->freewheelCounter > 0)
+            {
+                pNoise->freewheelCounter--;
+                if(pNoise->phaseOff != phaseOn)
+                {
+                    voltage[pNoise->phaseOff - 1] = 0;
+                }
+            }
+
+            /* Metric is updated with the currents measured in this sample */
+            MCAPP_NoiseMetricUpdate(pNoise, (pNoise->phaseOff != 0) ? 
+                                        current[pNoise->phaseOff - 1] : 0);
+
+            if((progress >= TEST_CHOP_WINDOW_START) && 
+                                        (progress < TEST_CHOP_WINDOW_END) &&
+                                        (hccOutput.out == 1) && (outPrev == 0))
+            {
+                edges++;
+            }
+            outPrev = hccOutput.out;
+
+            /* Phase current, diodes block negative current */
+            for(step = 0; step < PLANT_SUBSTEPS; step++)
+            {
+                for(phase = 0; phase < TEST_PHASES; phase++)
+                {
+                    current[phase] += (voltage[phase] - 
+                        ((PLANT_RESISTANCE + PLANT_BACK_EMF) * current[phase]))
+                        * (TEST_SAMPLE_SEC / PLANT_SUBSTEPS) / PLANT_INDUCTANCE;
+                    if(current[phase] < 0)
+                    {
+                        current[phase] = 0;
+                    }
+                }
+            }
+        }
+        chopFrequency[stroke] = edges / window;
+    }
+
+    /* First strokes start from zero current in all phases */
+    for(stroke = TEST_PHASES; stroke < TEST_STROKES; stroke++)
+    {
+        sum += chopFrequency[stroke];
+        sumSquare += chopFrequency[stroke] * chopFrequency[stroke];
+    }
+    result.chopMean = sum / (TEST_STROKES - TEST_PHASES);
+    result.chopSpread = sqrtf(fabsf((sumSquare / (TEST_STROKES - TEST_PHASES))
+                            - (result.chopMean * result.chopMean))) / 
+                                                            result.chopMean;
+    result.forceSlewPeak = pNoise->forceSlewPeak;
+    return result;
+}
+
+static TEST_RESULT_T RunSettings(MCAPP_NOISE_SHAPING_T *pNoise, 
+            MCAPP_HCCPARMIN_T *pHccInput, const char *name, uint32_t soft, 
+            uint32_t twoStage, uint32_t randomBand)
+{
+    TEST_RESULT_T result;
+
+    pNoise->softTurnOff = soft;
+    pNoise->twoStageTurnOff = twoStage;
+    pNoise->randomBand = randomBand;
+    pHccInput->hccState.beta = pNoise->betaNominal;
+    result = Run(pNoise, pHccInput);
+
+    printf("%-10s: force slew peak %6.4f A^2, chopping %7.0f Hz, "
+            "spread %5.3f\n", name, result.forceSlewPeak, result.chopMean, 
+            result.chopSpread);
+    return result;
+}
+
+int main(void)
+{
+    MCAPP_NOISE_SHAPING_T noise = {0};
+    MCAPP_HCCPARMIN_T hccInput = {{0}, 0, 0};
+    TEST_RESULT_T hard, soft, twoStage, random;
+
+    noise.rampStart      = TEST_RAMP_START;
+    noise.rampEndScale   = TEST_RAMP_END_SCALE;
+    noise.freewheelCount = TEST_FREEWHEEL_COUNT;
+    noise.betaNominal    = TEST_HCC_BETA;
+    noise.betaSpread     = TEST_BETA_SPREAD;
+    noise.forceFilter    = TEST_METRIC_FILTER;
+    noise.decayCurrent   = TEST_DECAY_CURRENT;
+    noise.randomState    = 0x2545F491UL;
+    MCAPP_NoiseShapingInit(&noise, &hccInput.hccState);
+
+    hard     = RunSettings(&noise, &hccInput, "hard", 0, 0, 0);
+    soft     = RunSettings(&noise, &hccInput, "soft", 1, 0, 0);
+    twoStage = RunSettings(&noise, &hccInput, "two-stage", 0, 1, 0);
+    random   = RunSettings(&noise, &hccInput, "random", 0, 0, 1);
+
+    Check("force slew measured", hard.forceSlewPeak > 0);
+    Check("soft turn-off reduces force slew", 
+                soft.forceSlewPeak < (TEST_SOFT_RATIO * hard.forceSlewPeak));
+    Check("two-stage turn-off reduces force slew", twoStage.forceSlewPeak < 
+                                (TEST_TWO_STAGE_RATIO * hard.forceSlewPeak));
+    Check("random band spreads chopping frequency", 
+            (random.chopSpread > TEST_SPREAD_MIN) && 
+                                    (random.chopSpread > hard.chopSpread));
+
+    if(failures != 0)
+    {
+        return 1;
+    }
+    printf("PASS\n");
+    return 0;
+}
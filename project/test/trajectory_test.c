@@ -0,0 +1,246 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * trajectory_test.c
+ *
+ * Host test of the jerk limited speed ramp. Large steps of the target speed
+ * are applied, acceleration and jerk of the ramp output and the current 
+ * implied by the acceleration of the motor inertia are checked against the
+ * configured limits and compared with the unlimited step. Moves of the 
+ * trapezoidal position profile are checked for overshoot of the target and
+ * against the velocity and acceleration limits.
+ *
+ * Component: TEST
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <stdint.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "trajectory.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/CONSTANTS ">
+
+/* Ramp limits and execution period as configured for the drive */
+#define TEST_ACCEL_RPM_PER_SEC      2000.0f
+#define TEST_JERK_RPM_PER_SEC2      20000.0f
+#define TEST_SAMPLE_SEC             0.001f
+
+/* Inertia (kg.m^2) and torque constant (Nm/A) of the motor */
+#define TEST_INERTIA                0.0002f
+#define TEST_KT                     0.3f
+
+/* Current (A) to accelerate the inertia at 1 RPM/s */
+#define TEST_CURRENT_PER_RPM_PER_SEC    (TEST_INERTIA * 2.0f * M_PI / \
+                                                        (60.0f * TEST_KT))
+
+/* Position profile limits as configured for the drive, 300 RPM and 
+   1000 RPM/s */
+#define TEST_VELOCITY_RAD           31.416f
+#define TEST_POSITION_ACCEL_RAD     104.72f
+
+/* Margin for rounding of the output difference */
+#define TEST_MARGIN                 1.001f
+
+/* Executions allowed to reach the target */
+#define TEST_STEPS_MAX              5000
+
+// </editor-fold>
+
+static uint32_t failures;
+
+/* Peak values of a speed change */
+typedef struct
+{
+    float accel, jerk, current, overshoot;
+    uint32_t steps;
+} TEST_PEAK_T;
+
+static TEST_PEAK_T RampRun(MCAPP_SPEED_RAMP_T *pRamp, float target)
+{
+    TEST_PEAK_T peak = {0};
+    float start = pRamp->output;
+    float previous = pRamp->output;
+    float accelPrevious = 0;
+    float accel, jerk, beyond;
+
+    while((peak.steps < TEST_STEPS_MAX) && 
+                    ((pRamp->output != target) || (accelPrevious != 0)))
+    {
+        MCAPP_SpeedRampUpdate(pRamp, target);
+        peak.steps++;
+
+        accel = (pRamp->output - previous) / TEST_SAMPLE_SEC;
+        jerk = (accel - accelPrevious) / TEST_SAMPLE_SEC;
+        beyond = (target > start) ? (pRamp->output - target) :
+                                                    (target - pRamp->output);
+        if(fabsf(accel) > peak.accel)
+        {
+            peak.accel = fabsf(accel);
+        }
+        if(fabsf(jerk) > peak.jerk)
+        {
+            peak.jerk = fabsf(jerk);
+        }
+        if(beyond > peak.overshoot)
+        {
+            peak.overshoot = beyond;
+        }
+        previous = pRamp->output;
+        accelPrevious = accel;
+    }
+    peak.current = peak.accel * TEST_CURRENT_PER_RPM_PER_SEC;
+    return peak;
+}
+
+static void Check(const char *name, int condition)
+{
+    if(!condition)
+    {
+        printf("FAIL: %s\n", name);
+        failures++;
+    }
+}
+
+static void StepTest(float start, float target)
+{
+    MCAPP_SPEED_RAMP_T ramp = {0};
+    TEST_PEAK_T limited, step;
+
+    ramp.accelMax   = TEST_ACCEL_RPM_PER_SEC;
+    ramp.jerkMax    = TEST_JERK_RPM_PER_SEC2;
+    ramp.sampleTime = TEST_SAMPLE_SEC;
+
+    ramp.enable = 0;
+    MCAPP_SpeedRampInit(&ramp, start);
+    step = RampRun(&ramp, target);
+
+    ramp.enable = 1;
+    MCAPP_SpeedRampInit(&ramp, start);
+    limited = RampRun(&ramp, target);
+
+    printf("%6.0f -> %6.0f RPM: %5u steps, accel %7.1f RPM/s, "
+            "jerk %8.1f RPM/s^2, current %6.3f A (step %8.3f A)\n",
+            start, target, (unsigned)limited.steps, limited.accel,
+            limited.jerk, limited.current, step.current);
+
+    Check("target reached", (limited.steps < TEST_STEPS_MAX) && 
+                                                    (ramp.output == target));
+    Check("no overshoot", limited.overshoot == 0);
+    Check("acceleration limit", 
+                    limited.accel <= TEST_ACCEL_RPM_PER_SEC * TEST_MARGIN);
+    Check("jerk limit", limited.jerk <= TEST_JERK_RPM_PER_SEC2 * TEST_MARGIN);
+    Check("current bound", limited.current <= 
+        TEST_ACCEL_RPM_PER_SEC * TEST_CURRENT_PER_RPM_PER_SEC * TEST_MARGIN);
+    Check("current reduced", limited.current < step.current);
+}
+
+static void MoveTest(float start, float target)
+{
+    MCAPP_POSITION_PROFILE_T profile = {0};
+    float velocity, velocityPrevious = 0, accel;
+    float peakVelocity = 0, peakAccel = 0, beyond, overshoot = 0;
+    uint32_t steps = 0;
+
+    profile.velocityMax = TEST_VELOCITY_RAD;
+    profile.accelMax    = TEST_POSITION_ACCEL_RAD;
+    profile.sampleTime  = TEST_SAMPLE_SEC;
+    MCAPP_PositionProfileInit(&profile, start);
+
+    do
+    {
+        velocity = MCAPP_PositionProfileUpdate(&profile, target);
+        steps++;
+
+        accel = (velocity - velocityPrevious) / TEST_SAMPLE_SEC;
+        beyond = (target > start) ? (profile.position - target) :
+                                                (target - profile.position);
+        if(fabsf(velocity) > peakVelocity)
+        {
+            peakVelocity = fabsf(velocity);
+        }
+        /* Stop at the target is not limited by the profile */
+        if((profile.complete == 0) && (fabsf(accel) > peakAccel))
+        {
+            peakAccel = fabsf(accel);
+        }
+        if(beyond > overshoot)
+        {
+            overshoot = beyond;
+        }
+        velocityPrevious = velocity;
+    } while((profile.complete == 0) && (steps < TEST_STEPS_MAX));
+
+    printf("%6.3f -> %6.3f rad: %5u steps, velocity %6.2f rad/s, "
+            "accel %7.2f rad/s^2, overshoot %8.6f rad\n", start, target,
+            (unsigned)steps, peakVelocity, peakAccel, overshoot);
+
+    Check("position reached", (profile.complete == 1) && 
+                                            (profile.position == target));
+    Check("no position overshoot", overshoot == 0);
+    Check("velocity limit", peakVelocity <= TEST_VELOCITY_RAD * TEST_MARGIN);
+    Check("position acceleration limit", 
+                        peakAccel <= TEST_POSITION_ACCEL_RAD * TEST_MARGIN);
+}
+
+int main(void)
+{
+    StepTest(0, 1800.0f);
+    StepTest(1800.0f, 200.0f);
+    StepTest(500.0f, 560.0f);
+    StepTest(560.0f, 500.0f);
+
+    MoveTest(0, 6.2832f);
+    MoveTest(6.2832f, 0);
+    MoveTest(0, 31.416f);
+    MoveTest(31.416f, 0);
+    MoveTest(0, 0.05f);
+    MoveTest(0.05f, 0);
+
+    if(failures != 0)
+    {
+        return 1;
+    }
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,215 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * thermal_model.c
+ *
+ * This file implements the thermal model of the motor windings and the power
+ * stage. Mean squared current of each phase over the update period gives
+ * the winding loss (R * i^2) of the phase and the power stage conduction loss
+ * (k * sum of i^2). Temperature of each component is a first order response 
+ * T = Tambient + LPF(P * Rth) with the thermal time constant of the component.
+ *
+ * Component: THERMAL MODEL
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+
+#include "thermal_model.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
+
+static void ThermalNodeUpdate(MCAPP_THERMAL_NODE_T *, float, float);
+static float ThermalNodeDerate(MCAPP_THERMAL_NODE_T *);
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+
+/**
+* <B> Function: MCAPP_ThermalModelInit(MCAPP_THERMAL_MODEL_T *) </B>
+*
+* @brief Function to initialize the thermal model. Temperatures start from
+*        ambient, the model is to be initialized only on power up as the 
+*        motor does not cool down when stopped.
+*
+* @param Pointer to thermal model data structure.
+* @return none.
+*
+* @example
+* <CODE> MCAPP_ThermalModelInit(&thermalModel); </CODE>
+*
+*/
+void MCAPP_ThermalModelInit(MCAPP_THERMAL_MODEL_T *pThermal)
+{
+    uint32_t index;
+    
+    pThermal->counter = 0;
+    pThermal->hottestPhase = 0;
+    for(index = 0; index < THERMAL_MODEL_PHASES; index++)
+    {
+        pThermal->sumSquare[index] = 0;
+        pThermal->currentRms[index] = 0;
+        pThermal->winding[index].temperature = pThermal->ambient;
+    }
+    pThermal->inverter.temperature = pThermal->ambient;
+    pThermal->derate = 1.0f;
+}
+
+/**
+* <B> Function: MCAPP_ThermalModelUpdate(MCAPP_THERMAL_MODEL_T *, float, float,
+*                                                               float, float) </B>
+*
+* @brief Function to accumulate the squared phase currents, temperatures and 
+*        current limit derating are updated every decimation executions. To 
+*        be called every control loop execution, with zero currents when the
+*        outputs are disabled so that the model cools down.
+*
+* @param Pointer to thermal model data structure.
+* @param Phase A current (A).
+* @param Phase B current (A).
+* @param Phase C current (A).
+* @param Phase D current (A).
+* @return none.
+*
+* @example
+* <CODE> MCAPP_ThermalModelUpdate(&thermalModel, ia, ib, ic, id); </CODE>
+*
+*/
+void MCAPP_ThermalModelUpdate(MCAPP_THERMAL_MODEL_T *pThermal, float ia, 
+                                                float ib, float ic, float id)
+{
+    uint32_t index;
+    float meanSquare, sumMeanSquare = 0, derate;
+    
+    pThermal->sumSquare[0] += ia * ia;
+    pThermal->sumSquare[1] += ib * ib;
+    pThermal->sumSquare[2] += ic * ic;
+    pThermal->sumSquare[3] += id * id;
+    
+    pThermal->counter++;
+    if(pThermal->counter < pThermal->decimation)
+    {
+        return;
+    }
+    pThermal->counter = 0;
+    
+    for(index = 0; index < THERMAL_MODEL_PHASES; index++)
+    {
+        meanSquare = pThermal->sumSquare[index] / (float)pThermal->decimation;
+        pThermal->sumSquare[index] = 0;
+        pThermal->currentRms[index] = sqrtf(meanSquare);
+        sumMeanSquare += meanSquare;
+        
+        ThermalNodeUpdate(&pThermal->winding[index], 
+                    pThermal->phaseResistance * meanSquare, pThermal->ambient);
+        if(pThermal->winding[index].temperature > 
+                    pThermal->winding[pThermal->hottestPhase].temperature)
+        {
+            pThermal->hottestPhase = index;
+        }
+    }
+    ThermalNodeUpdate(&pThermal->inverter, 
+                    pThermal->inverterLossGain * sumMeanSquare, pThermal->ambient);
+    
+    /* Hottest winding or power stage limits the current */
+    pThermal->derate = ThermalNodeDerate(
+                                &pThermal->winding[pThermal->hottestPhase]);
+    derate = ThermalNodeDerate(&pThermal->inverter);
+    if(derate < pThermal->derate)
+    {
+        pThermal->derate = derate;
+    }
+}
+
+// </editor-fold>
+
+/**
+* <B> Function: ThermalNodeUpdate(MCAPP_THERMAL_NODE_T *, float, float) </B>
+*
+* @brief Function to update the temperature of a first order thermal model.
+*
+* @param Pointer to thermal model of the component.
+* @param Power loss of the component (W).
+* @param Ambient temperature (degree C).
+* @return none.
+*
+* @example
+* <CODE> ThermalNodeUpdate(&pThermal->inverter, loss, ambient); </CODE>
+*
+*/
+static void ThermalNodeUpdate(MCAPP_THERMAL_NODE_T *pNode, float loss, 
+                                                                float ambient)
+{
+    pNode->temperature += (ambient + loss * pNode->thermalResistance - 
+                                    pNode->temperature) * pNode->filterGain;
+}
+
+/**
+* <B> Function: ThermalNodeDerate(MCAPP_THERMAL_NODE_T *) </B>
+*
+* @brief Function to compute the current limit scale of a component, reduced
+*        linearly from 1 at derateStart to 0 at limit temperature, so that the
+*        current settles at a level the component can sustain.
+*
+* @param Pointer to thermal model of the component.
+* @return Current limit scale (0 - 1).
+*
+* @example
+* <CODE> derate = ThermalNodeDerate(&pThermal->inverter); </CODE>
+*
+*/
+static float ThermalNodeDerate(MCAPP_THERMAL_NODE_T *pNode)
+{
+    if(pNode->temperature <= pNode->derateStart)
+    {
+        return 1.0f;
+    }
+    if(pNode->temperature >= pNode->limit)
+    {
+        return 0;
+    }
+    return (pNode->limit - pNode->temperature) / 
+                                        (pNode->limit - pNode->derateStart);
+}
@@ -0,0 +1,124 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file thermal_model.h
+ *
+ * @brief This header file lists data type definitions and interface functions
+ * of the thermal model. Squared phase currents are accumulated every control
+ * loop execution and the temperatures of the motor windings and the power 
+ * stage are estimated at a decimated rate, the current limit is derated 
+ * before the temperature limits are reached.
+ *
+ * Component: THERMAL MODEL
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+#ifndef __THERMAL_MODEL_H
+#define __THERMAL_MODEL_H
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// </editor-fold>
+
+#ifdef __cplusplus  // Provide C++ Compatability
+    extern "C" {
+#endif
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/CONSTANTS ">
+
+/* Number of motor phases */
+#define THERMAL_MODEL_PHASES            4
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="TYPE DEFINITIONS ">
+
+/**
+ * First order thermal model of a component, temperature rise over ambient 
+ * follows the power loss times thermal resistance with the time constant
+*/
+typedef struct
+{
+    float
+        thermalResistance,  /* Component to ambient (K/W) */
+        filterGain,         /* Model update period / thermal time constant */
+        derateStart,        /* Temperature to start derating (degree C) */
+        limit,              /* Temperature at zero current limit (degree C) */
+        temperature;        /* Estimated temperature (degree C) */
+} MCAPP_THERMAL_NODE_T;
+
+/**
+ * Thermal model data type
+*/
+typedef struct
+{
+    uint32_t
+        enable,             /* 1 = derating is applied to the current limit */
+        decimation,         /* Control loop executions per model update */
+        counter,            /* Executions accumulated in present update */
+        hottestPhase;       /* Phase of the highest winding temperature */
+    float
+        ambient,            /* Ambient temperature (degree C) */
+        phaseResistance,    /* Winding resistance of a phase (ohm) */
+        inverterLossGain,   /* Power stage loss per squared phase current (W/A^2) */
+        sumSquare[THERMAL_MODEL_PHASES],    /* Accumulated squared current (A^2) */
+        currentRms[THERMAL_MODEL_PHASES],   /* RMS current of last update (A) */
+        derate;             /* Current limit scale, 1 = no derating */
+    
+    MCAPP_THERMAL_NODE_T
+        winding[THERMAL_MODEL_PHASES],      /* Winding of each phase */
+        inverter;                           /* Power stage */
+} MCAPP_THERMAL_MODEL_T;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+
+void MCAPP_ThermalModelInit(MCAPP_THERMAL_MODEL_T *);
+void MCAPP_ThermalModelUpdate(MCAPP_THERMAL_MODEL_T *, float, float, float, 
+                                                                        float);
+
+// </editor-fold>
+
+#ifdef __cplusplus  // Provide C++ Compatibility
+    }
+#endif
+#endif      // end of __THERMAL_MODEL_H